@@ -29,4 +29,14 @@ public:
     mat4 get_view_mat() const noexcept { return translate(mat4_cast(quaternion) * view, pos); }
 
     mat4 get_proj_mat() const noexcept { return perspective(fov_angle, aspect_ratio, near, far); }
+
+    // diameter in pixels of a sphere seen on a viewport of the given height,
+    // zero when the sphere is behind the camera and infinity when the camera is inside it
+    float projected_diameter(const vec3& center, const float radius, const float viewport_height) const noexcept
+    {
+        const auto depth = -(get_view_mat() * vec4{center, 1}).z;
+        if(depth + radius <= near) return 0;
+        if(depth <= radius) return std::numeric_limits<float>::infinity();
+        return radius * get_proj_mat()[1][1] * viewport_height / depth;
+    }
 };
@@ -28,6 +28,8 @@ void update_camera()
     sample.flush_transform_to_memory();
 
     sample.set_transform({proj * glm_camera.get_view_mat() * model});
+
+    sample.stream_textures(glm_camera);
 }
 
 void perform_camera_update(GLFWwindow* window, const int key, const float speed_up_ratio)
@@ -86,6 +88,33 @@ void cursor_callback(GLFWwindow* window, const double x, const double y)
     update_camera();
 }
 
+//the cursor is kept at the center, so a left click picks the node in the middle of the view,
+//a right click lists the nodes the camera may collide with
+void mouse_button_callback(GLFWwindow*, const int button, const int action, const int)
+{
+    if constexpr(is_debug)
+    {
+        if(action != GLFW_PRESS) return;
+
+        switch(button)
+        {
+        case GLFW_MOUSE_BUTTON_LEFT:
+        {
+            if(const auto& node = sample.pick_node(vec2{0})) std::cout << "picked node " << *node << '\n';
+        }
+        break;
+        case GLFW_MOUSE_BUTTON_RIGHT:
+        {
+            std::cout << "nodes near camera:";
+            for(const auto node : sample.nodes_near_camera(0.5f)) std::cout << ' ' << node;
+            std::cout << '\n';
+        }
+        break;
+        default: break;
+        }
+    }
+}
+
 int main()
 {
     try
@@ -99,6 +128,7 @@ int main()
 
         glfwSetKeyCallback(sample.get_window(), key_callback);
         glfwSetCursorPosCallback(sample.get_window(), cursor_callback);
+        glfwSetMouseButtonCallback(sample.get_window(), mouse_button_callback);
         glfwSetInputMode(sample.get_window(), GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
         glfwSetCursorPos(sample.get_window(), center.x, center.y);
 
@@ -7,8 +7,135 @@ layout(location = 0) out vec4 out_color;
 
 layout(location = 1) in vec2 frag_tex;
 
-layout(binding = 1) uniform sampler2D tex_sampler;
+#ifdef COMPACT_VERTEX
+layout(location = 2) in vec3 frag_normal;
+
+layout(location = 3) in vec4 frag_tangent;
+
+//a fixed light from above, the ambient term keeps the faces turned away from it readable
+const vec3 light_direction = normalize(vec3(0.3, 1, 0.3));
+const float ambient = 0.3;
+#endif
+
+layout(binding = 1) uniform sampler2DArray tex_sampler;
+
+layout(binding = 2) uniform sampler2DArray page_cache;
+
+layout(std430, binding = 3) readonly buffer page_table { uint entries[]; }pt;
+
+layout(std430, binding = 4) buffer page_feedback { uint bits[]; }pf;
+
+//the array image holding the layer of the normal texture, it need not be that of the base color
+layout(binding = 6) uniform sampler2DArray normal_sampler;
+
+//levels is zero for textures sampled from array images
+struct virtual_texture
+{
+    uint table_offset;
+    uint width;
+    uint height;
+    uint levels;
+};
+
+//the layer is no_texture for meshes without a texture, the normal texture is a layer of the normal array image
+//or a virtual texture of its own
+layout(push_constant) uniform texture_constant
+{
+    vec4 base_color_factor;
+    uint layer;
+    virtual_texture base_color;
+    uint normal_layer;
+    virtual_texture normal;
+}tc;
+
+const uint no_texture = 0xffffffff;
+
+const uint page_size = 128;
+const uint page_border = 4;
+const uint page_stride = page_size + 2 * page_border;
+const uint slot_bits = 10;
+
+uvec2 level_extent(virtual_texture current, uint level)
+{
+    return max(uvec2(current.width, current.height) >> level, uvec2(1));
+}
+
+uvec2 page_grid(virtual_texture current, uint level)
+{
+    return (level_extent(current, level) + page_size - 1) / page_size;
+}
+
+uint page_index(virtual_texture current, uint level, uvec2 page)
+{
+    uint index = current.table_offset;
+    for(uint i = 0; i < level; ++i)
+    {
+        uvec2 grid = page_grid(current, i);
+        index += grid.x * grid.y;
+    }
+    return index + page.y * page_grid(current, level).x + page.x;
+}
+
+vec4 sample_virtual(virtual_texture current, vec2 uv)
+{
+    vec2 texel = uv * vec2(current.width, current.height);
+    vec2 dx = dFdx(texel);
+    vec2 dy = dFdy(texel);
+    float lod = 0.5 * log2(max(max(dot(dx, dx), dot(dy, dy)), 1e-8));
+    uint level = uint(clamp(floor(lod), 0.0, float(current.levels - 1)));
+
+    vec2 wrapped = fract(uv);
+    uvec2 page = min(uvec2(wrapped * vec2(level_extent(current, level))) / page_size, page_grid(current, level) - 1);
+    uint index = page_index(current, level, page);
+
+    //the atomic is skipped once another fragment has reported the page
+    uint bit = 1u << (index % 32);
+    if((pf.bits[index / 32] & bit) == 0) atomicOr(pf.bits[index / 32], bit);
+
+    //the entry holds the slot of the finest resident ancestor of the page
+    uint entry = pt.entries[index];
+    uint mapped_level = entry >> (2 * slot_bits);
+    uvec2 slot = uvec2(entry, entry >> slot_bits) & ((1u << slot_bits) - 1);
+    uvec2 mapped_page = min(page >> (mapped_level - level), page_grid(current, mapped_level) - 1);
+
+    vec2 page_texel = clamp(
+        wrapped * vec2(level_extent(current, mapped_level)) - vec2(mapped_page * page_size),
+        vec2(0),
+        vec2(page_size)
+    );
+    vec2 cache_texel = vec2(slot * page_stride + page_border) + page_texel;
+    return textureLod(page_cache, vec3(cache_texel / vec2(textureSize(page_cache, 0).xy), 0), 0);
+}
 
 void main() {
-    out_color = texture(tex_sampler, frag_tex);
-}
\ No newline at end of file
+    if(tc.layer == no_texture) out_color = tc.base_color_factor;
+    else
+        out_color = tc.base_color_factor *
+            (tc.base_color.levels == 0 ?
+                texture(tex_sampler, vec3(frag_tex, tc.layer)) :
+                sample_virtual(tc.base_color, frag_tex));
+
+#ifdef COMPACT_VERTEX
+    //sampled before the checks on the interpolated vectors, which would leave its derivatives undefined
+    bool is_normal_mapped = tc.normal_layer != no_texture || tc.normal.levels != 0;
+    vec3 texel_normal = vec3(0, 0, 1);
+    if(is_normal_mapped)
+        texel_normal = (tc.normal.levels == 0 ?
+            texture(normal_sampler, vec3(frag_tex, tc.normal_layer)) :
+            sample_virtual(tc.normal, frag_tex)).xyz * 2 - 1;
+
+    //degenerate draws have a zero inverse and are left unlit
+    if(dot(frag_normal, frag_normal) > 0)
+    {
+        //the texel is a direction in the frame of the tangent, the bitangent and the normal
+        vec3 normal = normalize(frag_normal);
+        vec3 tangent = frag_tangent.xyz - dot(frag_tangent.xyz, normal) * normal;
+        if(is_normal_mapped && dot(tangent, tangent) > 0)
+        {
+            tangent = normalize(tangent);
+            normal = normalize(mat3(tangent, cross(normal, tangent) * frag_tangent.w, normal) * texel_normal);
+        }
+        out_color.rgb *= ambient + (1 - ambient) * max(dot(normal, light_direction), 0);
+    }
+#endif
+}
@@ -3,18 +3,60 @@
 
 layout(binding = 0) uniform transform { mat4 mat; }tf;
 
-layout(location = 0) in vec3 in_position;
+struct draw_transform
+{
+    mat4 world;
+    mat4 inverse_world;
+};
+
+//shared with the cull pass, the first instance of each indirect command is the index of its transform
+layout(std430, binding = 5) readonly buffer draw_transforms { draw_transform entries[]; }dt;
+
+//the fourth component of compact positions is the unorm sign of the bitangent
+layout(location = 0) in vec4 in_position;
 
 layout(location = 0) out vec3 frag_color;
 
+#ifdef COMPACT_VERTEX
+//positions are unorm in the cube around their mesh, which the world matrix maps back, the normal is octahedral
+layout(location = 1) in vec2 in_normal;
+
+//in world space, the cube scales uniformly so the inverse transpose of the world matrix maps the normal
+layout(location = 2) out vec3 frag_normal;
+
+//octahedral like the normal, it lies in the surface and moves with the world matrix itself
+layout(location = 3) in vec2 in_tangent;
+
+//the world space tangent and the sign of the bitangent
+layout(location = 3) out vec4 frag_tangent;
+
+vec3 octahedral_direction(vec2 folded)
+{
+    vec3 direction = vec3(folded, 1.0 - abs(folded.x) - abs(folded.y));
+    if(direction.z < 0)
+        direction.xy =
+            (1.0 - abs(direction.yx)) * vec2(direction.x >= 0 ? 1.0 : -1.0, direction.y >= 0 ? 1.0 : -1.0);
+    return direction;
+}
+#else
 layout(location = 1) in vec3 in_color;
+#endif
 
 layout(location = 1) out vec2 frag_texture;
 
 layout(location = 2) in vec2 in_texture;
 
 void main() {
-	gl_Position = tf.mat * vec4(in_position, 1.0);
+	gl_Position = tf.mat * dt.entries[gl_InstanceIndex].world * vec4(in_position.xyz, 1.0);
+#ifdef COMPACT_VERTEX
+	frag_color = vec3(1);
+	frag_normal = transpose(mat3(dt.entries[gl_InstanceIndex].inverse_world)) * octahedral_direction(in_normal);
+	frag_tangent = vec4(
+		mat3(dt.entries[gl_InstanceIndex].world) * octahedral_direction(in_tangent),
+		in_position.w > 0.5 ? 1.0 : -1.0
+	);
+#else
 	frag_color = in_color;
+#endif
 	frag_texture = in_texture;
 }
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include <functional>
+
+namespace utility
+{
+    //open-addressing hash map with linear probing, entries live densely in insertion order and are never erased,
+    //inserting may invalidate iterators like a vector does
+    template<typename Key, typename Value, typename Hash, typename KeyEqual = std::equal_to<Key>>
+    class flat_hash_map
+    {
+    public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<Key, Value>;
+        using iterator = typename std::vector<value_type>::iterator;
+        using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    private:
+        static constexpr uint32_t empty_slot = UINT32_MAX;
+
+        //the full hash is kept beside the entry index, so probing rarely compares keys
+        struct slot
+        {
+            size_t hash = 0;
+            uint32_t index = empty_slot;
+        };
+
+        std::vector<slot> slots_;
+        std::vector<value_type> values_;
+        Hash hash_;
+        KeyEqual equal_;
+
+        [[nodiscard]] size_t mask() const noexcept;
+
+        //slot holding the key, or the empty slot it would be inserted at
+        [[nodiscard]] size_t probe(const Key&, const size_t) const;
+
+        void rehash(const size_t);
+
+    public:
+        explicit flat_hash_map(const size_t = 0, Hash = {}, KeyEqual = {});
+
+        //keeps the load factor at most one half for the given entry count
+        void reserve(const size_t);
+
+        [[nodiscard]] std::pair<iterator, bool> try_emplace(const Key&, Value);
+
+        [[nodiscard]] iterator find(const Key&);
+        [[nodiscard]] const_iterator find(const Key&) const;
+
+        [[nodiscard]] size_t size() const noexcept;
+        [[nodiscard]] bool empty() const noexcept;
+
+        [[nodiscard]] iterator begin() noexcept;
+        [[nodiscard]] iterator end() noexcept;
+        [[nodiscard]] const_iterator begin() const noexcept;
+        [[nodiscard]] const_iterator end() const noexcept;
+
+        void clear() noexcept;
+    };
+}
+
+#include "flat_hash_map.tpp"
@@ -0,0 +1,105 @@
+#pragma once
+
+namespace utility
+{
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	flat_hash_map<Key, Value, Hash, KeyEqual>::flat_hash_map(const size_t capacity, Hash hash, KeyEqual equal) :
+		hash_(std::move(hash)),
+		equal_(std::move(equal))
+	{
+		reserve(capacity);
+	}
+
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	size_t flat_hash_map<Key, Value, Hash, KeyEqual>::mask() const noexcept { return slots_.size() - 1; }
+
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	size_t flat_hash_map<Key, Value, Hash, KeyEqual>::probe(const Key& key, const size_t hash) const
+	{
+		for(auto i = hash & mask();; i = (i + 1) & mask())
+		{
+			const auto& slot = slots_[i];
+			if(slot.index == empty_slot || (slot.hash == hash && equal_(values_[slot.index].first, key))) return i;
+		}
+	}
+
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	void flat_hash_map<Key, Value, Hash, KeyEqual>::rehash(const size_t slot_count)
+	{
+		const auto slots = std::move(slots_);
+		slots_.assign(slot_count, {});
+		for(const auto& slot : slots)
+			if(slot.index != empty_slot)
+			{
+				auto i = slot.hash & mask();
+				while(slots_[i].index != empty_slot) i = (i + 1) & mask();
+				slots_[i] = slot;
+			}
+	}
+
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	void flat_hash_map<Key, Value, Hash, KeyEqual>::reserve(const size_t capacity)
+	{
+		size_t slot_count = 16;
+		while(slot_count < capacity * 2) slot_count *= 2;
+		if(slot_count > slots_.size()) rehash(slot_count);
+		values_.reserve(capacity);
+	}
+
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	auto flat_hash_map<Key, Value, Hash, KeyEqual>::try_emplace(const Key& key, Value value)
+		-> std::pair<iterator, bool>
+	{
+		if((values_.size() + 1) * 2 > slots_.size()) rehash(slots_.size() * 2);
+
+		const auto hash = static_cast<size_t>(hash_(key));
+		auto& slot = slots_[probe(key, hash)];
+		if(slot.index != empty_slot) return {values_.begin() + slot.index, false};
+
+		slot = {hash, static_cast<uint32_t>(values_.size())};
+		values_.emplace_back(key, std::move(value));
+		return {values_.end() - 1, true};
+	}
+
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	auto flat_hash_map<Key, Value, Hash, KeyEqual>::find(const Key& key) -> iterator
+	{
+		const auto& slot = slots_[probe(key, static_cast<size_t>(hash_(key)))];
+		return slot.index == empty_slot ? values_.end() : values_.begin() + slot.index;
+	}
+
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	auto flat_hash_map<Key, Value, Hash, KeyEqual>::find(const Key& key) const -> const_iterator
+	{
+		const auto& slot = slots_[probe(key, static_cast<size_t>(hash_(key)))];
+		return slot.index == empty_slot ? values_.cend() : values_.cbegin() + slot.index;
+	}
+
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	size_t flat_hash_map<Key, Value, Hash, KeyEqual>::size() const noexcept { return values_.size(); }
+
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	bool flat_hash_map<Key, Value, Hash, KeyEqual>::empty() const noexcept { return values_.empty(); }
+
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	auto flat_hash_map<Key, Value, Hash, KeyEqual>::begin() noexcept -> iterator { return values_.begin(); }
+
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	auto flat_hash_map<Key, Value, Hash, KeyEqual>::end() noexcept -> iterator { return values_.end(); }
+
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	auto flat_hash_map<Key, Value, Hash, KeyEqual>::begin() const noexcept -> const_iterator
+	{
+		return values_.cbegin();
+	}
+
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	auto flat_hash_map<Key, Value, Hash, KeyEqual>::end() const noexcept -> const_iterator { return values_.cend(); }
+
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	void flat_hash_map<Key, Value, Hash, KeyEqual>::clear() noexcept
+	{
+		values_.clear();
+		for(auto& slot : slots_) slot = {};
+	}
+}
@@ -0,0 +1,88 @@
+#include "hash.h"
+#include <cstring>
+
+namespace utility
+{
+    namespace
+    {
+        constexpr uint64_t prime_1 = 0x9E3779B185EBCA87;
+        constexpr uint64_t prime_2 = 0xC2B2AE3D27D4EB4F;
+        constexpr uint64_t prime_3 = 0x165667B19E3779F9;
+        constexpr uint64_t prime_4 = 0x85EBCA77C2B2AE63;
+        constexpr uint64_t prime_5 = 0x27D4EB2F165667C5;
+
+        constexpr uint64_t rotate_left(const uint64_t value, const int bits) noexcept
+        {
+            return value << bits | value >> (64 - bits);
+        }
+
+        template<typename T>
+        T read(const unsigned char* ptr) noexcept
+        {
+            T value;
+            std::memcpy(&value, ptr, sizeof(T));
+            return value;
+        }
+
+        constexpr uint64_t round(uint64_t accumulator, const uint64_t input) noexcept
+        {
+            accumulator += input * prime_2;
+            return rotate_left(accumulator, 31) * prime_1;
+        }
+
+        constexpr uint64_t merge_round(const uint64_t accumulator, const uint64_t value) noexcept
+        {
+            return (accumulator ^ round(0, value)) * prime_1 + prime_4;
+        }
+    }
+
+    uint64_t xxhash64(const void* data, const size_t size, const uint64_t seed) noexcept
+    {
+        auto ptr = static_cast<const unsigned char*>(data);
+        const auto end = ptr + size;
+        uint64_t hash;
+
+        if(size >= 32)
+        {
+            uint64_t v1 = seed + prime_1 + prime_2;
+            uint64_t v2 = seed + prime_2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - prime_1;
+
+            for(const auto limit = end - 32; ptr <= limit; ptr += 32)
+            {
+                v1 = round(v1, read<uint64_t>(ptr));
+                v2 = round(v2, read<uint64_t>(ptr + 8));
+                v3 = round(v3, read<uint64_t>(ptr + 16));
+                v4 = round(v4, read<uint64_t>(ptr + 24));
+            }
+
+            hash = rotate_left(v1, 1) + rotate_left(v2, 7) + rotate_left(v3, 12) + rotate_left(v4, 18);
+            hash = merge_round(hash, v1);
+            hash = merge_round(hash, v2);
+            hash = merge_round(hash, v3);
+            hash = merge_round(hash, v4);
+        }
+        else hash = seed + prime_5;
+
+        hash += size;
+
+        for(; ptr + 8 <= end; ptr += 8)
+            hash = rotate_left(hash ^ round(0, read<uint64_t>(ptr)), 27) * prime_1 + prime_4;
+
+        if(ptr + 4 <= end)
+        {
+            hash = rotate_left(hash ^ read<uint32_t>(ptr) * prime_1, 23) * prime_2 + prime_3;
+            ptr += 4;
+        }
+
+        for(; ptr < end; ++ptr) hash = rotate_left(hash ^ *ptr * prime_5, 11) * prime_1;
+
+        hash ^= hash >> 33;
+        hash *= prime_2;
+        hash ^= hash >> 29;
+        hash *= prime_3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+}
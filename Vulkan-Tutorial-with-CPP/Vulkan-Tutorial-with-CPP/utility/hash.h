@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+namespace utility
+{
+    //64-bit xxHash (XXH64) over raw bytes
+    [[nodiscard]] uint64_t xxhash64(const void*, const size_t, const uint64_t seed = 0) noexcept;
+
+    template<typename T>
+    [[nodiscard]] uint64_t xxhash64_object(const T&, const uint64_t seed = 0) noexcept;
+
+    [[nodiscard]] constexpr uint64_t hash_combine(const uint64_t, const uint64_t) noexcept;
+}
+
+#include "hash.tpp"
@@ -0,0 +1,17 @@
+#pragma once
+
+namespace utility
+{
+	template<typename T>
+	uint64_t xxhash64_object(const T& t, const uint64_t seed) noexcept
+	{
+		static_assert(std::has_unique_object_representations_v<T> || std::is_floating_point_v<T>,
+			"type has padding bits, hash its members instead");
+		return xxhash64(&t, sizeof(T), seed);
+	}
+
+	constexpr uint64_t hash_combine(const uint64_t seed, const uint64_t hash) noexcept
+	{
+		return seed ^ (hash + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+	}
+}
@@ -0,0 +1,39 @@
+#include "thread_pool.h"
+
+namespace utility
+{
+    void thread_pool::work()
+    {
+        while(true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock{mutex_};
+                condition_.wait(lock, [this] { return stopped_ || !tasks_.empty(); });
+                if(stopped_ && tasks_.empty()) return;
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+            task();
+        }
+    }
+
+    thread_pool::thread_pool(const size_t count)
+    {
+        const auto thread_count = std::max<size_t>(count, 1);
+        threads_.reserve(thread_count);
+        for(size_t i = 0; i < thread_count; ++i) threads_.emplace_back(&thread_pool::work, this);
+    }
+
+    thread_pool::~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            stopped_ = true;
+        }
+        condition_.notify_all();
+        for(auto& thread : threads_) thread.join();
+    }
+
+    size_t thread_pool::size() const noexcept { return threads_.size(); }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <queue>
+#include <vector>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <algorithm>
+#include <stdexcept>
+
+namespace utility
+{
+    class thread_pool
+    {
+        std::vector<std::thread> threads_;
+        std::queue<std::function<void()>> tasks_;
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        bool stopped_ = false;
+
+        void work();
+
+    public:
+        explicit thread_pool(const size_t = std::thread::hardware_concurrency());
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+        ~thread_pool();
+
+        [[nodiscard]] size_t size() const noexcept;
+
+        template<typename Func, typename... Args>
+        [[nodiscard]] auto submit(Func&&, Args&&...)
+            -> std::future<std::invoke_result_t<std::decay_t<Func>, std::decay_t<Args>...>>;
+    };
+
+    template<typename T>
+    [[nodiscard]] bool is_ready(const std::future<T>&);
+}
+
+#include "thread_pool.tpp"
@@ -0,0 +1,33 @@
+#pragma once
+
+namespace utility
+{
+	template<typename Func, typename... Args>
+	auto thread_pool::submit(Func&& func, Args&&... args)
+		-> std::future<std::invoke_result_t<std::decay_t<Func>, std::decay_t<Args>...>>
+	{
+		using result_type = std::invoke_result_t<std::decay_t<Func>, std::decay_t<Args>...>;
+
+		//std::function requires a copyable target, so the move-only task is shared
+		const auto task = std::make_shared<std::packaged_task<result_type()>>(
+			[func = std::forward<Func>(func), args = std::make_tuple(std::forward<Args>(args)...)]() mutable
+			{
+				return std::apply(std::move(func), std::move(args));
+			}
+		);
+		auto future = task->get_future();
+		{
+			std::lock_guard<std::mutex> lock{mutex_};
+			if(stopped_) throw std::runtime_error{"submit task to a stopped thread pool"};
+			tasks_.emplace([task] { (*task)(); });
+		}
+		condition_.notify_one();
+		return future;
+	}
+
+	template<typename T>
+	bool is_ready(const std::future<T>& future)
+	{
+		return future.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+	}
+}
@@ -1,5 +1,8 @@
 ﻿#include "utility.h"
 
+#include <atomic>
+#include <thread>
+
 namespace utility
 {
     // ReSharper disable IdentifierTypo
@@ -9,4 +12,15 @@ namespace utility
     ostringstream csout;
 
     // ReSharper restore IdentifierTypo
+
+    path unique_temp_path(const path& file_path)
+    {
+        static std::atomic<size_t> counter{0};
+
+        ostringstream suffix;
+        suffix << '.' << std::this_thread::get_id() << '.' << counter.fetch_add(1, std::memory_order_relaxed) << ".tmp";
+        auto temp_path = file_path;
+        temp_path += suffix.str();
+        return temp_path;
+    }
 }
\ No newline at end of file
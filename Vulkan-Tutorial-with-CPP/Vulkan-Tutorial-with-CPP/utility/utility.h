@@ -3,6 +3,9 @@
 #include "property.h"
 #include "type_traits.h"
 #include "time.h"
+#include "thread_pool.h"
+#include "hash.h"
+#include "flat_hash_map.h"
 #include "constant/numberic.h"
 #include "constant/constant.h"
 
@@ -11,6 +14,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/packing.hpp>
 
 #include <vector>
 #include <array>
@@ -66,6 +70,7 @@ namespace utility
     using std::filesystem::path;
     using std::unique_ptr;
     using std::optional;
+    using std::future;
     using std::size_t;
 
     // ReSharper disable IdentifierTypo
@@ -118,6 +123,10 @@ namespace utility
     constexpr long double operator"" _deg(const long double);
 
     constexpr long double operator"" _deg(const unsigned long long);
+
+    //sibling of the path to write before renaming it over the path, distinct for every call in the process,
+    //so concurrent writers of one file never share a partly written one
+    [[nodiscard]] path unique_temp_path(const path&);
 }
 
 #include "utility.tpp"
\ No newline at end of file
@@ -0,0 +1,444 @@
+#include "animation_tracks.h"
+#include <random>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define ANIMATION_TRACKS_SIMD
+#include <immintrin.h>
+#endif
+
+namespace vulkan::utility
+{
+    size_t animation_tracks::timeline_table::size() const noexcept { return animations.size(); }
+
+    void animation_tracks::timeline_table::push_back(
+        const size_t animation,
+        const size_t first_key,
+        const size_t key_count,
+        const animation_interpolation interpolation
+    )
+    {
+        animations.push_back(animation);
+        first_keys.push_back(first_key);
+        key_counts.push_back(key_count);
+        interpolations.push_back(interpolation);
+        cursors.push_back(0);
+        keys.push_back(0);
+        next_keys.push_back(0);
+        factors.push_back(0);
+        spans.push_back(0);
+    }
+
+    size_t animation_tracks::track_group::size() const noexcept { return nodes.size(); }
+
+    void animation_tracks::track_group::push_back(
+        const size_t node,
+        const animation_path path,
+        const size_t timeline,
+        const size_t first_value
+    )
+    {
+        nodes.push_back(node);
+        paths.push_back(path);
+        timelines.push_back(timeline);
+        first_values.push_back(first_value);
+    }
+
+    auto animation_tracks::lerp(const key_lanes& keys) noexcept -> lanes
+    {
+        lanes blended{};
+        for(size_t c = 0; c < 3; ++c)
+        {
+#ifdef ANIMATION_TRACKS_SIMD
+            const auto from = _mm_loadu_ps(keys.from[c].data());
+            const auto to = _mm_loadu_ps(keys.to[c].data());
+            _mm_storeu_ps(
+                blended[c].data(),
+                _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(to, from), _mm_loadu_ps(keys.factors.data())))
+            );
+#else
+            for(size_t i = 0; i < lane_count; ++i)
+                blended[c][i] = keys.from[c][i] + (keys.to[c][i] - keys.from[c][i]) * keys.factors[i];
+#endif
+        }
+        return blended;
+    }
+
+    //the correction is a polynomial in the cosine between the rotations, which keeps the angular speed close to
+    //constant without acos or sin, the shorter arc is taken by flipping the second rotation on a negative cosine
+    auto animation_tracks::slerp(const key_lanes& keys) noexcept -> lanes
+    {
+        lanes blended{};
+#ifdef ANIMATION_TRACKS_SIMD
+        const auto one = _mm_set1_ps(1);
+        const auto sign_mask = _mm_set1_ps(-0.0f);
+        __m128 from[4];
+        __m128 to[4];
+        auto cosine = _mm_setzero_ps();
+        for(size_t c = 0; c < 4; ++c)
+        {
+            from[c] = _mm_loadu_ps(keys.from[c].data());
+            to[c] = _mm_loadu_ps(keys.to[c].data());
+            cosine = _mm_add_ps(cosine, _mm_mul_ps(from[c], to[c]));
+        }
+        const auto d = _mm_andnot_ps(sign_mask, cosine);
+
+        const auto a = _mm_add_ps(
+            _mm_set1_ps(1.0904f),
+            _mm_mul_ps(
+                d,
+                _mm_add_ps(
+                    _mm_set1_ps(-3.2452f),
+                    _mm_mul_ps(d, _mm_sub_ps(_mm_set1_ps(3.55645f), _mm_mul_ps(d, _mm_set1_ps(1.43519f))))
+                )
+            )
+        );
+        const auto b = _mm_add_ps(
+            _mm_set1_ps(0.848013f),
+            _mm_mul_ps(d, _mm_add_ps(_mm_set1_ps(-1.06021f), _mm_mul_ps(d, _mm_set1_ps(0.215638f))))
+        );
+        const auto t = _mm_loadu_ps(keys.factors.data());
+        const auto centered = _mm_sub_ps(t, _mm_set1_ps(0.5f));
+        const auto k = _mm_add_ps(_mm_mul_ps(a, _mm_mul_ps(centered, centered)), b);
+        const auto corrected = _mm_add_ps(t, _mm_mul_ps(_mm_mul_ps(t, centered), _mm_mul_ps(_mm_sub_ps(t, one), k)));
+
+        const auto from_weight = _mm_sub_ps(one, corrected);
+        const auto to_weight = _mm_xor_ps(corrected, _mm_and_ps(cosine, sign_mask));
+        __m128 unnormalized[4];
+        auto length = _mm_setzero_ps();
+        for(size_t c = 0; c < 4; ++c)
+        {
+            unnormalized[c] = _mm_add_ps(_mm_mul_ps(from[c], from_weight), _mm_mul_ps(to[c], to_weight));
+            length = _mm_add_ps(length, _mm_mul_ps(unnormalized[c], unnormalized[c]));
+        }
+        const auto inverse_length = _mm_div_ps(one, _mm_sqrt_ps(_mm_max_ps(length, _mm_set1_ps(1e-12f))));
+        for(size_t c = 0; c < 4; ++c) _mm_storeu_ps(blended[c].data(), _mm_mul_ps(unnormalized[c], inverse_length));
+#else
+        for(size_t i = 0; i < lane_count; ++i)
+        {
+            auto cosine = 0.0f;
+            for(size_t c = 0; c < 4; ++c) cosine += keys.from[c][i] * keys.to[c][i];
+            const auto d = std::abs(cosine);
+
+            const auto a = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+            const auto b = 0.848013f + d * (-1.06021f + d * 0.215638f);
+            const auto t = keys.factors[i];
+            const auto k = a * (t - 0.5f) * (t - 0.5f) + b;
+            const auto corrected = t + t * (t - 0.5f) * (t - 1) * k;
+
+            const auto to_weight = cosine < 0 ? -corrected : corrected;
+            auto length = 0.0f;
+            for(size_t c = 0; c < 4; ++c)
+            {
+                blended[c][i] = keys.from[c][i] * (1 - corrected) + keys.to[c][i] * to_weight;
+                length += blended[c][i] * blended[c][i];
+            }
+            const auto inverse_length = 1 / std::sqrt(std::max(length, 1e-12f));
+            for(size_t c = 0; c < 4; ++c) blended[c][i] *= inverse_length;
+        }
+#endif
+        return blended;
+    }
+
+    void animation_tracks::sample_timelines(const float time)
+    {
+        //negative times loop too
+        const auto& local_times = ::utility::container_transform<vector<float>>(
+            durations_,
+            [time](const float duration)
+            {
+                if(duration <= 0) return 0.0f;
+                const auto local_time = std::fmod(time, duration);
+                return local_time < 0 ? local_time + duration : local_time;
+            }
+        );
+
+        for(size_t i = 0; i < timelines_.size(); ++i)
+        {
+            const auto local_time = local_times[timelines_.animations[i]];
+            const auto* const first = times_.data() + timelines_.first_keys[i];
+            const auto count = timelines_.key_counts[i];
+            auto& cursor = timelines_.cursors[i];
+
+            //a loop back or a jump restarts the search, otherwise it continues from the last key
+            if(local_time < first[cursor])
+            {
+                const auto upper = static_cast<size_t>(std::upper_bound(first, first + count, local_time) - first);
+                cursor = upper > 0 ? upper - 1 : 0;
+            }
+            else
+                while(cursor + 1 < count && first[cursor + 1] <= local_time) ++cursor;
+
+            //before the first key and after the last one the timeline holds its key
+            const auto next = std::min(cursor + 1, count - 1);
+            const auto span = first[next] - first[cursor];
+            timelines_.keys[i] = cursor;
+            timelines_.next_keys[i] = next;
+            timelines_.spans[i] = span;
+            timelines_.factors[i] = timelines_.interpolations[i] == animation_interpolation::step || span <= 0 ?
+                0 :
+                std::clamp((local_time - first[cursor]) / span, 0.0f, 1.0f);
+        }
+    }
+
+    void animation_tracks::gather(
+        const track_group& group,
+        const size_t first,
+        const size_t count,
+        key_lanes& keys
+    ) const
+    {
+        //lanes past the count are left zero
+        array<float, lane_count> factors{};
+#ifdef ANIMATION_TRACKS_SIMD
+        __m128 from[lane_count]{};
+        __m128 to[lane_count]{};
+#endif
+        for(size_t lane = 0; lane < count; ++lane)
+        {
+            const auto i = first + lane;
+            const auto timeline = group.timelines[i];
+            const auto& from_value = values_[group.first_values[i] + timelines_.keys[timeline]];
+            const auto& to_value = values_[group.first_values[i] + timelines_.next_keys[timeline]];
+            factors[lane] = timelines_.factors[timeline];
+#ifdef ANIMATION_TRACKS_SIMD
+            from[lane] = _mm_loadu_ps(&from_value[0]);
+            to[lane] = _mm_loadu_ps(&to_value[0]);
+#else
+            for(length_t c = 0; c < 4; ++c)
+            {
+                keys.from[c][lane] = from_value[c];
+                keys.to[c][lane] = to_value[c];
+            }
+#endif
+        }
+
+#ifdef ANIMATION_TRACKS_SIMD
+        //keys are loaded whole and turned into components, so the kernels read back full vector stores
+        _MM_TRANSPOSE4_PS(from[0], from[1], from[2], from[3]);
+        _MM_TRANSPOSE4_PS(to[0], to[1], to[2], to[3]);
+        for(size_t c = 0; c < 4; ++c)
+        {
+            _mm_storeu_ps(keys.from[c].data(), from[c]);
+            _mm_storeu_ps(keys.to[c].data(), to[c]);
+        }
+        _mm_storeu_ps(keys.factors.data(), _mm_loadu_ps(factors.data()));
+#else
+        keys.factors = factors;
+#endif
+    }
+
+    void animation_tracks::write(
+        const track_group& group,
+        const size_t first,
+        const size_t count,
+        const lanes& blended,
+        vector<vec3>& translations,
+        vector<quat>& rotations,
+        vector<vec3>& scales
+    )
+    {
+        //values a track holds, like a finished clip, leave their node unchanged
+        for(size_t lane = 0; lane < count; ++lane)
+        {
+            const auto node = group.nodes[first + lane];
+            const vec3 vector_value{blended[0][lane], blended[1][lane], blended[2][lane]};
+            switch(group.paths[first + lane])
+            {
+            case animation_path::translation:
+                if(translations[node] == vector_value) continue;
+                translations[node] = vector_value;
+                break;
+            case animation_path::rotation:
+            {
+                const quat rotation{blended[3][lane], blended[0][lane], blended[1][lane], blended[2][lane]};
+                if(rotations[node] == rotation) continue;
+                rotations[node] = rotation;
+                break;
+            }
+            case animation_path::scale:
+                if(scales[node] == vector_value) continue;
+                scales[node] = vector_value;
+                break;
+            }
+            changed_nodes_.push_back(node);
+        }
+    }
+
+    void animation_tracks::evaluate(
+        const float time,
+        vector<vec3>& translations,
+        vector<quat>& rotations,
+        vector<vec3>& scales
+    )
+    {
+        changed_nodes_.clear();
+        sample_timelines(time);
+
+        key_lanes keys;
+        for(size_t i = 0; i < vectors_.size(); i += lane_count)
+        {
+            const auto count = std::min(lane_count, vectors_.size() - i);
+            gather(vectors_, i, count, keys);
+            write(vectors_, i, count, lerp(keys), translations, rotations, scales);
+        }
+        for(size_t i = 0; i < rotations_.size(); i += lane_count)
+        {
+            const auto count = std::min(lane_count, rotations_.size() - i);
+            gather(rotations_, i, count, keys);
+            write(rotations_, i, count, slerp(keys), translations, rotations, scales);
+        }
+
+        //hermite basis over the value and out tangent of the key and the value and in tangent of the next one,
+        //the tangents are given per second
+        for(size_t i = 0; i < cubic_splines_.size(); ++i)
+        {
+            const auto timeline = cubic_splines_.timelines[i];
+            const auto t = timelines_.factors[timeline];
+            const auto span = timelines_.spans[timeline];
+            const auto t2 = t * t;
+            const auto t3 = t2 * t;
+            const auto from_weight = 2 * t3 - 3 * t2 + 1;
+            const auto out_weight = (t3 - 2 * t2 + t) * span;
+            const auto to_weight = -2 * t3 + 3 * t2;
+            const auto in_weight = (t3 - t2) * span;
+
+            const auto from = cubic_splines_.first_values[i] + timelines_.keys[timeline] * 3;
+            const auto to = cubic_splines_.first_values[i] + timelines_.next_keys[timeline] * 3;
+            auto value = from_weight * values_[from + 1] +
+                out_weight * values_[from + 2] +
+                to_weight * values_[to + 1] +
+                in_weight * values_[to];
+            if(cubic_splines_.paths[i] == animation_path::rotation)
+                value /= std::sqrt(std::max(dot(value, value), 1e-12f));
+
+            lanes blended{};
+            for(length_t c = 0; c < 4; ++c) blended[c].front() = value[c];
+            write(cubic_splines_, i, 1, blended, translations, rotations, scales);
+        }
+    }
+
+    size_t animation_tracks::push_timeline(
+        const size_t animation,
+        const vector<float>& times,
+        const animation_interpolation interpolation
+    )
+    {
+        if(times.empty()) throw std::runtime_error{"animation timeline has no keys"};
+
+        if(durations_.size() <= animation) durations_.resize(animation + 1, 0);
+        durations_[animation] = std::max(durations_[animation], times.back());
+
+        timelines_.push_back(animation, times_.size(), times.size(), interpolation);
+        times_.insert(times_.cend(), times.cbegin(), times.cend());
+        return timelines_.size() - 1;
+    }
+
+    void animation_tracks::push_back(
+        const size_t timeline,
+        const size_t node,
+        const animation_path path,
+        const vector<vec4>& values
+    )
+    {
+        const auto is_cubic_spline = timelines_.interpolations[timeline] == animation_interpolation::cubic_spline;
+        if(values.size() != timelines_.key_counts[timeline] * (is_cubic_spline ? 3 : 1))
+            throw std::runtime_error{"animation values do not match their timeline"};
+
+        auto& group = is_cubic_spline ? cubic_splines_ : path == animation_path::rotation ? rotations_ : vectors_;
+        group.push_back(node, path, timeline, values_.size());
+        values_.insert(values_.cend(), values.cbegin(), values.cend());
+    }
+
+    size_t animation_tracks::size() const noexcept
+    {
+        return vectors_.size() + rotations_.size() + cubic_splines_.size();
+    }
+
+    size_t animation_tracks::timeline_count() const noexcept { return timelines_.size(); }
+
+    size_t animation_tracks::animation_count() const noexcept { return durations_.size(); }
+
+    pair<float, float> animation_tracks::benchmark(const size_t node_count, const size_t sample_count)
+    {
+        using namespace ::utility::time;
+
+        //the seed is fixed so runs compare, the keys are a thirtieth of a second apart over a looping second
+        static constexpr size_t key_count = 31;
+        vector<float> times(key_count);
+        for(size_t i = 0; i < key_count; ++i) times[i] = static_cast<float>(i) / (key_count - 1);
+
+        struct reference_track
+        {
+            size_t node;
+            animation_path path;
+            vector<vec4> values;
+        };
+
+        std::mt19937 engine{0};
+        std::uniform_real_distribution<float> distribution{-1, 1};
+        animation_tracks tracks;
+        vector<reference_track> reference;
+        const auto& push_track = [&](const size_t node, const animation_path path)
+        {
+            vector<vec4> values(key_count);
+            for(auto& value : values)
+            {
+                value = {distribution(engine), distribution(engine), distribution(engine), distribution(engine)};
+                if(path == animation_path::rotation) value = normalize(value);
+            }
+            tracks.push_back(tracks.push_timeline(0, times, animation_interpolation::linear), node, path, values);
+            reference.push_back({node, path, std::move(values)});
+        };
+        for(size_t i = 0; i < node_count; ++i)
+        {
+            push_track(i, animation_path::translation);
+            push_track(i, animation_path::rotation);
+            if(i % 10 == 0) push_track(i, animation_path::scale);
+        }
+
+        vector<vec3> translations(node_count);
+        vector<quat> rotations(node_count);
+        vector<vec3> scales(node_count);
+        const auto& measure = [sample_count](const auto& func)
+        {
+            const auto& start = steady_clock_timer();
+            for(size_t i = 0; i < sample_count; ++i) func(static_cast<float>(i) / 60);
+            return duration<float, std::milli>{steady_clock_timer() - start}.count() /
+                static_cast<float>(std::max(sample_count, size_t{1}));
+        };
+
+        const auto tracks_time = measure(
+            [&](const float time) { tracks.evaluate(time, translations, rotations, scales); }
+        );
+        const auto reference_time = measure(
+            [&](const float time)
+            {
+                const auto local_time = std::fmod(time, times.back());
+                for(const auto& [node, path, values] : reference)
+                {
+                    const auto upper = std::upper_bound(times.cbegin(), times.cend(), local_time) - times.cbegin();
+                    const auto key = static_cast<size_t>(std::max(upper, decltype(upper){1}) - 1);
+                    const auto next = std::min(key + 1, key_count - 1);
+                    const auto factor = next == key ? 0 : (local_time - times[key]) / (times[next] - times[key]);
+                    const auto& from = values[key];
+                    const auto& to = values[next];
+                    switch(path)
+                    {
+                    case animation_path::translation: translations[node] = mix(vec3{from}, vec3{to}, factor);
+                        break;
+                    case animation_path::rotation:
+                        rotations[node] = glm::slerp(
+                            quat{from.w, from.x, from.y, from.z},
+                            quat{to.w, to.x, to.y, to.z},
+                            factor
+                        );
+                        break;
+                    case animation_path::scale: scales[node] = mix(vec3{from}, vec3{to}, factor);
+                        break;
+                    }
+                }
+            }
+        );
+        return {tracks_time, reference_time};
+    }
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "vulkan/utility/utility_core.h"
+
+namespace vulkan::utility
+{
+    enum class animation_path
+    {
+        translation,
+        rotation,
+        scale
+    };
+
+    //cubic spline keys hold the in tangent, the value and the out tangent one after another
+    enum class animation_interpolation
+    {
+        step,
+        linear,
+        cubic_spline
+    };
+
+    //keyframe tracks of many animations sampled together, every column is indexed by track and the keys of all
+    //tracks share one value column, tracks reading the same key times share their timeline,
+    //which is searched once per sample, each animation loops over its own duration
+    class animation_tracks
+    {
+        struct timeline_table
+        {
+            vector<size_t> animations;
+            vector<size_t> first_keys;
+            vector<size_t> key_counts;
+            //step timelines hold every key up to the next one, cubic spline tracks hold three values per key
+            vector<animation_interpolation> interpolations;
+            //key the last sample started from, time mostly moves forward so the search starts there
+            vector<size_t> cursors;
+
+            //the keys around the sampled time, how far between them it is and the time between them
+            vector<size_t> keys;
+            vector<size_t> next_keys;
+            vector<float> factors;
+            vector<float> spans;
+
+            [[nodiscard]] size_t size() const noexcept;
+
+            void push_back(const size_t, const size_t, const size_t, const animation_interpolation);
+        };
+
+        //linear and step tracks of vectors or rotations are blended four at a time, cubic splines one by one
+        struct track_group
+        {
+            vector<size_t> nodes;
+            vector<animation_path> paths;
+            vector<size_t> timelines;
+            //into the value column, which holds three values per key for cubic splines
+            vector<size_t> first_values;
+
+            [[nodiscard]] size_t size() const noexcept;
+
+            void push_back(const size_t, const animation_path, const size_t, const size_t);
+        };
+
+        //four tracks side by side, each array holds one component of all of them
+        using lanes = array<array<float, 4>, 4>;
+
+        //the keys the tracks blend between and how far between them they are
+        struct key_lanes
+        {
+            lanes from{};
+            lanes to{};
+            array<float, 4> factors{};
+        };
+
+        static constexpr size_t lane_count = 4;
+
+        vector<float> times_;
+        vector<vec4> values_;
+        vector<float> durations_;
+
+        timeline_table timelines_;
+        track_group vectors_;
+        track_group rotations_;
+        track_group cubic_splines_;
+
+        vector<size_t> changed_nodes_;
+
+        [[nodiscard]] static lanes lerp(const key_lanes&) noexcept;
+        //slerp approximated by nlerp with a corrected factor
+        [[nodiscard]] static lanes slerp(const key_lanes&) noexcept;
+
+        //finds the keys around the time of every timeline, relative to the start of its animation
+        void sample_timelines(const float);
+
+        //keys of the count tracks from the first one on at the sampled time of their timelines
+        void gather(const track_group&, const size_t, const size_t, key_lanes&) const;
+
+        //writes the blended values of the count tracks into their nodes, remembering the nodes that changed
+        void write(
+            const track_group&,
+            const size_t,
+            const size_t,
+            const lanes&,
+            vector<vec3>&,
+            vector<quat>&,
+            vector<vec3>&
+        );
+
+        void evaluate(const float, vector<vec3>&, vector<quat>&, vector<vec3>&);
+
+    public:
+        //adds the increasing key times of the animation sampled with the interpolation,
+        //returns the timeline tracks refer to them by
+        [[nodiscard]] size_t push_timeline(const size_t, const vector<float>&, const animation_interpolation);
+
+        //adds the track moving the path of the node along the timeline, values are given with four components,
+        //vectors leave the last one unused and rotations are x, y, z, w
+        void push_back(const size_t, const size_t, const animation_path, const vector<vec4>&);
+
+        [[nodiscard]] size_t size() const noexcept;
+        [[nodiscard]] size_t timeline_count() const noexcept;
+        [[nodiscard]] size_t animation_count() const noexcept;
+
+        //samples every track at the time in seconds and writes it into the transforms of its node,
+        //the function is called with each node whose transform changed
+        template<typename Func>
+        void sample(const float, vector<vec3>&, vector<quat>&, vector<vec3>&, Func&&);
+
+        //animates the count of synthetic nodes with a linear translation and rotation track each and a scale track
+        //on every tenth one, each on its own timeline, for the count of samples at 60 per second,
+        //returns the mean milliseconds per sample of the tracks and of a binary search per track with exact slerp
+        [[nodiscard]] static pair<float, float> benchmark(const size_t, const size_t);
+    };
+}
+
+#include "animation_tracks.tpp"
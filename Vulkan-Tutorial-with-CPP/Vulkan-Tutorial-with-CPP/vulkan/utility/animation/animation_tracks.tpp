@@ -0,0 +1,17 @@
+#pragma once
+
+namespace vulkan::utility
+{
+    template<typename Func>
+    void animation_tracks::sample(
+        const float time,
+        vector<vec3>& translations,
+        vector<quat>& rotations,
+        vector<vec3>& scales,
+        Func&& func
+    )
+    {
+        evaluate(time, translations, rotations, scales);
+        for(const auto node : changed_nodes_) func(node);
+    }
+}
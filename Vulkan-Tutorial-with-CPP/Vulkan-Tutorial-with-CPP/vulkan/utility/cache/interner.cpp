@@ -0,0 +1,26 @@
+#include "interner.h"
+
+namespace vulkan::utility
+{
+    uint64_t sampler_hash(const SamplerCreateInfo& info) noexcept
+    {
+        uint64_t hash = xxhash64_object(static_cast<VkSamplerCreateFlags>(info.flags));
+        for(const auto value : {
+                static_cast<uint64_t>(info.magFilter),
+                static_cast<uint64_t>(info.minFilter),
+                static_cast<uint64_t>(info.mipmapMode),
+                static_cast<uint64_t>(info.addressModeU),
+                static_cast<uint64_t>(info.addressModeV),
+                static_cast<uint64_t>(info.addressModeW),
+                static_cast<uint64_t>(info.anisotropyEnable),
+                static_cast<uint64_t>(info.compareEnable),
+                static_cast<uint64_t>(info.compareOp),
+                static_cast<uint64_t>(info.borderColor),
+                static_cast<uint64_t>(info.unnormalizedCoordinates)
+            })
+            hash = hash_combine(hash, xxhash64_object(value));
+        for(const auto value : {info.mipLodBias, info.maxAnisotropy, info.minLod, info.maxLod})
+            hash = hash_combine(hash, xxhash64_object(value));
+        return hash;
+    }
+}
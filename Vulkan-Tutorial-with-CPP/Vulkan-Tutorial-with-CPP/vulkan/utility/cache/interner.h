@@ -0,0 +1,41 @@
+#pragma once
+
+#include "vulkan/utility/obejct/object.h"
+#include <unordered_map>
+
+namespace vulkan::utility
+{
+    //content hash of the fields that define a sampler, the extension chain is not followed
+    [[nodiscard]] uint64_t sampler_hash(const SamplerCreateInfo&) noexcept;
+
+    //hands out one shared resource per distinct content and counts what the duplicates would have cost
+    template<typename Resource>
+    class interner
+    {
+    public:
+        struct statistics
+        {
+            size_t requests = 0;
+            size_t unique = 0;
+            DeviceSize saved_bytes = 0;
+        };
+
+    private:
+        std::unordered_multimap<uint64_t, std::shared_ptr<Resource>> resources_;
+        statistics statistics_;
+
+    public:
+        //the factory only runs for content not seen before, equal guards against hash collisions
+        template<typename Factory, typename Equal>
+        [[nodiscard]] std::shared_ptr<Resource> intern(const uint64_t, const DeviceSize, Factory&&, const Equal&);
+
+        template<typename Factory>
+        [[nodiscard]] std::shared_ptr<Resource> intern(const uint64_t, const DeviceSize, Factory&&);
+
+        [[nodiscard]] const statistics& get_statistics() const noexcept;
+
+        void clear() noexcept;
+    };
+}
+
+#include "interner.tpp"
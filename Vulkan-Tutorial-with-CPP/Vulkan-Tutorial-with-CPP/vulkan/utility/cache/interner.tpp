@@ -0,0 +1,48 @@
+#pragma once
+
+namespace vulkan::utility
+{
+    template<typename Resource>
+    template<typename Factory, typename Equal>
+    std::shared_ptr<Resource> interner<Resource>::intern(
+        const uint64_t hash,
+        const DeviceSize size,
+        Factory&& factory,
+        const Equal& equal
+    )
+    {
+        ++statistics_.requests;
+
+        const auto& [first, last] = resources_.equal_range(hash);
+        const auto& it = std::find_if(
+            first,
+            last,
+            [&equal](typename decltype(resources_)::const_reference pair) { return equal(*pair.second); }
+        );
+        if(it != last)
+        {
+            statistics_.saved_bytes += size;
+            return it->second;
+        }
+
+        ++statistics_.unique;
+        return resources_.emplace(hash, std::make_shared<Resource>(std::forward<Factory>(factory)()))->second;
+    }
+
+    template<typename Resource>
+    template<typename Factory>
+    std::shared_ptr<Resource> interner<Resource>::intern(const uint64_t hash, const DeviceSize size, Factory&& factory)
+    {
+        return intern(hash, size, std::forward<Factory>(factory), [](const Resource&) { return true; });
+    }
+
+    template<typename Resource>
+    auto interner<Resource>::get_statistics() const noexcept -> const statistics& { return statistics_; }
+
+    template<typename Resource>
+    void interner<Resource>::clear() noexcept
+    {
+        resources_.clear();
+        statistics_ = {};
+    }
+}
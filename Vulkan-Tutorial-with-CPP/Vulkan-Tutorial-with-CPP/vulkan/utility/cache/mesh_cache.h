@@ -0,0 +1,106 @@
+#pragma once
+
+#include "texture_cache.h"
+#include "vulkan/utility/stream/texture_streaming.h"
+
+namespace vulkan::utility
+{
+    //cache of welded model geometry in the exact layout of the vertex and index buffers, keyed by source content
+    template<typename Vertex, typename Index = uint32_t>
+    class mesh_cache
+    {
+    public:
+        using vertex_type = Vertex;
+        using index_type = Index;
+
+        struct header
+        {
+            static constexpr uint32_t magic_value = 0x4853454d;
+            static constexpr uint32_t version_value = 4;
+
+            uint32_t magic = magic_value;
+            uint32_t version = version_value;
+            uint64_t key = 0;
+            uint32_t vertex_size = sizeof(vertex_type);
+            uint32_t index_size = sizeof(index_type);
+            uint64_t mesh_count = 0;
+            uint64_t vertex_count = 0;
+            uint64_t index_count = 0;
+        };
+
+        //one draw of the model, material_id is negative for meshes without a material
+        struct mesh
+        {
+            uint32_t first_index = 0;
+            uint32_t index_count = 0;
+            int32_t material_id = -1;
+            bounding_sphere bounds;
+            vec2 texture_coordinate_span{};
+        };
+
+        //header, mesh table, vertices and indices, each array directly after the previous one
+        class entry
+        {
+            boost::interprocess::file_mapping file_;
+            boost::interprocess::mapped_region region_;
+
+            template<typename T>
+            [[nodiscard]] pair<const T*, const T*> range(const uint64_t, const uint64_t) const noexcept;
+
+        public:
+            explicit entry(const path&);
+
+            [[nodiscard]] bool is_valid(const uint64_t) const noexcept;
+
+            [[nodiscard]] const header& get_header() const noexcept;
+
+            [[nodiscard]] pair<const mesh*, const mesh*> meshes() const noexcept;
+            [[nodiscard]] pair<const vertex_type*, const vertex_type*> vertices() const noexcept;
+            [[nodiscard]] pair<const index_type*, const index_type*> indices() const noexcept;
+        };
+
+        //writes an entry in file order while its buffers are produced, it only takes the place of the entry
+        //once committed, so a failed or abandoned write leaves no entry behind
+        class writer
+        {
+            path file_path_;
+            path temp_path_;
+            ofstream stream_;
+
+        public:
+            writer(path, const header&, const vector<mesh>&) noexcept;
+
+            template<typename T>
+            void write(const T*, const T*) noexcept;
+
+            void commit() noexcept;
+        };
+
+    private:
+        path directory_;
+
+        [[nodiscard]] path entry_path(const uint64_t) const;
+
+    public:
+        explicit mesh_cache(path);
+
+        //the seed covers the other files the geometry depends on
+        [[nodiscard]] static uint64_t key(const path&, const uint64_t = 0);
+        //for sources already hashed by their loader, like the mapped files of a gltf model
+        [[nodiscard]] static uint64_t key(const uint64_t);
+
+        [[nodiscard]] optional<entry> find(const uint64_t) const;
+
+        void store(
+            const uint64_t,
+            const vector<mesh>&,
+            const vector<vertex_type>&,
+            const vector<index_type>&
+        ) const noexcept;
+
+        //for buffers that are never whole in memory, the vertices and then the indices go to the writer
+        [[nodiscard]] writer store(const uint64_t, const vector<mesh>&, const uint64_t, const uint64_t) const;
+    };
+}
+
+#include "mesh_cache.tpp"
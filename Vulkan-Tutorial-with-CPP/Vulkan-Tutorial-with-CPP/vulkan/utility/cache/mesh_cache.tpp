@@ -0,0 +1,181 @@
+#pragma once
+
+namespace vulkan::utility
+{
+    template<typename Vertex, typename Index>
+    mesh_cache<Vertex, Index>::entry::entry(const path& entry_path) :
+        file_(entry_path.string().c_str(), boost::interprocess::read_only),
+        region_(file_, boost::interprocess::read_only) {}
+
+    template<typename Vertex, typename Index>
+    template<typename T>
+    auto mesh_cache<Vertex, Index>::entry::range(const uint64_t offset, const uint64_t count) const noexcept
+        -> pair<const T*, const T*>
+    {
+        const auto* const begin = reinterpret_cast<const T*>(
+            static_cast<const uint8_t*>(region_.get_address()) + sizeof(header) + offset
+        );
+        return {begin, begin + count};
+    }
+
+    template<typename Vertex, typename Index>
+    bool mesh_cache<Vertex, Index>::entry::is_valid(const uint64_t key) const noexcept
+    {
+        if(region_.get_size() < sizeof(header)) return false;
+
+        const auto& entry_header = get_header();
+        return entry_header.magic == header::magic_value &&
+            entry_header.version == header::version_value &&
+            entry_header.key == key &&
+            entry_header.vertex_size == sizeof(vertex_type) &&
+            entry_header.index_size == sizeof(index_type) &&
+            region_.get_size() == sizeof(header) +
+            entry_header.mesh_count * sizeof(mesh) +
+            entry_header.vertex_count * sizeof(vertex_type) +
+            entry_header.index_count * sizeof(index_type);
+    }
+
+    template<typename Vertex, typename Index>
+    auto mesh_cache<Vertex, Index>::entry::get_header() const noexcept -> const header&
+    {
+        return *static_cast<const header*>(region_.get_address());
+    }
+
+    template<typename Vertex, typename Index>
+    auto mesh_cache<Vertex, Index>::entry::meshes() const noexcept -> pair<const mesh*, const mesh*>
+    {
+        return range<mesh>(0, get_header().mesh_count);
+    }
+
+    template<typename Vertex, typename Index>
+    auto mesh_cache<Vertex, Index>::entry::vertices() const noexcept -> pair<const vertex_type*, const vertex_type*>
+    {
+        return range<vertex_type>(get_header().mesh_count * sizeof(mesh), get_header().vertex_count);
+    }
+
+    template<typename Vertex, typename Index>
+    auto mesh_cache<Vertex, Index>::entry::indices() const noexcept -> pair<const index_type*, const index_type*>
+    {
+        const auto& entry_header = get_header();
+        return range<index_type>(
+            entry_header.mesh_count * sizeof(mesh) + entry_header.vertex_count * sizeof(vertex_type),
+            entry_header.index_count
+        );
+    }
+
+    template<typename Vertex, typename Index>
+    mesh_cache<Vertex, Index>::writer::writer(path file_path, const header& entry_header, const vector<mesh>& meshes)
+        noexcept
+    {
+        //the cache is best-effort, a writer that fails to open only ignores what it is given
+        try
+        {
+            file_path_ = std::move(file_path);
+            temp_path_ = unique_temp_path(file_path_);
+            stream_.open(temp_path_, std::ios::binary | std::ios::trunc);
+            stream_.write(reinterpret_cast<const char*>(&entry_header), sizeof(header));
+            write(meshes.data(), meshes.data() + meshes.size());
+        }
+        catch(const std::exception&) { stream_.setstate(std::ios::failbit); }
+    }
+
+    template<typename Vertex, typename Index>
+    template<typename T>
+    void mesh_cache<Vertex, Index>::writer::write(const T* begin, const T* end) noexcept
+    {
+        if(stream_)
+            stream_.write(
+                reinterpret_cast<const char*>(begin),
+                static_cast<std::streamsize>(static_cast<size_t>(end - begin) * sizeof(T))
+            );
+    }
+
+    template<typename Vertex, typename Index>
+    void mesh_cache<Vertex, Index>::writer::commit() noexcept
+    {
+        try
+        {
+            stream_.close();
+            if(stream_) std::filesystem::rename(temp_path_, file_path_);
+            else std::filesystem::remove(temp_path_);
+        }
+        catch(const std::exception&) {}
+    }
+
+    template<typename Vertex, typename Index>
+    path mesh_cache<Vertex, Index>::entry_path(const uint64_t key) const
+    {
+        ostringstream stream;
+        stream << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+        return directory_ / stream.str();
+    }
+
+    template<typename Vertex, typename Index>
+    mesh_cache<Vertex, Index>::mesh_cache(path directory) : directory_(std::move(directory))
+    {
+        std::error_code error;
+        std::filesystem::create_directories(directory_, error);
+    }
+
+    template<typename Vertex, typename Index>
+    uint64_t mesh_cache<Vertex, Index>::key(const path& source, const uint64_t seed)
+    {
+        return file_hash(source, hash_combine(seed, hash_combine(header::version_value, sizeof(vertex_type))));
+    }
+
+    template<typename Vertex, typename Index>
+    uint64_t mesh_cache<Vertex, Index>::key(const uint64_t content_hash)
+    {
+        return hash_combine(content_hash, hash_combine(header::version_value, sizeof(vertex_type)));
+    }
+
+    template<typename Vertex, typename Index>
+    auto mesh_cache<Vertex, Index>::find(const uint64_t key) const -> optional<entry>
+    {
+        const auto& file_path = entry_path(key);
+        if(!std::filesystem::exists(file_path)) return nullopt;
+
+        try
+        {
+            entry cached{file_path};
+            if(cached.is_valid(key)) return std::move(cached);
+        }
+        catch(const boost::interprocess::interprocess_exception&) {}
+        return nullopt;
+    }
+
+    template<typename Vertex, typename Index>
+    void mesh_cache<Vertex, Index>::store(
+        const uint64_t key,
+        const vector<mesh>& meshes,
+        const vector<vertex_type>& vertices,
+        const vector<index_type>& indices
+    ) const noexcept
+    {
+        //the cache is best-effort, a failed store only costs a parse on the next run
+        try
+        {
+            auto entry_writer = store(key, meshes, vertices.size(), indices.size());
+            entry_writer.write(vertices.data(), vertices.data() + vertices.size());
+            entry_writer.write(indices.data(), indices.data() + indices.size());
+            entry_writer.commit();
+        }
+        catch(const std::exception&) {}
+    }
+
+    template<typename Vertex, typename Index>
+    auto mesh_cache<Vertex, Index>::store(
+        const uint64_t key,
+        const vector<mesh>& meshes,
+        const uint64_t vertex_count,
+        const uint64_t index_count
+    ) const -> writer
+    {
+        header entry_header;
+        entry_header.key = key;
+        entry_header.mesh_count = meshes.size();
+        entry_header.vertex_count = vertex_count;
+        entry_header.index_count = index_count;
+        return {entry_path(key), entry_header, meshes};
+    }
+}
@@ -0,0 +1,93 @@
+#include "tangent_cache.h"
+
+namespace vulkan::utility
+{
+    tangent_cache::entry::entry(const path& entry_path) :
+        file_(entry_path.string().c_str(), boost::interprocess::read_only),
+        region_(file_, boost::interprocess::read_only) {}
+
+    bool tangent_cache::entry::is_valid(const uint64_t key) const noexcept
+    {
+        if(region_.get_size() < sizeof(header)) return false;
+
+        const auto& entry_header = get_header();
+        return entry_header.magic == header::magic_value &&
+            entry_header.version == header::version_value &&
+            entry_header.key == key &&
+            region_.get_size() == sizeof(header) +
+                entry_header.tangent_count * sizeof(vec4) +
+                entry_header.split_count * sizeof(uint32_t);
+    }
+
+    auto tangent_cache::entry::get_header() const noexcept -> const header&
+    {
+        return *static_cast<const header*>(region_.get_address());
+    }
+
+    pair<const vec4*, const vec4*> tangent_cache::entry::tangents() const noexcept
+    {
+        const auto* const begin = reinterpret_cast<const vec4*>(
+            static_cast<const uint8_t*>(region_.get_address()) + sizeof(header)
+        );
+        return {begin, begin + get_header().tangent_count};
+    }
+
+    pair<const uint32_t*, const uint32_t*> tangent_cache::entry::splits() const noexcept
+    {
+        const auto* const begin = reinterpret_cast<const uint32_t*>(tangents().second);
+        return {begin, begin + get_header().split_count};
+    }
+
+    tangent_cache::tangent_cache(path file_path) : file_path_(std::move(file_path)) {}
+
+    auto tangent_cache::find(const uint64_t key) const -> optional<entry>
+    {
+        if(!std::filesystem::exists(file_path_)) return nullopt;
+
+        try
+        {
+            entry cached{file_path_};
+            if(cached.is_valid(key)) return std::move(cached);
+        }
+        catch(const boost::interprocess::interprocess_exception&) {}
+        return nullopt;
+    }
+
+    void tangent_cache::store(
+        const uint64_t key,
+        const vector<vec4>& tangents,
+        const vector<uint32_t>& splits
+    ) const noexcept
+    {
+        //the cache is best-effort, a failed store only costs a generation on the next run
+        try
+        {
+            header entry_header;
+            entry_header.key = key;
+            entry_header.tangent_count = tangents.size();
+            entry_header.split_count = splits.size();
+
+            const auto& temp_path = unique_temp_path(file_path_);
+            {
+                ofstream stream{temp_path, std::ios::binary | std::ios::trunc};
+                stream.write(reinterpret_cast<const char*>(&entry_header), sizeof(header));
+                stream.write(
+                    reinterpret_cast<const char*>(tangents.data()),
+                    static_cast<std::streamsize>(tangents.size() * sizeof(vec4))
+                );
+                stream.write(
+                    reinterpret_cast<const char*>(splits.data()),
+                    static_cast<std::streamsize>(splits.size() * sizeof(uint32_t))
+                );
+                stream.close();
+                if(!stream)
+                {
+                    std::filesystem::remove(temp_path);
+                    return;
+                }
+            }
+            std::filesystem::rename(temp_path, file_path_);
+        }
+        catch(const std::exception&) {}
+    }
+}
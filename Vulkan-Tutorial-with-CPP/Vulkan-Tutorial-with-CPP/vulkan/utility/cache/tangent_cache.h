@@ -0,0 +1,52 @@
+#pragma once
+
+#include "texture_cache.h"
+
+namespace vulkan::utility
+{
+    //tangents generated for a model along with how its vertices were split for them, kept in one file next to it
+    //and keyed by the content they were generated from, the split words are laid out by the model
+    class tangent_cache
+    {
+    public:
+        struct header
+        {
+            static constexpr uint32_t magic_value = 0x544e4754;
+            static constexpr uint32_t version_value = 2;
+
+            uint32_t magic = magic_value;
+            uint32_t version = version_value;
+            uint64_t key = 0;
+            uint64_t tangent_count = 0;
+            uint64_t split_count = 0;
+        };
+
+        //header, tangents and split words directly after each other
+        class entry
+        {
+            boost::interprocess::file_mapping file_;
+            boost::interprocess::mapped_region region_;
+
+        public:
+            explicit entry(const path&);
+
+            [[nodiscard]] bool is_valid(const uint64_t) const noexcept;
+
+            [[nodiscard]] const header& get_header() const noexcept;
+
+            [[nodiscard]] pair<const vec4*, const vec4*> tangents() const noexcept;
+
+            [[nodiscard]] pair<const uint32_t*, const uint32_t*> splits() const noexcept;
+        };
+
+    private:
+        path file_path_;
+
+    public:
+        explicit tangent_cache(path);
+
+        [[nodiscard]] optional<entry> find(const uint64_t) const;
+
+        void store(const uint64_t, const vector<vec4>&, const vector<uint32_t>&) const noexcept;
+    };
+}
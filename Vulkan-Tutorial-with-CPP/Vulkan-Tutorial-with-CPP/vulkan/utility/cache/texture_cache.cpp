@@ -0,0 +1,16 @@
+#include "texture_cache.h"
+
+namespace vulkan::utility
+{
+    uint64_t file_hash(const path& file_path, const uint64_t seed)
+    {
+        using namespace boost::interprocess;
+
+        if(!std::filesystem::exists(file_path)) throw std::runtime_error{"cannot open file:" + file_path.string()};
+        if(std::filesystem::file_size(file_path) == 0) return xxhash64(nullptr, 0, seed);
+
+        const file_mapping file{file_path.string().c_str(), read_only};
+        const mapped_region region{file, read_only};
+        return xxhash64(region.get_address(), region.get_size(), seed);
+    }
+}
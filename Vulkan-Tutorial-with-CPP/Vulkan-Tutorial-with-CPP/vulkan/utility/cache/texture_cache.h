@@ -0,0 +1,74 @@
+#pragma once
+
+#include "vulkan/utility/obejct/image.h"
+#include "vulkan/utility/stb/pixel_traits.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <iomanip>
+
+namespace vulkan::utility
+{
+    [[nodiscard]] uint64_t file_hash(const path&, const uint64_t seed = 0);
+
+    //content-addressed cache of gpu-ready mip chains, keyed by source file content and target format
+    template<Format FormatValue>
+    class texture_cache
+    {
+    public:
+        static constexpr auto format_value = FormatValue;
+
+        using pixel_type = constant::format_t<format_value>;
+
+        struct header
+        {
+            static constexpr uint32_t magic_value = 0x43545456;
+            static constexpr uint32_t version_value = 2;
+
+            uint32_t magic = magic_value;
+            uint32_t version = version_value;
+            uint64_t key = 0;
+            //hash of the decoded base level, identical images from different files share it
+            uint64_t content_hash = 0;
+            int32_t format = static_cast<int32_t>(format_value);
+            uint32_t width = 0;
+            uint32_t height = 0;
+            uint32_t mip_levels = 0;
+        };
+
+        class entry
+        {
+            boost::interprocess::file_mapping file_;
+            boost::interprocess::mapped_region region_;
+
+        public:
+            explicit entry(const path&);
+
+            [[nodiscard]] bool is_valid(const uint64_t) const noexcept;
+
+            [[nodiscard]] const header& get_header() const noexcept;
+            [[nodiscard]] Extent3D extent() const noexcept;
+
+            [[nodiscard]] const pixel_type* cbegin() const noexcept;
+            [[nodiscard]] const pixel_type* cend() const noexcept;
+        };
+
+    private:
+        path directory_;
+
+        [[nodiscard]] path entry_path(const uint64_t) const;
+
+    public:
+        explicit texture_cache(path);
+
+        [[nodiscard]] static uint64_t key(const path&);
+
+        //returns mip levels after the base level, packed in the staging buffer layout
+        [[nodiscard]] static vector<pixel_type> generate_mip_levels(const pixel_type*, const Extent2D);
+
+        [[nodiscard]] optional<entry> find(const uint64_t) const;
+
+        void store(const uint64_t, const Extent2D, const pixel_type*, const vector<pixel_type>&) const noexcept;
+    };
+}
+
+#include "texture_cache.tpp"
@@ -0,0 +1,169 @@
+#pragma once
+
+namespace vulkan::utility
+{
+    template<Format FormatValue>
+    texture_cache<FormatValue>::entry::entry(const path& entry_path) :
+        file_(entry_path.string().c_str(), boost::interprocess::read_only),
+        region_(file_, boost::interprocess::read_only) {}
+
+    template<Format FormatValue>
+    bool texture_cache<FormatValue>::entry::is_valid(const uint64_t key) const noexcept
+    {
+        if(region_.get_size() < sizeof(header)) return false;
+
+        const auto& entry_header = get_header();
+        return entry_header.magic == header::magic_value &&
+            entry_header.version == header::version_value &&
+            entry_header.key == key &&
+            entry_header.format == static_cast<int32_t>(format_value) &&
+            entry_header.mip_levels == mip_levels(extent()) &&
+            region_.get_size() == sizeof(header) +
+            mip_level_texel_offset(extent(), entry_header.mip_levels) * sizeof(pixel_type);
+    }
+
+    template<Format FormatValue>
+    auto texture_cache<FormatValue>::entry::get_header() const noexcept -> const header&
+    {
+        return *static_cast<const header*>(region_.get_address());
+    }
+
+    template<Format FormatValue>
+    Extent3D texture_cache<FormatValue>::entry::extent() const noexcept
+    {
+        return {get_header().width, get_header().height, 1};
+    }
+
+    template<Format FormatValue>
+    auto texture_cache<FormatValue>::entry::cbegin() const noexcept -> const pixel_type*
+    {
+        return reinterpret_cast<const pixel_type*>(static_cast<const uint8_t*>(region_.get_address()) + sizeof(header));
+    }
+
+    template<Format FormatValue>
+    auto texture_cache<FormatValue>::entry::cend() const noexcept -> const pixel_type*
+    {
+        return cbegin() + mip_level_texel_offset(extent(), get_header().mip_levels);
+    }
+
+    template<Format FormatValue>
+    path texture_cache<FormatValue>::entry_path(const uint64_t key) const
+    {
+        ostringstream stream;
+        stream << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+        return directory_ / stream.str();
+    }
+
+    template<Format FormatValue>
+    texture_cache<FormatValue>::texture_cache(path directory) : directory_(std::move(directory))
+    {
+        std::error_code error;
+        std::filesystem::create_directories(directory_, error);
+    }
+
+    template<Format FormatValue>
+    uint64_t texture_cache<FormatValue>::key(const path& source) { return file_hash(source, header{}.format); }
+
+    template<Format FormatValue>
+    auto texture_cache<FormatValue>::generate_mip_levels(
+        const pixel_type* const base,
+        const Extent2D extent
+    ) -> vector<pixel_type>
+    {
+        const Extent3D base_extent{extent.width, extent.height, 1};
+        const auto levels = mip_levels(base_extent);
+        const auto base_size = mip_level_texel_offset(base_extent, 1);
+
+        vector<pixel_type> pixels(mip_level_texel_offset(base_extent, levels) - base_size);
+
+        for(uint32_t level = 1; level < levels; ++level)
+        {
+            const auto& src_extent = mip_level_extent(base_extent, level - 1);
+            const auto* const src = level == 1 ?
+                base :
+                pixels.data() + (mip_level_texel_offset(base_extent, level - 1) - base_size);
+            const auto dst = pixels.begin() + (mip_level_texel_offset(base_extent, level) - base_size);
+
+            //2x2 box filter, the last row or column is repeated for odd sizes
+            if constexpr(std::is_same_v<pixel_type, stb::pixel_t<stb::channel::rgb_alpha>>)
+                stb::downsample(src, src_extent.width, src_extent.height, &*dst);
+            else
+            {
+                using wide_type = glm::vec<pixel_type::length(), uint32_t>;
+
+                const auto& dst_extent = mip_level_extent(base_extent, level);
+                for(uint32_t y = 0; y < dst_extent.height; ++y)
+                    for(uint32_t x = 0; x < dst_extent.width; ++x)
+                    {
+                        const auto x0 = std::min(2 * x, src_extent.width - 1);
+                        const auto x1 = std::min(2 * x + 1, src_extent.width - 1);
+                        const auto y0 = std::min(2 * y, src_extent.height - 1) * src_extent.width;
+                        const auto y1 = std::min(2 * y + 1, src_extent.height - 1) * src_extent.width;
+                        const auto sum = wide_type{src[y0 + x0]} + wide_type{src[y0 + x1]} +
+                            wide_type{src[y1 + x0]} + wide_type{src[y1 + x1]};
+                        dst[y * dst_extent.width + x] = pixel_type{(sum + 2u) / 4u};
+                    }
+            }
+        }
+
+        return pixels;
+    }
+
+    template<Format FormatValue>
+    auto texture_cache<FormatValue>::find(const uint64_t key) const -> optional<entry>
+    {
+        const auto& file_path = entry_path(key);
+        if(!std::filesystem::exists(file_path)) return nullopt;
+
+        try
+        {
+            entry cached{file_path};
+            if(cached.is_valid(key)) return std::move(cached);
+        }
+        catch(const boost::interprocess::interprocess_exception&) {}
+        return nullopt;
+    }
+
+    template<Format FormatValue>
+    void texture_cache<FormatValue>::store(
+        const uint64_t key,
+        const Extent2D extent,
+        const pixel_type* const base,
+        const vector<pixel_type>& mip_levels
+    ) const noexcept
+    {
+        //the cache is best-effort, a failed store only costs a decode on the next run
+        try
+        {
+            header entry_header;
+            entry_header.key = key;
+            entry_header.content_hash = xxhash64(base, size_t{extent.width} * extent.height * sizeof(pixel_type));
+            entry_header.width = extent.width;
+            entry_header.height = extent.height;
+            entry_header.mip_levels = utility::mip_levels(Extent3D{extent.width, extent.height, 1});
+
+            const auto& file_path = entry_path(key);
+            const auto& temp_path = unique_temp_path(file_path);
+            {
+                ofstream stream{temp_path, std::ios::binary | std::ios::trunc};
+                stream.write(reinterpret_cast<const char*>(&entry_header), sizeof(header));
+                stream.write(
+                    reinterpret_cast<const char*>(base),
+                    static_cast<std::streamsize>(size_t{extent.width} * extent.height * sizeof(pixel_type))
+                );
+                stream.write(
+                    reinterpret_cast<const char*>(mip_levels.data()),
+                    static_cast<std::streamsize>(mip_levels.size() * sizeof(pixel_type))
+                );
+                stream.close();
+                if(!stream)
+                {
+                    std::filesystem::remove(temp_path);
+                    return;
+                }
+            }
+            std::filesystem::rename(temp_path, file_path);
+        }
+        catch(const std::exception&) {}
+    }
+}
@@ -221,6 +221,15 @@ namespace vulkan::utility::constant
     template<Format FormatValue>
     using format_t = typename format<FormatValue>::type;
 
+    template<Format... Formats>
+    inline constexpr auto vertex_stride = (static_cast<uint32_t>(sizeof(format_t<Formats>)) + ...);
+
+    //attributes at consecutive locations of one binding, laid out like a struct with a member of each format in order
+    template<Format... Formats>
+    constexpr array<VertexInputAttributeDescription, sizeof...(Formats)> vertex_attribute_descriptions(
+        const uint32_t = 0
+    );
+
     template<typename T>
     inline constexpr auto index_type = IndexType::eNoneNV;
 
@@ -2,6 +2,26 @@
 
 namespace vulkan::utility::constant
 {
+	template<Format... Formats, size_t... Indices>
+	constexpr array<VertexInputAttributeDescription, sizeof...(Formats)> vertex_attribute_descriptions(
+		const uint32_t binding,
+		std::index_sequence<Indices...>
+	)
+	{
+		constexpr array<uint32_t, sizeof...(Formats)> sizes{static_cast<uint32_t>(sizeof(format_t<Formats>))...};
+		array<uint32_t, sizeof...(Formats)> offsets{};
+		for(size_t i = 1; i < offsets.size(); ++i) offsets[i] = offsets[i - 1] + sizes[i - 1];
+		return {VertexInputAttributeDescription{static_cast<uint32_t>(Indices), binding, Formats, offsets[Indices]}...};
+	}
+
+	template<Format... Formats>
+	constexpr array<VertexInputAttributeDescription, sizeof...(Formats)> vertex_attribute_descriptions(
+		const uint32_t binding
+	)
+	{
+		return vertex_attribute_descriptions<Formats...>(binding, std::make_index_sequence<sizeof...(Formats)>{});
+	}
+
 	constexpr pair<AccessFlags, PipelineStageFlagBits> required_access_and_pipeline_stage(const ImageLayout layout)
 	{
 		switch(layout)
@@ -1,15 +1,472 @@
 #define TINYGLTF_IMPLEMENTATION
 #include "gltf.h"
+#include <charconv>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define GLTF_SIMD
+#include <immintrin.h>
+#endif
 
 namespace vulkan::utility
 {
-    gltf_model::texture::texture(const tinygltf::Image& gltf_image, const tinygltf::Sampler& sampler) noexcept:
-        extent(static_cast<uint32_t>(gltf_image.width), static_cast<uint32_t>(gltf_image.height)),
+    namespace
+    {
+        //columns are contiguous in glm, so a column of the product is the left columns scaled by the right column,
+        //sse2 is part of x86-64 and needs no dispatch
+        mat4 multiply(const mat4& left, const mat4& right) noexcept
+        {
+#ifdef GLTF_SIMD
+            const __m128 left_columns[] = {
+                _mm_loadu_ps(&left[0][0]),
+                _mm_loadu_ps(&left[1][0]),
+                _mm_loadu_ps(&left[2][0]),
+                _mm_loadu_ps(&left[3][0])
+            };
+            mat4 product;
+            for(length_t i = 0; i < 4; ++i)
+            {
+                const auto& column = right[i];
+                auto sum = _mm_mul_ps(left_columns[0], _mm_set1_ps(column[0]));
+                sum = _mm_add_ps(sum, _mm_mul_ps(left_columns[1], _mm_set1_ps(column[1])));
+                sum = _mm_add_ps(sum, _mm_mul_ps(left_columns[2], _mm_set1_ps(column[2])));
+                sum = _mm_add_ps(sum, _mm_mul_ps(left_columns[3], _mm_set1_ps(column[3])));
+                _mm_storeu_ps(&product[i][0], sum);
+            }
+            return product;
+#else
+            return left * right;
+#endif
+        }
+
+        //normalized integers map onto [0, 1] or [-1, 1] as KHR_mesh_quantization uses them, others keep their value
+        template<typename T>
+        float to_float(const T value, const bool normalized) noexcept
+        {
+            if constexpr(std::is_floating_point_v<T>) return value;
+            else if(normalized)
+                return std::max(
+                    static_cast<float>(value) / static_cast<float>(::utility::constant::numeric::numberic_max<T>),
+                    -1.0f
+                );
+            else return static_cast<float>(value);
+        }
+
+        //converts the count elements of the source into the leading components of the floats the destination
+        //elements start with, in one pass over both
+        template<typename T>
+        void convert_elements(
+            const unsigned char* const source,
+            const size_t source_stride,
+            const size_t count,
+            const size_t components,
+            const bool normalized,
+            unsigned char* const destination,
+            const size_t destination_stride
+        ) noexcept
+        {
+#ifdef GLTF_SIMD
+            if constexpr(sizeof(T) < 4 || std::is_same_v<T, float>)
+            {
+                //an element is loaded whole into one register and widened to four lanes, which may read into the
+                //padding or the next element, the last element and tightly packed small ones are copied out first
+                constexpr auto register_size = sizeof(T) * 4;
+                const auto component_size = sizeof(T) * components;
+                const auto is_load_safe = register_size <= source_stride + component_size;
+                const auto scale = _mm_set1_ps(
+                    normalized ?
+                        1 / static_cast<float>(::utility::constant::numeric::numberic_max<T>) :
+                        1.0f
+                );
+                const auto lower_bound = _mm_set1_ps(
+                    normalized ? -1.0f : ::utility::constant::numeric::numberic_lowest<float>
+                );
+
+                for(size_t i = 0; i < count; ++i)
+                {
+                    const auto* element = source + i * source_stride;
+                    array<T, 4> padded{};
+                    if(!is_load_safe || i + 1 == count)
+                    {
+                        std::memcpy(padded.data(), element, component_size);
+                        element = reinterpret_cast<const unsigned char*>(padded.data());
+                    }
+
+                    __m128 lanes;
+                    if constexpr(std::is_same_v<T, float>)
+                        lanes = _mm_loadu_ps(reinterpret_cast<const float*>(element));
+                    else
+                    {
+                        __m128i integers;
+                        if constexpr(sizeof(T) == 1)
+                        {
+                            int32_t bytes;
+                            std::memcpy(&bytes, element, sizeof(bytes));
+                            integers = _mm_cvtsi32_si128(bytes);
+                            if constexpr(std::is_signed_v<T>)
+                            {
+                                integers = _mm_unpacklo_epi8(integers, integers);
+                                integers = _mm_srai_epi32(_mm_unpacklo_epi16(integers, integers), 24);
+                            }
+                            else
+                                integers = _mm_unpacklo_epi16(
+                                    _mm_unpacklo_epi8(integers, _mm_setzero_si128()),
+                                    _mm_setzero_si128()
+                                );
+                        }
+                        else
+                        {
+                            integers = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(element));
+                            if constexpr(std::is_signed_v<T>)
+                                integers = _mm_srai_epi32(_mm_unpacklo_epi16(integers, integers), 16);
+                            else integers = _mm_unpacklo_epi16(integers, _mm_setzero_si128());
+                        }
+                        lanes = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(integers), scale), lower_bound);
+                    }
+
+                    auto* const target = reinterpret_cast<float*>(destination + i * destination_stride);
+                    switch(components)
+                    {
+                    case 4: _mm_storeu_ps(target, lanes);
+                        break;
+                    case 3: _mm_storel_pi(reinterpret_cast<__m64*>(target), lanes);
+                        _mm_store_ss(target + 2, _mm_movehl_ps(lanes, lanes));
+                        break;
+                    case 2: _mm_storel_pi(reinterpret_cast<__m64*>(target), lanes);
+                        break;
+                    default: _mm_store_ss(target, lanes);
+                        break;
+                    }
+                }
+                return;
+            }
+#endif
+            for(size_t i = 0; i < count; ++i)
+            {
+                auto* const target = reinterpret_cast<float*>(destination + i * destination_stride);
+                for(size_t j = 0; j < components; ++j)
+                {
+                    T component;
+                    std::memcpy(&component, source + i * source_stride + j * sizeof(component), sizeof(component));
+                    target[j] = to_float(component, normalized);
+                }
+            }
+        }
+
+        //converts the leading components of every element of the accessor into the floats each destination
+        //element starts with, so attributes are written straight into interleaved vertices or their own streams,
+        //components the accessor does not have are left as they are, so are the elements of an accessor
+        //without a buffer view
+        void convert_accessor(
+            const gltf_model::model_source& source,
+            const tinygltf::Accessor& accessor,
+            unsigned char* const destination,
+            const size_t destination_stride,
+            const length_t destination_components
+        )
+        {
+            if(accessor.bufferView < 0) return;
+
+            const auto component_size = tinygltf::GetComponentSizeInBytes(accessor.componentType);
+            const auto component_count = tinygltf::GetNumComponentsInType(accessor.type);
+            if(component_size <= 0 || component_count <= 0) throw std::runtime_error{"component type is not supported"};
+
+            //tightly packed elements have no stride in their view
+            const auto byte_stride = source.model.bufferViews[accessor.bufferView].byteStride;
+            const auto stride = byte_stride != 0 ? byte_stride : static_cast<size_t>(component_size * component_count);
+            if(stride % component_size != 0) throw std::runtime_error{"stride is not aligned"};
+
+            const auto components = static_cast<size_t>(
+                std::min(static_cast<length_t>(component_count), destination_components)
+            );
+            const auto convert_func = [&accessor, data = source.data(accessor), stride, components, destination,
+                    destination_stride](const auto component_tag)
+            {
+                convert_elements<decltype(component_tag)>(
+                    data,
+                    stride,
+                    accessor.count,
+                    components,
+                    accessor.normalized,
+                    destination,
+                    destination_stride
+                );
+            };
+
+            switch(accessor.componentType)
+            {
+            case TINYGLTF_PARAMETER_TYPE_FLOAT: convert_func(float{});
+                break;
+            case TINYGLTF_PARAMETER_TYPE_BYTE: convert_func(int8_t{});
+                break;
+            case TINYGLTF_PARAMETER_TYPE_UNSIGNED_BYTE: convert_func(uint8_t{});
+                break;
+            case TINYGLTF_PARAMETER_TYPE_SHORT: convert_func(int16_t{});
+                break;
+            case TINYGLTF_PARAMETER_TYPE_UNSIGNED_SHORT: convert_func(uint16_t{});
+                break;
+            case TINYGLTF_PARAMETER_TYPE_UNSIGNED_INT: convert_func(uint32_t{});
+                break;
+            default: throw std::runtime_error{"component type is not supported"};
+            }
+        }
+
+        //the accessor converted into vectors, components it does not have are zero
+        template<typename Vec>
+        vector<Vec> read_accessor(const gltf_model::model_source& source, const tinygltf::Accessor& accessor)
+        {
+            vector<Vec> values(accessor.count, Vec{0});
+            convert_accessor(
+                source,
+                accessor,
+                reinterpret_cast<unsigned char*>(values.data()),
+                sizeof(Vec),
+                Vec::length()
+            );
+            return values;
+        }
+
+        //just enough of a json reader to find the members rewritten before tinygltf parses the text,
+        //values are skipped by matching their brackets and no document is built
+        using json_span = pair<const char*, const char*>;
+
+        struct json_member
+        {
+            string_view key;
+            //from the opening quote of the key to the end of the value
+            json_span member;
+            json_span value;
+        };
+
+        [[noreturn]] void throw_malformed_json() { throw std::runtime_error{"gltf json is malformed"}; }
+
+        const char* skip_space(const char* it, const char* const end) noexcept
+        {
+            while(it != end && (*it == ' ' || *it == '\t' || *it == '\n' || *it == '\r')) ++it;
+            return it;
+        }
+
+        //from the opening quote to past the closing one
+        const char* skip_string(const char* it, const char* const end)
+        {
+            for(++it; it != end; ++it)
+                if(*it == '\\')
+                {
+                    if(++it == end) break;
+                }
+                else if(*it == '"') return it + 1;
+            throw_malformed_json();
+        }
+
+        const char* skip_value(const char* it, const char* const end)
+        {
+            if(it == end) throw_malformed_json();
+            if(*it == '"') return skip_string(it, end);
+            if(*it != '{' && *it != '[')
+            {
+                while(it != end && *it != ',' && *it != '}' && *it != ']' && *it != ' ' && *it != '\t' &&
+                    *it != '\n' && *it != '\r')
+                    ++it;
+                return it;
+            }
+
+            size_t depth = 0;
+            while(it != end)
+            {
+                if(*it == '"')
+                {
+                    it = skip_string(it, end);
+                    continue;
+                }
+                if(*it == '{' || *it == '[') ++depth;
+                else if((*it == '}' || *it == ']') && --depth == 0) return it + 1;
+                ++it;
+            }
+            throw_malformed_json();
+        }
+
+        //the values of an object or an array, members of an array have no key
+        vector<json_member> json_members(const json_span& container)
+        {
+            if(container.first == container.second || (*container.first != '{' && *container.first != '['))
+                throw_malformed_json();
+
+            const auto is_object = *container.first == '{';
+            const auto closing = is_object ? '}' : ']';
+
+            vector<json_member> members;
+            auto it = skip_space(container.first + 1, container.second);
+            if(it != container.second && *it == closing) return members;
+            while(it != container.second)
+            {
+                auto& member = members.emplace_back();
+                member.member.first = it;
+                if(is_object)
+                {
+                    const auto* const key_end = skip_string(it, container.second);
+                    member.key = {it + 1, static_cast<size_t>(key_end - it - 2)};
+                    it = skip_space(key_end, container.second);
+                    if(it == container.second || *it != ':') throw_malformed_json();
+                    it = skip_space(it + 1, container.second);
+                }
+                member.value = {it, skip_value(it, container.second)};
+                member.member.second = member.value.second;
+
+                it = skip_space(member.value.second, container.second);
+                if(it == container.second) break;
+                if(*it == closing) return members;
+                if(*it != ',') throw_malformed_json();
+                it = skip_space(it + 1, container.second);
+            }
+            throw_malformed_json();
+        }
+
+        const json_member* find_json_member(const vector<json_member>& members, const string_view& key) noexcept
+        {
+            const auto& it = std::find_if(
+                members.cbegin(),
+                members.cend(),
+                [&key](const json_member& member) { return member.key == key; }
+            );
+            return it != members.cend() ? &*it : nullptr;
+        }
+
+        //value at the path of keys through nested objects, empty if one of them is missing
+        json_span find_json_value(json_span container, const std::initializer_list<string_view> keys)
+        {
+            for(const auto& key : keys)
+            {
+                if(container.first == container.second || *container.first != '{') return {};
+
+                const auto& members = json_members(container);
+                const auto* const member = find_json_member(members, key);
+                if(!member) return {};
+                container = member->value;
+            }
+            return container;
+        }
+
+        //uris of the buffers are plain strings in practice, unicode escapes beyond ascii are kept as they are
+        string json_string(const json_span& value)
+        {
+            if(*value.first != '"') throw_malformed_json();
+
+            string text;
+            for(auto it = value.first + 1; it < value.second - 1; ++it)
+            {
+                if(*it != '\\')
+                {
+                    text.push_back(*it);
+                    continue;
+                }
+                switch(*++it)
+                {
+                case 'b': text.push_back('\b');
+                    break;
+                case 'f': text.push_back('\f');
+                    break;
+                case 'n': text.push_back('\n');
+                    break;
+                case 'r': text.push_back('\r');
+                    break;
+                case 't': text.push_back('\t');
+                    break;
+                case 'u':
+                    {
+                        unsigned code = 0;
+                        if(value.second - 1 - it < 5 || std::from_chars(it + 1, it + 5, code, 16).ptr != it + 5)
+                            throw_malformed_json();
+                        if(code < 0x80) text.push_back(static_cast<char>(code));
+                        else text.append(it - 1, it + 5);
+                        it += 4;
+                    }
+                    break;
+                default: text.push_back(*it);
+                }
+            }
+            return text;
+        }
+
+        template<typename T>
+        T json_integer(const json_span& value)
+        {
+            T integer{};
+            if(std::from_chars(value.first, value.second, integer).ptr != value.second) throw_malformed_json();
+            return integer;
+        }
+
+        //appends a copy of every split vertex and moves the corners given as pairs of an index position and
+        //its new vertex onto them, non-indexed primitives become indexed in vertex order first
+        void split_vertices(
+            gltf_model::primitive& target,
+            const pair<const uint32_t*, const uint32_t*>& duplicates,
+            const pair<const uint32_t*, const uint32_t*>& corners
+        )
+        {
+            if(duplicates.first == duplicates.second) return;
+
+            if(target.indices.empty())
+            {
+                target.indices.resize(target.vertices.size());
+                std::iota(target.indices.begin(), target.indices.end(), 0u);
+            }
+            for(auto it = duplicates.first; it != duplicates.second; ++it)
+            {
+                target.vertices.push_back(target.vertices[*it]);
+                if(!target.skin_vertices.empty()) target.skin_vertices.push_back(target.skin_vertices[*it]);
+            }
+            for(auto it = corners.first; it + 1 < corners.second; it += 2) target.indices[*it] = *(it + 1);
+        }
+    }
+
+    const unsigned char* gltf_model::model_source::data(const tinygltf::Accessor& accessor) const noexcept
+    {
+        if(const auto& decoded = decoded_views[accessor.bufferView]; !decoded.empty())
+            return decoded.data() + accessor.byteOffset;
+
+        const auto& buffer_view = model.bufferViews[accessor.bufferView];
+        return buffers[buffer_view.buffer].first + buffer_view.byteOffset + accessor.byteOffset;
+    }
+
+    sampler_object::info_type gltf_model::sampler::create_info() const noexcept
+    {
+        sampler_object::info_type info;
+        info.magFilter = mag_filter;
+        info.minFilter = min_filter;
+        info.mipmapMode = mipmap_mode;
+        info.addressModeU = address_mode_u;
+        info.addressModeV = address_mode_v;
+        info.addressModeW = address_mode_w;
+        info.maxLod = VK_LOD_CLAMP_NONE;
+        info.compareOp = CompareOp::eAlways;
+        info.borderColor = BorderColor::eIntOpaqueBlack;
+        return info;
+    }
+
+    gltf_model::texture::texture(
+        const tinygltf::Image& gltf_image,
+        shared_ptr<const tinygltf::Image* const> image,
+        shared_ptr<const sampler_object::info_type> sampler_create_info,
+        const struct sampler& sampler
+    ) noexcept:
+        //undecoded images have no size yet
+        extent(
+            static_cast<uint32_t>(std::max(gltf_image.width, 1)),
+            static_cast<uint32_t>(std::max(gltf_image.height, 1))
+        ),
         mip_levels(
             static_cast<uint32_t>(std::floor(std::log2(std::max(extent.width, extent.height))) + 1.0)
         ),
+        image(std::move(image)),
+        sampler_create_info(std::move(sampler_create_info)),
         sampler(sampler) {}
 
+    DeviceSize gltf_model::texture::size() const noexcept
+    {
+        return mip_level_texel_offset(Extent3D{extent.width, extent.height, 1}, mip_levels) *
+            sizeof(constant::format_t<format>);
+    }
+
     gltf_model::material::material(const tinygltf::Material& material, const vector<texture>& textures) noexcept
     {
         const auto get_texture_func = [&textures, &material](
@@ -142,171 +599,92 @@ namespace vulkan::utility
 
     void gltf_model::primitive::initialize_vertices(
         const tinygltf::Primitive& gltf_primitive,
-        const tinygltf::Model& gltf_model
+        const model_source& gltf_source
     )
     {
-        vector<decltype(vertex::position)> positions;
-        vector<decltype(vertex::normal)> normals;
-        vector<decltype(vertex::uv0)> uv0_s;
-        vector<decltype(vertex::uv1)> uv1_s;
-        vector<decltype(vertex::joint)> joints;
-        vector<decltype(vertex::weight)> weights;
-
+        const auto find_accessor_func = [&gltf_primitive, &gltf_source](const string& name)
         {
-            const auto& iterator = gltf_primitive.attributes.find("POSITION");
-            if(iterator != gltf_primitive.attributes.cend())
-            {
-                const auto& accessor = gltf_model.accessors[iterator->second];
-                bounding = {make_vec3(accessor.minValues.data()), make_vec3(accessor.maxValues.data())};
-            }
-        }
-
-
-        const auto get_value_ptr_func = [&gltf_model,&gltf_primitive](const size_t type_size, const string& str)
-        {
-            const auto& iterator = gltf_primitive.attributes.find(str);
-            if(iterator != gltf_primitive.attributes.cend())
-            {
-                const auto& accessor = gltf_model.accessors[iterator->second];
-                const auto& buffer_view = gltf_model.bufferViews[accessor.bufferView];
-                const auto ptr = &gltf_model.buffers[buffer_view.buffer]
-                    .data[accessor.byteOffset + buffer_view.byteOffset];
-
-                const auto component_size_in_bytes =
-                    tinygltf::GetComponentSizeInBytes(accessor.componentType);
-                if(component_size_in_bytes <= 0) throw std::runtime_error{"component type is not supported"};
-
-                size_t stride;
-
-                if(buffer_view.byteStride)
-                {
-                    const auto type_size_in_bytes = tinygltf::GetTypeSizeInBytes(accessor.type);
-                    if(type_size_in_bytes <= 0) throw std::runtime_error{"type is not supported"};
-                    stride = component_size_in_bytes * type_size_in_bytes;
-                }
-                else if(buffer_view.byteStride % component_size_in_bytes != 0)
-                    throw std::runtime_error{"stride is not aligned"};
-                else stride = buffer_view.byteStride;
-
-
-                return pair{ptr, ptr + accessor.count * type_size} | boost::adaptors::strided(stride);
-            }
-            return boost::strided_range<const pair<
-                decltype(gltf_model.buffers.front().data)::const_pointer,
-                decltype(gltf_model.buffers.front().data)::const_pointer>>{0, pair{nullptr, nullptr}};
+            const auto& iterator = gltf_primitive.attributes.find(name);
+            return iterator != gltf_primitive.attributes.cend() ?
+                &gltf_source.model.accessors[iterator->second] :
+                nullptr;
         };
+        const auto position_accessor = find_accessor_func("POSITION");
+        const auto normal_accessor = find_accessor_func("NORMAL");
+        const auto uv0_accessor = find_accessor_func("TEXCOORD_0");
+        const auto uv1_accessor = find_accessor_func("TEXCOORD_1");
+        const auto joint_accessor = find_accessor_func("JOINTS_0");
+        const auto weight_accessor = find_accessor_func("WEIGHTS_0");
+        const auto tangent_accessor = find_accessor_func("TANGENT");
 
-        {
-            const auto& strided_range =
-                get_value_ptr_func(sizeof(decltype(positions)::value_type), "POSITION");
-            positions = {
-                reinterpret_cast<decltype(positions)::const_pointer>(&*strided_range.begin()),
-                reinterpret_cast<decltype(positions)::const_pointer>(&*strided_range.end())
-            };
-        }
+        size_t count = 0;
+        for(const auto accessor : {
+                position_accessor,
+                normal_accessor,
+                uv0_accessor,
+                uv1_accessor,
+                joint_accessor,
+                weight_accessor,
+                tangent_accessor
+            })
+            if(accessor != nullptr) count = std::max(count, accessor->count);
+        if(count == 0) return;
 
+        //every attribute is converted straight into its member of the interleaved vertices,
+        //vertices an attribute does not reach keep zero there
+        const auto convert_func = [&gltf_source](
+            const tinygltf::Accessor* const accessor,
+            auto& elements,
+            const auto member
+        )
         {
-            const auto& strided_range = get_value_ptr_func(sizeof(decltype(normals)::value_type), "NORMAL");
-            normals = {
-                reinterpret_cast<decltype(normals)::const_pointer>(&*strided_range.begin()),
-                reinterpret_cast<decltype(normals)::const_pointer>(&*strided_range.end())
-            };
-        }
+            if(accessor == nullptr) return;
+            convert_accessor(
+                gltf_source,
+                *accessor,
+                reinterpret_cast<unsigned char*>(&(elements.front().*member)),
+                sizeof(elements.front()),
+                std::decay_t<decltype(elements.front().*member)>::length()
+            );
+        };
 
-        {
-            const auto& strided_range = get_value_ptr_func(sizeof(decltype(uv0_s)::value_type), "TEXCOORD_0");
-            uv0_s = {
-                reinterpret_cast<decltype(uv0_s)::const_pointer>(&*strided_range.begin()),
-                reinterpret_cast<decltype(uv0_s)::const_pointer>(&*strided_range.end())
-            };
-        }
+        vertices.assign(count, {vec3{0}, vec3{0}, vec2{0}, vec2{0}, vec4{0}});
+        convert_func(position_accessor, vertices, &vertex::position);
+        convert_func(normal_accessor, vertices, &vertex::normal);
+        convert_func(uv0_accessor, vertices, &vertex::uv0);
+        convert_func(uv1_accessor, vertices, &vertex::uv1);
+        convert_func(tangent_accessor, vertices, &vertex::tangent);
 
+        if(joint_accessor != nullptr || weight_accessor != nullptr)
         {
-            const auto& strided_range = get_value_ptr_func(sizeof(decltype(uv1_s)::value_type), "TEXCOORD_1");
-            uv1_s = {
-                reinterpret_cast<decltype(uv1_s)::const_pointer>(&*strided_range.begin()),
-                reinterpret_cast<decltype(uv1_s)::const_pointer>(&*strided_range.end())
-            };
+            skin_vertices.assign(count, {vec4{0}, vec4{0}});
+            convert_func(joint_accessor, skin_vertices, &skin_vertex::joint);
+            convert_func(weight_accessor, skin_vertices, &skin_vertex::weight);
         }
 
-        {
-            const auto& strided_range = get_value_ptr_func(sizeof(decltype(joints)::value_type), "JOINTS_0");
-            joints = {
-                reinterpret_cast<decltype(joints)::const_pointer>(&*strided_range.begin()),
-                reinterpret_cast<decltype(joints)::const_pointer>(&*strided_range.end())
-            };
-        }
+        if(position_accessor == nullptr) return;
 
+        //accessor bounds of normalized positions may be given unnormalized, so they are taken from the data
+        if(const auto& accessor = *position_accessor;
+            !accessor.normalized && accessor.minValues.size() >= 3 && accessor.maxValues.size() >= 3)
+            bounding = {make_vec3(accessor.minValues.data()), make_vec3(accessor.maxValues.data())};
+        else
         {
-            const auto& strided_range = get_value_ptr_func(sizeof(decltype(weights)::value_type), "WEIGHTS_0");
-            weights = {
-                reinterpret_cast<decltype(weights)::const_pointer>(&*strided_range.begin()),
-                reinterpret_cast<decltype(weights)::const_pointer>(&*strided_range.end())
-            };
+            bounding = {vertices.front().position, vertices.front().position};
+            for(const auto& item : vertices)
+                bounding = {min(bounding.first, item.position), max(bounding.second, item.position)};
         }
-
-        {
-            const auto sizes = {
-                positions.size(),
-                normals.size(),
-                uv0_s.size(),
-                uv1_s.size(),
-                joints.size(),
-                weights.size(),
-            };
-            const auto max_size = *std::max_element(sizes.begin(), sizes.end());
-            positions.resize(max_size);
-            normals.resize(max_size);
-            uv0_s.resize(max_size);
-            uv1_s.resize(max_size);
-            joints.resize(max_size);
-            weights.resize(max_size);
-            vertices.resize(max_size);
-        }
-
-
-        ::utility::for_each(
-            [](
-            decltype(vertices)::reference vertex,
-            decltype(positions)::reference position,
-            decltype(normals)::reference normal,
-            decltype(uv0_s)::reference uv0,
-            decltype(uv1_s)::reference uv1,
-            decltype(joints)::reference joint,
-            decltype(weights)::reference weight
-        )
-            {
-                vertex = {
-                    position,
-                    normal,
-                    uv0,
-                    uv1,
-                    joint,
-                    weight
-                };
-            },
-            vertices.begin(),
-            vertices.end(),
-            positions.begin(),
-            normals.begin(),
-            uv0_s.begin(),
-            uv1_s.begin(),
-            joints.begin(),
-            weights.begin()
-        );
     }
 
     void gltf_model::primitive::initialize_indices(
         const tinygltf::Primitive& gltf_primitive,
-        const tinygltf::Model& gltf_model
+        const model_source& gltf_source
     )
     {
         if(gltf_primitive.indices == -1) return;
 
-        const auto& accessor = gltf_model.accessors[gltf_primitive.indices];
-        const auto& buffer_view = gltf_model.bufferViews[accessor.bufferView];
-        const auto& buffer = gltf_model.buffers[buffer_view.buffer].data;
-        const auto& buffer_valid_ptr = &buffer[accessor.byteOffset + buffer_view.byteOffset];
+        const auto& accessor = gltf_source.model.accessors[gltf_primitive.indices];
+        const auto buffer_valid_ptr = gltf_source.data(accessor);
 
         switch(accessor.componentType)
         {
@@ -332,15 +710,40 @@ namespace vulkan::utility
         }
     }
 
-    gltf_model::primitive::primitive(
-        const tinygltf::Primitive& gltf_primitive,
-        struct material material,
-        const tinygltf::Model& gltf_model
-    ):
-        material(std::move(material))
+    void gltf_model::primitive::optimize()
+    {
+        if(indices.empty()) return;
+
+        //triangles go in post-transform cache and overdraw order, then the vertices in the order they are fetched
+        auto* const indices_begin = indices.data();
+        auto* const indices_end = indices_begin + indices.size();
+        average_cache_miss_ratios.first = average_cache_miss_ratio(indices_begin, indices_end);
+        optimize_overdraw(
+            indices_begin,
+            indices_end,
+            optimize_vertex_cache(indices_begin, indices_end, vertices.size()),
+            [this](const uint32_t index) { return vertices[index].position; }
+        );
+        average_cache_miss_ratios.second = average_cache_miss_ratio(indices_begin, indices_end);
+
+        const auto& remap = optimize_vertex_fetch(indices_begin, indices_end, vertices.size());
+        vector<vertex> reordered(vertices.size());
+        for(size_t i = 0; i < vertices.size(); ++i) reordered[remap[i]] = vertices[i];
+        vertices = std::move(reordered);
+        if(!skin_vertices.empty())
+        {
+            vector<skin_vertex> reordered_skin(skin_vertices.size());
+            for(size_t i = 0; i < skin_vertices.size(); ++i) reordered_skin[remap[i]] = skin_vertices[i];
+            skin_vertices = std::move(reordered_skin);
+        }
+    }
+
+    gltf_model::primitive::primitive(const tinygltf::Primitive& gltf_primitive, const model_source& gltf_source):
+        material_index(gltf_primitive.material)
     {
-        initialize_vertices(gltf_primitive, gltf_model);
-        initialize_indices(gltf_primitive, gltf_model);
+        initialize_vertices(gltf_primitive, gltf_source);
+        initialize_indices(gltf_primitive, gltf_source);
+        optimize();
     }
 
     pair<vec3, vec3> gltf_model::mesh::get_bounding() const
@@ -365,21 +768,13 @@ namespace vulkan::utility
         };
     }
 
-    gltf_model::mesh::mesh(
-        const tinygltf::Mesh& gltf_mesh,
-        const tinygltf::Model& model,
-        vector<material> materials
-    ):
+    gltf_model::mesh::mesh(const tinygltf::Mesh& gltf_mesh, const model_source& gltf_source):
         primitives(
             ::utility::container_transform<decltype(primitives)>(
                 gltf_mesh.primitives,
-                [&model, &materials](decltype(gltf_mesh.primitives)::const_reference gltf_primitive)
+                [&gltf_source](decltype(gltf_mesh.primitives)::const_reference gltf_primitive)
                 {
-                    return primitive{
-                        gltf_primitive,
-                        std::move(gltf_primitive.material > -1 ? materials[gltf_primitive.material] : material{}),
-                        model
-                    };
+                    return primitive{gltf_primitive, gltf_source};
                 }
             )
         ) {}
@@ -388,116 +783,338 @@ namespace vulkan::utility
 
     gltf_model::skin::skin(
         const tinygltf::Skin& skin,
-        const optional<tuple<
-            const tinygltf::Accessor*,
-            const tinygltf::BufferView*,
-            const tinygltf::Buffer*>>& matrices_tuple
+        const optional<pair<const tinygltf::Accessor*, const unsigned char*>>& matrices
     ) noexcept :
         name(skin.name),
-        skeleton_index_(skin.skeleton)
+        skeleton(skin.skeleton),
+        joints(skin.joints)
     {
-        if(matrices_tuple)
+        if(matrices)
         {
-            const auto begin_ptr = reinterpret_cast<decltype(inverse_bind_matrices)::const_pointer>(
-                &std::get<2>(*matrices_tuple)->data[std::get<0>(*matrices_tuple)->byteOffset + std::get<1>(
-                    *matrices_tuple
-                )->byteOffset]
-            );
-            inverse_bind_matrices = decltype(inverse_bind_matrices){
-                begin_ptr,
-                begin_ptr + std::get<0>(*matrices_tuple)->count
-            };
+            const auto begin_ptr = reinterpret_cast<decltype(inverse_bind_matrices)::const_pointer>(matrices->second);
+            inverse_bind_matrices = decltype(inverse_bind_matrices){begin_ptr, begin_ptr + matrices->first->count};
         }
     }
 
-    void gltf_model::skin::locate_skeleton(vector<node*>& linear_nodes) { skeleton = linear_nodes[skeleton_index_]; }
-
-    gltf_model::node::node(
-        const int index,
-        node* parent,
-        vector<struct skin> skins,
-        const tinygltf::Node& gltf_node,
-        const tinygltf::Model& gltf_model,
-        vector<material> materials,
-        vector<node*>& linear_nodes
-    ):
-        index(index),
-        name(gltf_node.name),
-        skin(std::move(skins[gltf_node.skin])),
-        translation(
-            gltf_node.translation.size() == 3 ?
-            make_vec3(reinterpret_cast<const decltype(translation)::value_type*>(gltf_node.translation.data())) :
-            decltype(translation){}
-        ),
-        rotation(
-            gltf_node.rotation.size() == 3 ?
-            make_vec3(reinterpret_cast<const decltype(rotation)::value_type*>(gltf_node.rotation.data())) :
-            decltype(rotation){}
-        ),
-        scale(
-            gltf_node.scale.size() == 3 ?
-            make_vec3(reinterpret_cast<const decltype(scale)::value_type*>(gltf_node.scale.data())) :
-            decltype(scale){}
-        ),
-        matrix(
-            gltf_node.matrix.size() == 16 ?
-            make_mat4(reinterpret_cast<const decltype(matrix)::value_type*>(gltf_node.matrix.data())) :
-            decltype(matrix){1}
-        ),
-        mesh({gltf_model.meshes[gltf_node.mesh], gltf_model, std::move(materials)}),
-        parent(parent),
-        children(
-            ::utility::container_transform<decltype(children)>(
-                gltf_node.children,
-                [this, &gltf_model, &materials, &skins, &linear_nodes](
-                const decltype(gltf_node.children)::value_type node_index
-            )
+    void gltf_model::skin::locate_nodes(const vector<int>& node_positions)
+    {
+        if(skeleton > -1) skeleton = node_positions[skeleton];
+        for(auto& joint : joints) joint = node_positions[joint];
+    }
+
+    size_t gltf_model::node_table::size() const noexcept { return indices.size(); }
+
+    void gltf_model::node_table::push_back(const tinygltf::Node& gltf_node, const int index, const int parent)
+    {
+        indices.push_back(index);
+        parents.push_back(parent);
+        names.push_back(gltf_node.name);
+        translations.push_back(
+            gltf_node.translation.size() == 3 ? vec3{make_vec3(gltf_node.translation.data())} : vec3{}
+        );
+        rotations.push_back(
+            gltf_node.rotation.size() == 4 ?
+            quat{
+                static_cast<float>(gltf_node.rotation[3]),
+                static_cast<float>(gltf_node.rotation[0]),
+                static_cast<float>(gltf_node.rotation[1]),
+                static_cast<float>(gltf_node.rotation[2])
+            } :
+            quat{1, 0, 0, 0}
+        );
+        scales.push_back(gltf_node.scale.size() == 3 ? vec3{make_vec3(gltf_node.scale.data())} : vec3{1});
+        matrices.push_back(gltf_node.matrix.size() == 16 ? mat4{make_mat4(gltf_node.matrix.data())} : mat4{1});
+        meshes.push_back(gltf_node.mesh);
+        skins.push_back(gltf_node.skin);
+    }
+
+    void gltf_model::node_table::link_subtrees()
+    {
+        //walking backwards every child is final before it extends its parent
+        subtree_ends.resize(size());
+        for(auto i = size(); i-- > 0;)
+        {
+            subtree_ends[i] = std::max(subtree_ends[i], i + 1);
+            if(parents[i] > -1) subtree_ends[parents[i]] = std::max(subtree_ends[parents[i]], subtree_ends[i]);
+        }
+
+        world_matrices.resize(size());
+        dirty.assign(size(), true);
+        dirty_ranges = {{0, size()}};
+    }
+
+    mat4 gltf_model::node_table::local_matrix(const size_t i) const noexcept
+    {
+        //translation * rotation * scale written out, the rotation columns are only scaled
+        auto local = mat4_cast(rotations[i]);
+        local[0] *= scales[i].x;
+        local[1] *= scales[i].y;
+        local[2] *= scales[i].z;
+        local[3] = vec4{translations[i], 1};
+        return multiply(local, matrices[i]);
+    }
+
+    void gltf_model::node_table::set_local_transform(
+        const size_t i,
+        const vec3& translation,
+        const quat& rotation,
+        const vec3& scale
+    )
+    {
+        translations[i] = translation;
+        rotations[i] = rotation;
+        scales[i] = scale;
+        matrices[i] = mat4{1};
+        mark_dirty(i);
+    }
+
+    void gltf_model::node_table::mark_dirty(const size_t i)
+    {
+        dirty[i] = true;
+
+        //the subtree swallows the ranges it overlaps or touches, the others are kept apart
+        pair range{i, subtree_ends[i]};
+        auto first = std::lower_bound(
+            dirty_ranges.begin(),
+            dirty_ranges.end(),
+            range.first,
+            [](const pair<size_t, size_t>& current, const size_t position) { return current.second < position; }
+        );
+        auto last = first;
+        for(; last != dirty_ranges.end() && last->first <= range.second; ++last)
+            range = {std::min(range.first, last->first), std::max(range.second, last->second)};
+        dirty_ranges.insert(dirty_ranges.erase(first, last), range);
+    }
+
+    vector<pair<size_t, size_t>> gltf_model::node_table::update_world_matrices()
+    {
+        //a node is recomputed when it or its parent was, a parent before its range was left untouched
+        for(const auto& [first, last] : dirty_ranges)
+            for(auto i = first; i < last; ++i)
+            {
+                const auto parent = parents[i];
+                if(!dirty[i] && (parent < 0 || !dirty[parent])) continue;
+
+                dirty[i] = true;
+                world_matrices[i] = parent > -1 ? multiply(world_matrices[parent], local_matrix(i)) : local_matrix(i);
+            }
+        for(const auto& [first, last] : dirty_ranges) std::fill(dirty.begin() + first, dirty.begin() + last, false);
+        return std::exchange(dirty_ranges, {});
+    }
+
+    gltf_model::gltf_model(const path& model_path) :
+        file_(model_path.string().c_str(), boost::interprocess::read_only),
+        region_(file_, boost::interprocess::read_only)
+    {
+        const auto* const file_begin = static_cast<const unsigned char*>(region_.get_address());
+        const auto& [json, binary_chunk] = split_chunks({file_begin, file_begin + region_.get_size()});
+
+        //buffers are resolved to views of the mapped files and swapped for one byte placeholders in the text,
+        //so tinygltf parses the json once and never copies the mesh data
+        static constexpr string_view placeholder_uri = "\"data:application/octet-stream;base64,AA==\"";
+        const json_span document{skip_space(json.first, json.second), json.second};
+        if(document.first == document.second || *document.first != '{') throw_malformed_json();
+        const auto& top_members = json_members(document);
+
+        //spans of the text replaced when it is handed to tinygltf
+        vector<pair<json_span, string>> replacements;
+        const auto& replace_buffer = [&replacements](const vector<json_member>& buffer)
+        {
+            const auto* const byte_length = find_json_member(buffer, "byteLength");
+            if(!byte_length) throw std::runtime_error{"gltf buffer has no byte length"};
+            if(const auto* const uri = find_json_member(buffer, "uri"))
+            {
+                replacements.emplace_back(uri->value, placeholder_uri);
+                replacements.emplace_back(byte_length->value, "1");
+            }
+            else replacements.emplace_back(byte_length->value, "1,\"uri\":" + string{placeholder_uri});
+        };
+
+        if(const auto* const buffers = find_json_member(top_members, "buffers"))
+            for(const auto& element : json_members(buffers->value))
+            {
+                const auto& buffer = json_members(element.value);
+                const auto* const uri_member = find_json_member(buffer, "uri");
+                const auto& uri = uri_member ? json_string(uri_member->value) : string{};
+
+                //data uris have to be decoded anyway, tinygltf keeps them
+                if(uri.rfind("data:", 0) == 0)
                 {
-                    return node{
-                        node_index,
-                        this,
-                        std::move(skins),
-                        gltf_model.nodes[node_index],
-                        gltf_model,
-                        materials,
-                        linear_nodes
+                    buffers_.emplace_back(nullptr, nullptr);
+                    continue;
+                }
+
+                //fallback buffers of EXT_meshopt_compression usually have no data, only decoded views are read
+                const auto& fallback = find_json_value(
+                    element.value,
+                    {"extensions", "EXT_meshopt_compression", "fallback"}
+                );
+                if(string_view{fallback.first, static_cast<size_t>(fallback.second - fallback.first)} == "true")
+                {
+                    buffers_.emplace_back(nullptr, nullptr);
+                    replace_buffer(buffer);
+                    continue;
+                }
+
+                auto data = binary_chunk;
+                if(!uri.empty())
+                {
+                    auto& [file, region] = buffer_files_.emplace_back();
+                    file = boost::interprocess::file_mapping{
+                        (model_path.parent_path() / path{uri}).string().c_str(),
+                        boost::interprocess::read_only
                     };
+                    region = boost::interprocess::mapped_region{file, boost::interprocess::read_only};
+                    const auto* const begin = static_cast<const unsigned char*>(region.get_address());
+                    data = {begin, begin + region.get_size()};
                 }
-            )
-        ) { linear_nodes.push_back(this); }
 
-    gltf_model::gltf_model(const path& model_path)
-    {
+                const auto* const byte_length_member = find_json_member(buffer, "byteLength");
+                const auto byte_length = byte_length_member ? json_integer<size_t>(byte_length_member->value) : 0;
+                if(static_cast<size_t>(data.second - data.first) < byte_length)
+                    throw std::runtime_error{"gltf buffer is out of its data range: " + model_path.string()};
+
+                buffers_.emplace_back(data.first, data.first + byte_length);
+                replace_buffer(buffer);
+            }
+
+        //images in buffer views would make tinygltf read the placeholders, their views are restored after loading
+        vector<tuple<size_t, int, string>> image_buffer_views;
+        if(const auto* const images = find_json_member(top_members, "images"))
+        {
+            const auto& elements = json_members(images->value);
+            for(size_t i = 0; i < elements.size(); ++i)
+            {
+                const auto& image = json_members(elements[i].value);
+                if(const auto* const buffer_view = find_json_member(image, "bufferView"))
+                {
+                    const auto* const mime_type = find_json_member(image, "mimeType");
+                    image_buffer_views.emplace_back(
+                        i,
+                        json_integer<int>(buffer_view->value),
+                        mime_type ? json_string(mime_type->value) : string{}
+                    );
+                    replacements.emplace_back(buffer_view->member, "\"uri\":" + string{placeholder_uri});
+                }
+            }
+        }
+
         {
+            std::sort(
+                replacements.begin(),
+                replacements.end(),
+                [](const auto& left, const auto& right) { return left.first.first < right.first.first; }
+            );
+            string json_text;
+            json_text.reserve(static_cast<size_t>(json.second - json.first));
+            auto copied = json.first;
+            for(const auto& [span, text] : replacements)
+            {
+                json_text.append(copied, span.first);
+                json_text += text;
+                copied = span.second;
+            }
+            json_text.append(copied, json.second);
+
             tinygltf::TinyGLTF context;
+            //images are decoded from their files by the texture pipeline, loading only keeps their references
+            context.SetImageLoader(
+                [](tinygltf::Image*, const int, string*, string*, int, int, const unsigned char*, int, void*)
+                {
+                    return true;
+                },
+                nullptr
+            );
             pair<std::string, std::string> msg;
-            if(context.LoadASCIIFromFile(
+            if(!context.LoadASCIIFromString(
                 &model_,
                 &msg.first,
                 &msg.second,
-                model_path.generic_u8string()
+                json_text.c_str(),
+                static_cast<unsigned>(json_text.size()),
+                model_path.parent_path().generic_u8string()
             ))
                 throw std::runtime_error{
                     "failed to load gltf model :" + model_path.string() + "\n" + msg.first + "\n" + msg.second
                 };
+        }
 
-            linear_nodes_.reserve(model_.nodes.size());
+        for(const auto& [index, buffer_view, mime_type] : image_buffer_views)
+        {
+            auto& image = model_.images[index];
+            image.uri.clear();
+            image.bufferView = buffer_view;
+            image.mimeType = mime_type;
         }
 
+        for(size_t i = 0; i < buffers_.size(); ++i)
+            if(buffers_[i].first == nullptr)
+            {
+                const auto& data = model_.buffers[i].data;
+                buffers_[i] = {data.data(), data.data() + data.size()};
+            }
+
+        content_hash_ = xxhash64(region_.get_address(), region_.get_size());
+        for(const auto& [begin, end] : buffers_)
+            content_hash_ = xxhash64(begin, static_cast<size_t>(end - begin), content_hash_);
+
+        //compressed views are decoded up front, each on its own thread
+        decoded_views_.resize(model_.bufferViews.size());
+        {
+            vector<size_t> compressed_views;
+            for(size_t i = 0; i < model_.bufferViews.size(); ++i)
+                if(model_.bufferViews[i].extensions.count("EXT_meshopt_compression") != 0)
+                    compressed_views.push_back(i);
+
+            if(!compressed_views.empty())
+            {
+                const auto thread_count = static_cast<size_t>(std::thread::hardware_concurrency());
+                ::utility::thread_pool pool{std::clamp(thread_count, size_t{1}, compressed_views.size())};
+                vector<std::future<void>> decodings;
+                decodings.reserve(compressed_views.size());
+                for(const auto view : compressed_views)
+                    decodings.push_back(pool.submit([this, view] { decode_view(view); }));
+                for(auto& decoding : decodings) decoding.get();
+            }
+        }
+
+        const model_source source{model_, buffers_, decoded_views_};
+
+        //textures referencing identical images or sampler states share them instead of creating copies
         const auto& textures = ::utility::container_transform<vector<texture>>(
             model_.textures,
             [this](decltype(model_.textures)::const_reference gltf_texture)
             {
-                return gltf_texture.sampler != -1 ?
-                    texture{
-                        model_.images[gltf_texture.source],
-                        model_.samplers[gltf_texture.sampler]
-                    } :
-                    texture{model_.images[gltf_texture.source]};
+                const auto& gltf_image = model_.images[gltf_texture.source];
+                const auto& gltf_sampler = gltf_texture.sampler != -1 ?
+                    sampler{model_.samplers[gltf_texture.sampler]} :
+                    sampler{};
+                const auto& sampler_create_info = gltf_sampler.create_info();
+
+                texture interned{gltf_image, nullptr, nullptr, gltf_sampler};
+                interned.image = image_interner_.intern(
+                    image_hash(gltf_image),
+                    interned.size(),
+                    [&gltf_image] { return &gltf_image; },
+                    [&gltf_image](const tinygltf::Image* const image) { return is_same_image(*image, gltf_image); }
+                );
+                interned.sampler_create_info = sampler_interner_.intern(
+                    sampler_hash(sampler_create_info),
+                    0,
+                    [&sampler_create_info] { return sampler_create_info; },
+                    [&sampler_create_info](const sampler_object::info_type& info) { return info == sampler_create_info; }
+                );
+                return interned;
             }
         );
 
-        const auto materials = ::utility::container_transform<vector<material>>(
+        if constexpr(is_debug)
+            std::cout << "gltf textures: " << image_interner_.get_statistics().unique << " unique images of " <<
+                image_interner_.get_statistics().requests << ", " << sampler_interner_.get_statistics().unique <<
+                " unique samplers of " << sampler_interner_.get_statistics().requests << ", " <<
+                image_interner_.get_statistics().saved_bytes << " bytes saved\n";
+
+        materials_ = ::utility::container_transform<vector<material>>(
             model_.materials,
             [&textures](decltype(model_.materials)::const_reference gltf_material)
             {
@@ -507,68 +1124,518 @@ namespace vulkan::utility
 
         const auto& default_scene = model_.scenes[model_.defaultScene > -1 ? model_.defaultScene : 0];
 
-        auto&& skins = ::utility::container_transform<vector<skin>>(
+        skins_ = ::utility::container_transform<vector<skin>>(
             model_.skins,
-            [this](decltype(model_.skins)::const_reference gltf_skin)
+            [this, &source](decltype(model_.skins)::const_reference gltf_skin)
             {
                 if(gltf_skin.inverseBindMatrices > -1)
                 {
                     const auto& accessor = model_.accessors[gltf_skin.inverseBindMatrices];
-                    const auto& buffer_view = model_.bufferViews[accessor.bufferView];
-                    const auto& buffer = model_.buffers[buffer_view.buffer];
-
-                    return skin{gltf_skin, {{&accessor, &buffer_view, &buffer}}};
+                    return skin{gltf_skin, {{&accessor, source.data(accessor)}}};
                 }
                 return skin{gltf_skin};
             }
         );
 
-        const auto node_roots = ::utility::container_transform<vector<node>>(
-            default_scene.nodes,
-            [this, &materials, &skins](const decltype(default_scene.nodes)::value_type node_index)
-            {
-                return node{
-                    node_index,
-                    nullptr,
-                    std::move(skins),
-                    model_.nodes[node_index],
-                    model_,
-                    materials,
-                    linear_nodes_
-                };
+        //the default scene is flattened depth first in one pass, each pending node carries the position of its
+        //parent, a node that was already placed is skipped so a malformed hierarchy can not loop
+        vector<int> node_positions(model_.nodes.size(), -1);
+        {
+            vector<pair<int, int>> pending;
+            pending.reserve(model_.nodes.size());
+            for(auto it = default_scene.nodes.crbegin(); it != default_scene.nodes.crend(); ++it)
+                pending.emplace_back(*it, -1);
+            while(!pending.empty())
+            {
+                const auto [node_index, parent] = pending.back();
+                pending.pop_back();
+                if(node_positions[node_index] > -1) continue;
+
+                const auto& gltf_node = model_.nodes[node_index];
+                const auto position = static_cast<int>(nodes_.size());
+                node_positions[node_index] = position;
+                nodes_.push_back(gltf_node, node_index, parent);
+                for(auto it = gltf_node.children.crbegin(); it != gltf_node.children.crend(); ++it)
+                    pending.emplace_back(*it, position);
             }
+        }
+        nodes_.link_subtrees();
+
+        //the scene starts in the pose of its animations at time zero
+        initialize_animations(source, node_positions);
+        {
+            using namespace ::utility::time;
+            const auto& sample_start = steady_clock_timer();
+            animate(0);
+            if constexpr(is_debug)
+                std::cout << "gltf animation: " << animations_.size() << " tracks on " <<
+                    animations_.timeline_count() << " timelines of " << animations_.animation_count() <<
+                    " animations sampled in " <<
+                    duration_cast<microseconds>(steady_clock_timer() - sample_start).count() <<
+                    "us\n";
+        }
+        nodes_.update_world_matrices();
+
+        for(auto& skin : skins_) skin.locate_nodes(node_positions);
+
+        //nodes instancing the same mesh share it, so every mesh is loaded once
+        vector<bool> is_mesh_used(model_.meshes.size(), false);
+        for(const auto mesh_index : nodes_.meshes)
+            if(mesh_index > -1) is_mesh_used[mesh_index] = true;
+        meshes_.resize(model_.meshes.size());
+        for(size_t i = 0; i < meshes_.size(); ++i)
+            if(is_mesh_used[i]) meshes_[i] = mesh{model_.meshes[i], source};
+        initialize_tangents(model_path);
+
+        node_draws_.reserve(nodes_.size() + 1);
+        node_draws_.push_back(0);
+        for(const auto mesh_index : nodes_.meshes)
+            node_draws_.push_back(node_draws_.back() + (mesh_index > -1 ? meshes_[mesh_index].primitives.size() : 0));
+
+        draw_bvh_ = bvh{
+            ::utility::container_transform<vector<pair<vec3, vec3>>>(
+                get_draws(),
+                [](const draw& scene_draw)
+                {
+                    return transform_bounds(scene_draw.world_matrix, scene_draw.mesh_primitive->bounding);
+                }
+            )
+        };
+
+        if constexpr(is_debug)
+        {
+            pair<float, float> average_cache_miss_ratios{};
+            size_t triangle_count = 0;
+            for(const auto& draw : get_draws())
+            {
+                const auto primitive_triangle_count = draw.mesh_primitive->indices.size() / 3;
+                average_cache_miss_ratios.first +=
+                    draw.mesh_primitive->average_cache_miss_ratios.first * static_cast<float>(primitive_triangle_count);
+                average_cache_miss_ratios.second +=
+                    draw.mesh_primitive->average_cache_miss_ratios.second * static_cast<float>(primitive_triangle_count);
+                triangle_count += primitive_triangle_count;
+            }
+            const auto divisor = static_cast<float>(std::max(triangle_count, size_t{1}));
+            std::cout << "gltf vertex cache: acmr " << average_cache_miss_ratios.first / divisor << " -> " <<
+                average_cache_miss_ratios.second / divisor << '\n';
+        }
+    }
+
+    auto gltf_model::split_chunks(const buffer_data& file) -> pair<pair<const char*, const char*>, buffer_data>
+    {
+        static constexpr uint32_t glb_magic = 0x46546c67;
+        static constexpr uint32_t glb_version = 2;
+        static constexpr uint32_t json_chunk_type = 0x4e4f534a;
+        static constexpr uint32_t binary_chunk_type = 0x004e4942;
+        static constexpr size_t header_size = 12;
+        static constexpr size_t chunk_header_size = 8;
+
+        const auto read = [&file](const size_t offset)
+        {
+            uint32_t value;
+            std::memcpy(&value, file.first + offset, sizeof(value));
+            return value;
+        };
+
+        const auto size = static_cast<size_t>(file.second - file.first);
+        const auto* const text = reinterpret_cast<const char*>(file.first);
+        if(size < header_size || read(0) != glb_magic) return {{text, text + size}, {}};
+
+        //the header holds the magic, version and length, every chunk starts with its length and type
+        if(read(4) != glb_version) throw std::runtime_error{"glb version is not supported"};
+        const auto length = std::min<size_t>(read(8), size);
+
+        pair<const char*, const char*> json{};
+        buffer_data binary{};
+        for(size_t offset = header_size; offset + chunk_header_size <= length;)
+        {
+            const size_t chunk_length = read(offset);
+            const auto chunk_type = read(offset + 4);
+            const auto* const begin = file.first + offset + chunk_header_size;
+            if(offset + chunk_header_size + chunk_length > length)
+                throw std::runtime_error{"glb chunk is out of range"};
+
+            if(chunk_type == json_chunk_type && !json.first)
+                json = {reinterpret_cast<const char*>(begin), reinterpret_cast<const char*>(begin + chunk_length)};
+            else if(chunk_type == binary_chunk_type && !binary.first) binary = {begin, begin + chunk_length};
+            offset += chunk_header_size + chunk_length;
+        }
+        if(!json.first) throw std::runtime_error{"glb has no json chunk"};
+        return {json, binary};
+    }
 
+    uint64_t gltf_model::image_hash(const tinygltf::Image& image) noexcept
+    {
+        auto hash = xxhash64_object(array<int, 4>{image.width, image.height, image.component, image.bits});
+
+        //images left undecoded are identified by their source instead of their pixels
+        if(image.image.empty())
+            return hash_combine(
+                hash_combine(hash, xxhash64(image.uri.data(), image.uri.size())),
+                xxhash64_object(image.bufferView)
+            );
+        return xxhash64(image.image.data(), image.image.size(), hash);
+    }
+
+    bool gltf_model::is_same_image(const tinygltf::Image& left, const tinygltf::Image& right) noexcept
+    {
+        return left.width == right.width &&
+            left.height == right.height &&
+            left.component == right.component &&
+            left.bits == right.bits &&
+            left.image == right.image &&
+            (!left.image.empty() || (left.uri == right.uri && left.bufferView == right.bufferView));
+    }
+
+    auto gltf_model::get_image_statistics() const noexcept -> const decltype(image_interner_)::statistics&
+    {
+        return image_interner_.get_statistics();
+    }
+
+    auto gltf_model::get_sampler_statistics() const noexcept -> const decltype(sampler_interner_)::statistics&
+    {
+        return sampler_interner_.get_statistics();
+    }
+
+    uint64_t gltf_model::get_content_hash() const noexcept { return content_hash_; }
+
+    auto gltf_model::get_materials() const noexcept -> const vector<material>& { return materials_; }
+
+    void gltf_model::append_draws(vector<draw>& draws, const size_t first_node, const size_t last_node) const
+    {
+        draws.reserve(draws.size() + node_draws_[last_node] - node_draws_[first_node]);
+        for(auto i = first_node; i < last_node; ++i)
+            if(nodes_.meshes[i] > -1)
+                for(const auto& primitive : meshes_[nodes_.meshes[i]].primitives)
+                    draws.push_back({&primitive, nodes_.world_matrices[i], nodes_.skins[i]});
+    }
+
+    void gltf_model::initialize_animations(const model_source& source, const vector<int>& node_positions)
+    {
+        for(size_t i = 0; i < model_.animations.size(); ++i)
+        {
+            const auto& animation = model_.animations[i];
+            map<pair<int, animation_interpolation>, size_t> timelines;
+            for(const auto& channel : animation.channels)
+            {
+                if(channel.target_node < 0 || node_positions[channel.target_node] < 0) continue;
+
+                auto path = animation_path::translation;
+                if(channel.target_path == "rotation") path = animation_path::rotation;
+                else if(channel.target_path == "scale") path = animation_path::scale;
+                else if(channel.target_path != "translation") continue;
+
+                const auto& sampler = animation.samplers[channel.sampler];
+                auto interpolation = animation_interpolation::linear;
+                if(sampler.interpolation == "STEP") interpolation = animation_interpolation::step;
+                else if(sampler.interpolation == "CUBICSPLINE") interpolation = animation_interpolation::cubic_spline;
+
+                //times are scalar floats, read as the first component
+                auto timeline = timelines.find({sampler.input, interpolation});
+                if(timeline == timelines.end())
+                    timeline = timelines.emplace(
+                        pair{sampler.input, interpolation},
+                        animations_.push_timeline(
+                            i,
+                            ::utility::container_transform<vector<float>>(
+                                read_accessor<vec2>(source, model_.accessors[sampler.input]),
+                                [](const vec2& time) { return time.x; }
+                            ),
+                            interpolation
+                        )
+                    ).first;
+
+                animations_.push_back(
+                    timeline->second,
+                    static_cast<size_t>(node_positions[channel.target_node]),
+                    path,
+                    read_accessor<vec4>(source, model_.accessors[sampler.output])
+                );
+            }
+        }
+    }
+
+    void gltf_model::decode_view(const size_t index)
+    {
+        const auto& extension = model_.bufferViews[index].extensions.at("EXT_meshopt_compression");
+        const auto get_size_func = [&extension](const string& key)
+        {
+            const auto& value = extension.Get(key);
+            return value.IsNumber() ? static_cast<size_t>(value.GetNumberAsInt()) : size_t{0};
+        };
+        const auto get_name_func = [&extension](const string& key)
+        {
+            const auto& value = extension.Get(key);
+            return value.IsString() ? value.Get<string>() : string{};
+        };
+
+        const auto buffer = get_size_func("buffer");
+        const auto byte_offset = get_size_func("byteOffset");
+        const auto byte_length = get_size_func("byteLength");
+        const auto byte_stride = get_size_func("byteStride");
+        const auto count = get_size_func("count");
+        if(buffer >= buffers_.size() ||
+            static_cast<size_t>(buffers_[buffer].second - buffers_[buffer].first) < byte_offset + byte_length)
+            throw std::runtime_error{"compressed buffer view is out of its buffer range"};
+
+        auto& decoded = decoded_views_[index];
+        decoded.resize(count * byte_stride);
+        const auto* const data = buffers_[buffer].first + byte_offset;
+        decode_meshopt(
+            decoded.data(),
+            count,
+            byte_stride,
+            {data, data + byte_length},
+            to_meshopt_mode(get_name_func("mode")),
+            to_meshopt_filter(get_name_func("filter"))
         );
-        std::sort(
-            linear_nodes_.begin(),
-            linear_nodes_.end(),
-            [](
-            decltype(linear_nodes_)::const_reference left,
-            decltype(linear_nodes_)::const_reference right
-        )
+    }
+
+    void gltf_model::initialize_tangents(const path& model_path)
+    {
+        //primitives with a normal texture and normals but no tangents, with whether the texture reads the second set
+        vector<pair<primitive*, bool>> targets;
+        for(size_t i = 0; i < meshes_.size(); ++i)
+            for(size_t j = 0; j < meshes_[i].primitives.size(); ++j)
+            {
+                auto& target = meshes_[i].primitives[j];
+                if(target.material_index < 0 || target.vertices.empty()) continue;
+
+                const auto& normal_texture = materials_[target.material_index].normal_texture;
+                const auto& attributes = model_.meshes[i].primitives[j].attributes;
+                if(!normal_texture || normal_texture->second > 1) continue;
+                if(attributes.count("TANGENT") != 0 || attributes.count("NORMAL") == 0) continue;
+                if(attributes.count(normal_texture->second == 0 ? "TEXCOORD_0" : "TEXCOORD_1") == 0) continue;
+                targets.emplace_back(&target, normal_texture->second == 1);
+            }
+        if(targets.empty()) return;
+
+        using namespace ::utility::time;
+        const auto& generation_start = steady_clock_timer();
+
+        size_t tangent_count = 0;
+        for(const auto& target : targets) tangent_count += target.first->vertices.size();
+
+        //the key covers the model file and every buffer the vertices were read from
+        const auto key = hash_combine(
+            hash_combine(tangent_cache::header::version_value, tangent_count),
+            content_hash_
+        );
+
+        //the split words of each primitive are its duplicate count, the vertices they copy, its moved corner count
+        //and the moved corners as pairs of an index position and its new vertex
+        const tangent_cache cache{path{model_path}.replace_extension(".tangents")};
+        if(const auto& cached = cache.find(key))
+        {
+            auto tangent = cached->tangents().first;
+            auto split = cached->splits().first;
+            for(const auto& target : targets)
             {
-                return left->index < right->index;
+                const auto duplicates_begin = split + 1;
+                const auto duplicates_end = duplicates_begin + *split;
+                const auto corners_begin = duplicates_end + 1;
+                const auto corners_end = corners_begin + *duplicates_end * 2;
+                split_vertices(*target.first, {duplicates_begin, duplicates_end}, {corners_begin, corners_end});
+                split = corners_end;
+
+                for(auto& target_vertex : target.first->vertices) target_vertex.tangent = *tangent++;
             }
+        }
+        else
+        {
+            vector<vector<uint32_t>> splits(targets.size());
+            //primitives are independent, each is generated on its own thread
+            const auto thread_count = static_cast<size_t>(std::thread::hardware_concurrency());
+            ::utility::thread_pool pool{std::clamp(thread_count, size_t{1}, targets.size())};
+            vector<std::future<void>> generations;
+            generations.reserve(targets.size());
+            for(size_t i = 0; i < targets.size(); ++i)
+                generations.push_back(
+                    pool.submit(
+                        [&target_primitive = *targets[i].first, is_uv1 = targets[i].second, &split = splits[i]]
+                        {
+                            auto& target_vertices = target_primitive.vertices;
+
+                            //non-indexed primitives list their triangles in vertex order
+                            auto indices = target_primitive.indices;
+                            if(indices.empty())
+                            {
+                                indices.resize(target_vertices.size());
+                                std::iota(indices.begin(), indices.end(), 0u);
+                            }
+                            const auto original_indices = indices;
+
+                            const auto& [tangents, duplicates] = generate_tangents(
+                                indices.data(),
+                                indices.data() + indices.size(),
+                                target_vertices.size(),
+                                [&target_vertices, is_uv1](const uint32_t index)
+                                {
+                                    const auto& source_vertex = target_vertices[index];
+                                    return tangent_source_vertex{
+                                        source_vertex.position,
+                                        source_vertex.normal,
+                                        is_uv1 ? source_vertex.uv1 : source_vertex.uv0
+                                    };
+                                }
+                            );
+
+                            split.push_back(static_cast<uint32_t>(duplicates.size()));
+                            split.insert(split.cend(), duplicates.cbegin(), duplicates.cend());
+                            const auto corner_count_position = split.size();
+                            split.push_back(0);
+                            for(size_t j = 0; j < indices.size(); ++j)
+                                if(indices[j] != original_indices[j])
+                                {
+                                    split.push_back(static_cast<uint32_t>(j));
+                                    split.push_back(indices[j]);
+                                    ++split[corner_count_position];
+                                }
+
+                            const auto* const duplicates_end = split.data() + 1 + duplicates.size();
+                            split_vertices(
+                                target_primitive,
+                                {split.data() + 1, duplicates_end},
+                                {duplicates_end + 1, split.data() + split.size()}
+                            );
+                            for(size_t j = 0; j < tangents.size(); ++j) target_vertices[j].tangent = tangents[j];
+                        }
+                    )
+                );
+            for(auto& generation : generations) generation.get();
+
+            vector<vec4> tangents;
+            vector<uint32_t> split_words;
+            for(size_t i = 0; i < targets.size(); ++i)
+            {
+                for(const auto& target_vertex : targets[i].first->vertices) tangents.push_back(target_vertex.tangent);
+                split_words.insert(split_words.cend(), splits[i].cbegin(), splits[i].cend());
+            }
+            cache.store(key, tangents, split_words);
+        }
+
+        if constexpr(is_debug)
+            std::cout << "gltf tangents: " << tangent_count << " tangents of " << targets.size() << " primitives in " <<
+                duration_cast<microseconds>(steady_clock_timer() - generation_start).count() << "us\n";
+    }
+
+    auto gltf_model::get_draws() const -> vector<draw>
+    {
+        vector<draw> draws;
+        append_draws(draws, 0, nodes_.size());
+        return draws;
+    }
+
+    auto gltf_model::get_nodes() const noexcept -> const node_table& { return nodes_; }
+
+    void gltf_model::set_node_transform(
+        const size_t i,
+        const vec3& translation,
+        const quat& rotation,
+        const vec3& scale
+    ) { nodes_.set_local_transform(i, translation, rotation, scale); }
+
+    void gltf_model::animate(const float time)
+    {
+        animations_.sample(
+            time,
+            nodes_.translations,
+            nodes_.rotations,
+            nodes_.scales,
+            [this](const size_t node) { nodes_.mark_dirty(node); }
         );
+    }
+
+    auto gltf_model::update_draws() -> vector<pair<size_t, vector<draw>>>
+    {
+        vector<pair<size_t, vector<draw>>> ranges;
+        for(const auto& [first_node, last_node] : nodes_.update_world_matrices())
+        {
+            vector<draw> draws;
+            append_draws(draws, first_node, last_node);
+            if(draws.empty()) continue;
 
-        for(auto& skin : skins) skin.locate_skeleton(linear_nodes_);
+            const auto first_draw = node_draws_[first_node];
+            for(size_t i = 0; i < draws.size(); ++i)
+            {
+                const auto& bounds = transform_bounds(draws[i].world_matrix, draws[i].mesh_primitive->bounding);
+                draw_bvh_.refit(first_draw + i, bounds);
+            }
+            ranges.emplace_back(first_draw, std::move(draws));
+        }
+        return ranges;
     }
 
-    mat4 gltf_model::get_dimension() const
+    auto gltf_model::get_bvh() const noexcept -> const bvh& { return draw_bvh_; }
+
+    auto gltf_model::get_joint_matrices() const -> pair<vector<mat4>, vector<size_t>>
     {
-        vec3 min;
-        vec3 max{::utility::constant::numeric::numberic_max<float>};
-        for(const auto node : linear_nodes_)
-            if(node->mesh)
+        pair<vector<mat4>, vector<size_t>> joint_matrices;
+        auto& [matrices, firsts] = joint_matrices;
+        firsts.reserve(skins_.size() + 1);
+        for(const auto& current : skins_)
+        {
+            firsts.push_back(matrices.size());
+
+            //joints outside the default scene keep the bind pose, skins without inverse bind matrices are bound
+            //at the identity
+            for(size_t i = 0; i < current.joints.size(); ++i)
             {
-                const auto& [mesh_min,mesh_max] = node->mesh->get_bounding();
+                const auto joint = current.joints[i];
+                if(joint < 0)
+                {
+                    matrices.emplace_back(1);
+                    continue;
+                }
 
-                min = glm::min(mesh_min,min);
-                max = glm::min(mesh_max,max);
+                const auto& world_matrix = nodes_.world_matrices[joint];
+                matrices.push_back(
+                    i < current.inverse_bind_matrices.size() ?
+                        multiply(world_matrix, current.inverse_bind_matrices[i]) :
+                        world_matrix
+                );
             }
+        }
+        firsts.push_back(matrices.size());
+        return joint_matrices;
+    }
+
+    optional<size_t> gltf_model::pick_node(const vec3& origin, const vec3& direction) const
+    {
+        const auto& hit = draw_bvh_.intersect_ray(origin, direction);
+        if(!hit) return nullopt;
 
-        auto&& dimension = scale(mat4{1}, max - min);
-        dimension[3] = vec4{min, 0};
+        //the last node whose first draw is not past the hit one holds it, nodes without draws share its offset
+        return static_cast<size_t>(
+            std::upper_bound(node_draws_.cbegin(), node_draws_.cend(), hit->first) - node_draws_.cbegin() - 1
+        );
+    }
+
+    vector<size_t> gltf_model::nodes_near(const vec3& center, const float radius) const
+    {
+        vector<size_t> nodes;
+        draw_bvh_.query_sphere(
+            center,
+            radius,
+            [this, &nodes](const size_t draw)
+            {
+                nodes.push_back(
+                    static_cast<size_t>(
+                        std::upper_bound(node_draws_.cbegin(), node_draws_.cend(), draw) - node_draws_.cbegin() - 1
+                    )
+                );
+            }
+        );
+        std::sort(nodes.begin(), nodes.end());
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+        return nodes;
+    }
+
+    mat4 gltf_model::get_dimension() const
+    {
+        const auto& [min_pos, max_pos] = draw_bvh_.bounds();
+        auto&& dimension = scale(mat4{1}, max_pos - min_pos);
+        dimension[3] = vec4{min_pos, 1};
         return dimension;
     }
 }
@@ -1,11 +1,11 @@
 #pragma once
 
 #include "vulkan/utility/utility.h"
-#include <boost/range/adaptor/strided.hpp>
 #include <nlohmann/json.hpp>
 
 #define TINYGLTF_NO_STB_IMAGE
 #define TINYGLTF_NO_STB_IMAGE_WRITE
+#define TINYGLTF_NO_EXTERNAL_IMAGE
 #define TINYGLTF_NO_INCLUDE_JSON
 #include <tiny_gltf.h>
 
@@ -14,6 +14,20 @@ namespace vulkan::utility
     class gltf_model
     {
     public:
+        //bytes of a gltf buffer, viewed in its mapped file or in the data tinygltf decoded from a data uri
+        using buffer_data = pair<const unsigned char*, const unsigned char*>;
+
+        //the parsed json with the buffers it references, which are never copied into the tinygltf model,
+        //and the buffer views decoded from EXT_meshopt_compression, which are empty for plain views
+        struct model_source
+        {
+            const tinygltf::Model& model;
+            const vector<buffer_data>& buffers;
+            const vector<vector<unsigned char>>& decoded_views;
+
+            //first byte of the accessor in its decoded view or its buffer
+            [[nodiscard]] const unsigned char* data(const tinygltf::Accessor&) const noexcept;
+        };
 
         struct sampler
         {
@@ -22,11 +36,15 @@ namespace vulkan::utility
             SamplerAddressMode address_mode_u = SamplerAddressMode::eRepeat;
             SamplerAddressMode address_mode_v = SamplerAddressMode::eRepeat;
             SamplerAddressMode address_mode_w = SamplerAddressMode::eRepeat;
+            SamplerMipmapMode mipmap_mode = SamplerMipmapMode::eLinear;
 
             constexpr sampler() noexcept = default;
             constexpr sampler(const tinygltf::Sampler&) noexcept;
 
+            [[nodiscard]] sampler_object::info_type create_info() const noexcept;
+
             static constexpr Filter get_vk_filter_from_gltf(const int);
+            static constexpr SamplerMipmapMode get_vk_mipmap_mode_from_gltf(const int);
             static constexpr SamplerAddressMode get_vk_addr_node_from_gltf(const int);
         };
 
@@ -38,11 +56,20 @@ namespace vulkan::utility
 
             Extent2D extent;
             uint32_t mip_levels;
-            sampler_object::info_type sampler_create_info;
+            //interned, textures with the same image content or sampler state share one instance
+            shared_ptr<const tinygltf::Image* const> image;
+            shared_ptr<const sampler_object::info_type> sampler_create_info;
             sampler sampler;
 
-            constexpr texture() noexcept = default;
-            texture(const tinygltf::Image&, const tinygltf::Sampler& = {}) noexcept;
+            texture() noexcept = default;
+            texture(
+                const tinygltf::Image&,
+                shared_ptr<const tinygltf::Image* const>,
+                shared_ptr<const sampler_object::info_type>,
+                const struct sampler& = {}
+            ) noexcept;
+
+            [[nodiscard]] DeviceSize size() const noexcept;
         };
 
         struct material
@@ -90,24 +117,39 @@ namespace vulkan::utility
                 vec3 normal;
                 vec2 uv0;
                 vec2 uv1;
+                //xyz and the sign of the bitangent as gltf gives them, generated for primitives with a normal
+                //texture that have none, zero otherwise
+                vec4 tangent;
+            };
+
+            //kept apart from the vertices, so static primitives carry no joint influences
+            struct skin_vertex
+            {
                 vec4 joint;
                 vec4 weight;
             };
 
             uint32_t index_count;
             uint32_t vertex_count;
-            material material{};
+            //index into the materials of the model, negative for primitives without one
+            int material_index = -1;
 
             vector<vertex> vertices;
+            //parallel to the vertices for skinned primitives, empty otherwise
+            vector<skin_vertex> skin_vertices;
             vector<uint32_t> indices;
 
             pair<vec3, vec3> bounding;
 
+            //of the indices as loaded and after they were optimized for the post-transform cache
+            pair<float, float> average_cache_miss_ratios{};
+
             constexpr primitive() noexcept = default;
 
-            void initialize_vertices(const tinygltf::Primitive&, const tinygltf::Model&);
-            void initialize_indices(const tinygltf::Primitive&, const tinygltf::Model&);
-            primitive(const tinygltf::Primitive&, struct material, const tinygltf::Model&);
+            void initialize_vertices(const tinygltf::Primitive&, const model_source&);
+            void initialize_indices(const tinygltf::Primitive&, const model_source&);
+            void optimize();
+            primitive(const tinygltf::Primitive&, const model_source&);
         };
 
         struct mesh
@@ -116,82 +158,166 @@ namespace vulkan::utility
 
             pair<vec3, vec3> get_bounding() const;
 
-            struct uniform_block
-            {
-                mat4 matrix;
-                array<mat4,128> joint_matrix;
-            };
-
             mesh() noexcept = default;
 
-            mesh(const tinygltf::Mesh&, const tinygltf::Model&, vector<material>);
+            mesh(const tinygltf::Mesh&, const model_source&);
         };
 
-
-        struct node;
-
         struct skin
         {
             string name;
             vector<mat4> inverse_bind_matrices;
-            const node* skeleton = nullptr;
-            vector<node*> joints;
+            //positions in the node table, negative for nodes outside the default scene
+            int skeleton = -1;
+            vector<int> joints;
 
             skin() noexcept;
 
+            //the inverse bind matrices are given as their accessor and its data
             skin(
                 const tinygltf::Skin&,
-                const optional<
-                    tuple<const tinygltf::Accessor*, const tinygltf::BufferView*, const tinygltf::Buffer*>
-                >& = nullopt
+                const optional<pair<const tinygltf::Accessor*, const unsigned char*>>& = nullopt
             )
             noexcept;
 
-            void locate_skeleton(vector<node*>&);
-
-        private:
-            size_t skeleton_index_;
-
+            //turns the gltf node indices into positions in the node table
+            void locate_nodes(const vector<int>&);
         };
 
-        struct node
+        //the nodes of the default scene as columns indexed by their position, parents come before their children,
+        //so one pass in table order sees the transform of every parent before its children need it, and the
+        //subtree of a node is the run of positions up to its subtree end
+        struct node_table
         {
-            int index = -1;
+            //gltf index of the node and the position of its parent, negative for roots
+            vector<int> indices;
+            vector<int> parents;
+            vector<string> names;
+            vector<vec3> translations;
+            vector<quat> rotations;
+            vector<vec3> scales;
+            vector<mat4> matrices;
+            //into the meshes and skins of the model, negative for nodes without one
+            vector<int> meshes;
+            vector<int> skins;
+            vector<size_t> subtree_ends;
+            vector<mat4> world_matrices;
+            //set on nodes whose local transform changed since the last update, their subtrees lie in the dirty ranges,
+            //which are sorted and neither overlap nor touch
+            vector<bool> dirty;
+            vector<pair<size_t, size_t>> dirty_ranges;
+
+            [[nodiscard]] size_t size() const noexcept;
+
+            void push_back(const tinygltf::Node&, const int, const int);
+            //finds the subtree ends once every node is pushed and marks the whole table dirty
+            void link_subtrees();
+
+            [[nodiscard]] mat4 local_matrix(const size_t) const noexcept;
+
+            void set_local_transform(const size_t, const vec3&, const quat&, const vec3&);
+            void mark_dirty(const size_t);
+            //recomputes the world matrices of the dirty subtrees only, returns the ranges of positions it covered
+            vector<pair<size_t, size_t>> update_world_matrices();
+        };
 
-            string name;
-            skin skin;
-            vec3 translation;
-            vec3 rotation;
-            vec3 scale = vec3{1};
-            mat4 matrix = mat4{1};
-
-            optional<mesh> mesh;
-
-            node* parent = nullptr;
-            vector<node> children;
-
-            node() noexcept = default;
-
-            node(
-                const int,
-                node*,
-                vector<struct skin> skins,
-                const tinygltf::Node&,
-                const tinygltf::Model&,
-                vector<material>,
-                vector<node*>&
-            );
+        //a primitive of a mesh node with the world transform of the node and the skin of the node,
+        //which is negative for nodes without one
+        struct draw
+        {
+            const primitive* mesh_primitive;
+            mat4 world_matrix;
+            int skin = -1;
         };
 
 
     private:
+        boost::interprocess::file_mapping file_;
+        boost::interprocess::mapped_region region_;
+
+        //external buffer files, mapped for as long as the model lives
+        vector<pair<boost::interprocess::file_mapping, boost::interprocess::mapped_region>> buffer_files_;
+        vector<buffer_data> buffers_;
+        vector<vector<unsigned char>> decoded_views_;
+        //of the mapped file and every buffer, caches of data derived from the model are keyed by it
+        uint64_t content_hash_ = 0;
+
         tinygltf::Model model_;
-        vector<node*> linear_nodes_;
+        vector<material> materials_;
+        //indexed like the gltf arrays, meshes no node of the default scene uses are left empty
+        vector<mesh> meshes_;
+        vector<skin> skins_;
+        node_table nodes_;
+        //channels of every animation that target nodes of the default scene, keyed by their node positions
+        animation_tracks animations_;
+        //position of the first draw of every node among the draws and the draw count at the end,
+        //the draws of a subtree are as contiguous as its nodes
+        vector<size_t> node_draws_;
+        //over the world space boxes of the draws, instances are indexed like get_draws
+        bvh draw_bvh_;
+
+        interner<const tinygltf::Image* const> image_interner_;
+        interner<const sampler_object::info_type> sampler_interner_;
+
+        //the json chunk and the binary chunk of a glb, a gltf file is json only
+        [[nodiscard]] static pair<pair<const char*, const char*>, buffer_data> split_chunks(const buffer_data&);
+
+        [[nodiscard]] static uint64_t image_hash(const tinygltf::Image&) noexcept;
+        [[nodiscard]] static bool is_same_image(const tinygltf::Image&, const tinygltf::Image&) noexcept;
+
+        void append_draws(vector<draw>&, const size_t, const size_t) const;
+
+        //channels sharing a sampler input share their timeline, morph target weights are not animated
+        void initialize_animations(const model_source&, const vector<int>&);
+
+        //decodes the compressed copy of the buffer view into its decoded view
+        void decode_view(const size_t);
+
+        //generates the missing tangents of normal mapped primitives in parallel, or reads them from the file
+        //next to the model if the model is unchanged since they were generated, vertices shared by mirrored
+        //triangles are split either way, so the primitives gain vertices and may become indexed
+        void initialize_tangents(const path&);
 
     public:
+        //loads a .gltf or .glb from a memory mapping, accessors are read in place from the mapped buffers
         gltf_model(const path&);
 
-        mat4 get_dimension()const;
+        [[nodiscard]] uint64_t get_content_hash() const noexcept;
+
+        [[nodiscard]] const vector<material>& get_materials() const noexcept;
+
+        //every primitive of the default scene, in node table order
+        [[nodiscard]] vector<draw> get_draws() const;
+
+        [[nodiscard]] const node_table& get_nodes() const noexcept;
+
+        //replaces the local transform of the node at the position, its subtree is updated by update_draws
+        void set_node_transform(const size_t, const vec3&, const quat&, const vec3&);
+        //samples every animation at the time in seconds, each looping over its own duration,
+        //the nodes it moves are updated by update_draws
+        void animate(const float);
+        //updates the world matrices of the nodes moved since the last update and refits their boxes,
+        //returns the draws below every dirty range along with the position of the first one among get_draws
+        [[nodiscard]] vector<pair<size_t, vector<draw>>> update_draws();
+
+        [[nodiscard]] const bvh& get_bvh() const noexcept;
+
+        //the joint matrices of every skin one after another and the position of the first one of every skin,
+        //followed by the joint matrix count, a joint matrix maps the bind pose into world space
+        [[nodiscard]] pair<vector<mat4>, vector<size_t>> get_joint_matrices() const;
+
+        //position of the node whose draw the ray enters first, the boxes of the draws stand in for their triangles
+        [[nodiscard]] optional<size_t> pick_node(const vec3&, const vec3&) const;
+
+        //positions of the nodes with a draw whose box overlaps the sphere in ascending order,
+        //only a coarse rejection for collision tests against their triangles
+        [[nodiscard]] vector<size_t> nodes_near(const vec3&, const float) const;
+
+        [[nodiscard]] const decltype(image_interner_)::statistics& get_image_statistics() const noexcept;
+        [[nodiscard]] const decltype(sampler_interner_)::statistics& get_sampler_statistics() const noexcept;
+
+        //maps the unit cube onto the world space box around every draw
+        [[nodiscard]] mat4 get_dimension() const;
     };
 }
 
@@ -7,7 +7,8 @@ namespace vulkan::utility
         min_filter(get_vk_filter_from_gltf(sampler.minFilter)),
         address_mode_u(get_vk_addr_node_from_gltf(sampler.wrapS)),
         address_mode_v(get_vk_addr_node_from_gltf(sampler.wrapT)),
-        address_mode_w(address_mode_v) {}
+        address_mode_w(address_mode_v),
+        mipmap_mode(get_vk_mipmap_mode_from_gltf(sampler.minFilter)) {}
 
     constexpr Filter gltf_model::sampler::get_vk_filter_from_gltf(const int gltf_filter)
     {
@@ -23,6 +24,16 @@ namespace vulkan::utility
         }
     }
 
+    constexpr SamplerMipmapMode gltf_model::sampler::get_vk_mipmap_mode_from_gltf(const int gltf_filter)
+    {
+        switch(gltf_filter)
+        {
+        case TINYGLTF_TEXTURE_FILTER_NEAREST_MIPMAP_NEAREST:
+        case TINYGLTF_TEXTURE_FILTER_LINEAR_MIPMAP_NEAREST: return SamplerMipmapMode::eNearest;
+        default: return SamplerMipmapMode::eLinear;
+        }
+    }
+
     constexpr SamplerAddressMode gltf_model::sampler::get_vk_addr_node_from_gltf(const int gltf_wrap_node)
     {
         switch(gltf_wrap_node)
@@ -775,6 +775,29 @@ namespace vulkan::utility
 		info.pDynamicState = dynamic_state_ ? &*dynamic_state_ : nullptr;
 	}
 
+	void info_proxy<compute_pipeline_create_info>::property_copy(const info_proxy& right) const
+	{
+		stage_info_proxy_property = right.stage_info_proxy_property;
+	}
+
+	info_proxy<compute_pipeline_create_info>::info_proxy(
+		decltype(stage_info_proxy_) stage_info_proxy,
+		decltype(info) info
+	) : base(std::move(info))
+	{
+		stage_info_proxy_property = std::move(stage_info_proxy);
+	}
+
+	info_proxy<compute_pipeline_create_info>::info_proxy(base_info_type info) :
+		info_proxy(info.stage, std::move(info))
+	{}
+
+	void info_proxy<compute_pipeline_create_info>::set_stage_info_proxy(decltype(stage_info_proxy_) value)
+	{
+		stage_info_proxy_ = std::move(value);
+		info.stage = stage_info_proxy_;
+	}
+
 	void info_proxy<CommandBufferBeginInfo>::property_copy(const info_proxy& right) const
 	{
 		inheritance_info_property = right.inheritance_info_property;
@@ -999,6 +999,48 @@ namespace vulkan::utility
 		using type = info_proxy<graphics_pipeline_create_info>;
 	};
 
+	struct compute_pipeline_create_info : ComputePipelineCreateInfo
+	{
+		using base = ComputePipelineCreateInfo;
+
+		PipelineCache cache;
+	};
+
+	template<>
+	struct info_proxy<compute_pipeline_create_info> : info_proxy_base<compute_pipeline_create_info>
+	{
+		using base = info_proxy_base;
+
+	private:
+		info_proxy<decltype(info.stage)> stage_info_proxy_;
+
+		void property_copy(const info_proxy&) const;
+		constexpr void property_move(info_proxy&&) const noexcept;
+	public:
+		DEFAULT_RULE_OF_5(info_proxy)
+
+		explicit info_proxy(decltype(stage_info_proxy_), decltype(info) = {});
+
+		info_proxy(base_info_type = {});
+
+		constexpr const decltype(stage_info_proxy_)& get_stage_info_proxy() const noexcept;
+		void set_stage_info_proxy(decltype(stage_info_proxy_));
+
+		const property<info_proxy, decltype(stage_info_proxy_)> stage_info_proxy_property{
+			*this,
+			&info_proxy::get_stage_info_proxy,
+			&info_proxy::set_stage_info_proxy,
+		};
+	};
+
+	template<>
+	struct info<ComputePipeline>
+	{
+		using handle_type = ComputePipeline;
+		using base_info_type = compute_pipeline_create_info;
+		using type = info_proxy<compute_pipeline_create_info>;
+	};
+
 	template<>
 	struct info_proxy<CommandBufferBeginInfo> : info_proxy_base<CommandBufferBeginInfo>
 	{
@@ -245,6 +245,14 @@ namespace vulkan::utility
 	constexpr auto info_proxy<graphics_pipeline_create_info>::get_dynamic_state() const noexcept ->
 		const decltype(dynamic_state_)& { return dynamic_state_; }
 
+	constexpr void info_proxy<compute_pipeline_create_info>::property_move(info_proxy&& right) const noexcept
+	{
+		stage_info_proxy_property = std::move(right.stage_info_proxy_);
+	}
+
+	constexpr auto info_proxy<compute_pipeline_create_info>::get_stage_info_proxy() const noexcept ->
+		const decltype(stage_info_proxy_)& { return stage_info_proxy_; }
+
 	constexpr void info_proxy<CommandBufferBeginInfo>::property_move(info_proxy&& right) const noexcept
 	{
 		inheritance_info_property = std::move(right.inheritance_info_);
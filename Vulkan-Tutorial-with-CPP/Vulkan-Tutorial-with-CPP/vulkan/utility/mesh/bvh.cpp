@@ -0,0 +1,269 @@
+#include "bvh.h"
+
+namespace vulkan::utility
+{
+    namespace
+    {
+        constexpr pair<vec3, vec3> empty_bounds() noexcept
+        {
+            return {
+                vec3{::utility::constant::numeric::numberic_max<float>},
+                vec3{::utility::constant::numeric::numberic_lowest<float>}
+            };
+        }
+
+        void grow(pair<vec3, vec3>& bounds, const pair<vec3, vec3>& other) noexcept
+        {
+            bounds.first = min(bounds.first, other.first);
+            bounds.second = max(bounds.second, other.second);
+        }
+
+        //half of the surface area, only ratios of it are compared
+        float half_area(const pair<vec3, vec3>& bounds) noexcept
+        {
+            const auto& extent = bounds.second - bounds.first;
+            return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+        }
+    }
+
+    pair<vec3, vec3> transform_bounds(const mat4& mat, const pair<vec3, vec3>& bounds) noexcept
+    {
+        const auto& center = vec3{mat * vec4{(bounds.first + bounds.second) / 2.0f, 1}};
+        const auto& extent = (bounds.second - bounds.first) / 2.0f;
+        const auto& mapped_extent = abs(vec3{mat[0]}) * extent.x + abs(vec3{mat[1]}) * extent.y +
+            abs(vec3{mat[2]}) * extent.z;
+        return {center - mapped_extent, center + mapped_extent};
+    }
+
+    bvh::bvh(vector<pair<vec3, vec3>> instance_bounds) : instance_bounds_(std::move(instance_bounds))
+    {
+        const auto instance_count = static_cast<uint32_t>(instance_bounds_.size());
+        if(instance_count == 0) return;
+
+        instances_.resize(instance_count);
+        std::iota(instances_.begin(), instances_.end(), uint32_t{0});
+        const auto& centroids = ::utility::container_transform<vector<vec3>>(
+            instance_bounds_,
+            [](const pair<vec3, vec3>& box) { return (box.first + box.second) / 2.0f; }
+        );
+
+        nodes_.reserve(2 * static_cast<size_t>(instance_count) - 1);
+        parents_.reserve(nodes_.capacity());
+        nodes_.push_back({{}, 0, instance_count});
+        parents_.push_back(no_parent);
+
+        vector<uint32_t> pending{0};
+        while(!pending.empty())
+        {
+            const auto node_index = pending.back();
+            pending.pop_back();
+            const auto first = nodes_[node_index].first;
+            const auto count = nodes_[node_index].count;
+            const auto instances_begin = instances_.begin() + first;
+            const auto instances_end = instances_begin + count;
+
+            auto node_box = empty_bounds();
+            auto centroid_bounds = empty_bounds();
+            for(auto it = instances_begin; it != instances_end; ++it)
+            {
+                grow(node_box, instance_bounds_[*it]);
+                grow(centroid_bounds, {centroids[*it], centroids[*it]});
+            }
+            nodes_[node_index].bounds = node_box;
+            if(count <= 1) continue;
+
+            //the cheapest bin boundary over all axes, each side costs its instance count times its area
+            struct bin
+            {
+                pair<vec3, vec3> bounds = empty_bounds();
+                uint32_t count = 0;
+            };
+            const auto& centroid_extent = centroid_bounds.second - centroid_bounds.first;
+            const auto& bin_index = [&centroids, &centroid_bounds, &centroid_extent](
+                const uint32_t instance,
+                const int axis
+            )
+            {
+                return std::min(
+                    static_cast<size_t>(
+                        (centroids[instance][axis] - centroid_bounds.first[axis]) / centroid_extent[axis] * bin_count
+                    ),
+                    bin_count - 1
+                );
+            };
+
+            auto best_cost = ::utility::constant::numeric::numberic_max<float>;
+            auto best_axis = -1;
+            size_t best_split = 0;
+            for(auto axis = 0; axis < 3; ++axis)
+            {
+                if(centroid_extent[axis] <= 0) continue;
+
+                array<bin, bin_count> bins{};
+                for(auto it = instances_begin; it != instances_end; ++it)
+                {
+                    auto& current = bins[bin_index(*it, axis)];
+                    grow(current.bounds, instance_bounds_[*it]);
+                    ++current.count;
+                }
+
+                array<float, bin_count - 1> left_costs{};
+                {
+                    auto left_bounds = empty_bounds();
+                    uint32_t left_count = 0;
+                    for(size_t i = 0; i + 1 < bin_count; ++i)
+                    {
+                        grow(left_bounds, bins[i].bounds);
+                        left_count += bins[i].count;
+                        left_costs[i] = left_count > 0 ? half_area(left_bounds) * static_cast<float>(left_count) : 0;
+                    }
+                }
+
+                auto right_bounds = empty_bounds();
+                uint32_t right_count = 0;
+                for(auto i = bin_count - 1; i > 0; --i)
+                {
+                    grow(right_bounds, bins[i].bounds);
+                    right_count += bins[i].count;
+                    if(right_count == 0 || right_count == count) continue;
+
+                    const auto cost = left_costs[i - 1] + half_area(right_bounds) * static_cast<float>(right_count);
+                    if(cost < best_cost)
+                    {
+                        best_cost = cost;
+                        best_axis = axis;
+                        best_split = i;
+                    }
+                }
+            }
+
+            //a split costs one more box test, the leaf tests every instance
+            const auto area = half_area(node_box);
+            const auto leaf_cost = static_cast<float>(count);
+            if(count <= max_leaf_size && (best_axis < 0 || area <= 0 || 1 + best_cost / area >= leaf_cost)) continue;
+
+            //instances with the same centroid are split in half to keep leaves small
+            auto middle = instances_begin + count / 2;
+            if(best_axis >= 0)
+                middle = std::partition(
+                    instances_begin,
+                    instances_end,
+                    [&bin_index, best_axis, best_split](const uint32_t instance)
+                    {
+                        return bin_index(instance, best_axis) < best_split;
+                    }
+                );
+
+            const auto left_count = static_cast<uint32_t>(middle - instances_begin);
+            const auto left = static_cast<uint32_t>(nodes_.size());
+            nodes_.push_back({{}, first, left_count});
+            nodes_.push_back({{}, first + left_count, count - left_count});
+            parents_.push_back(node_index);
+            parents_.push_back(node_index);
+            nodes_[node_index].first = left;
+            nodes_[node_index].count = 0;
+            pending.push_back(left);
+            pending.push_back(left + 1);
+        }
+
+        instance_leaves_.resize(instance_count);
+        for(uint32_t i = 0; i < nodes_.size(); ++i)
+        {
+            const auto& current = nodes_[i];
+            for(auto j = current.first; j < current.first + current.count; ++j) instance_leaves_[instances_[j]] = i;
+        }
+    }
+
+    pair<vec3, vec3> bvh::node_bounds(const node& current) const noexcept
+    {
+        if(current.count == 0)
+        {
+            auto box = nodes_[current.first].bounds;
+            grow(box, nodes_[current.first + 1].bounds);
+            return box;
+        }
+
+        auto box = empty_bounds();
+        for(auto i = current.first; i < current.first + current.count; ++i) grow(box, instance_bounds_[instances_[i]]);
+        return box;
+    }
+
+    array<vec4, 6> bvh::frustum_planes(const mat4& mat) noexcept
+    {
+        const auto& rows = transpose(mat);
+        return {rows[3] + rows[0], rows[3] - rows[0], rows[3] + rows[1], rows[3] - rows[1], rows[2], rows[3] - rows[2]};
+    }
+
+    bool bvh::empty() const noexcept { return nodes_.empty(); }
+
+    pair<vec3, vec3> bvh::bounds() const noexcept { return empty() ? pair{vec3{0}, vec3{0}} : nodes_.front().bounds; }
+
+    void bvh::refit(const size_t instance, const pair<vec3, vec3>& box)
+    {
+        instance_bounds_[instance] = box;
+        for(auto node_index = instance_leaves_[instance]; node_index != no_parent; node_index = parents_[node_index])
+        {
+            auto& current = nodes_[node_index];
+            const auto& refitted = node_bounds(current);
+            if(refitted == current.bounds) break;
+            current.bounds = refitted;
+        }
+    }
+
+    optional<pair<size_t, float>> bvh::intersect_ray(
+        const vec3& origin,
+        const vec3& direction,
+        const float max_distance
+    ) const
+    {
+        //slab test, the part of the ray behind the origin does not count
+        const auto& inverse_direction = 1.0f / direction;
+        const auto& entry_distance = [&origin, &inverse_direction](const pair<vec3, vec3>& box)
+        {
+            const auto& near_distances = (box.first - origin) * inverse_direction;
+            const auto& far_distances = (box.second - origin) * inverse_direction;
+            const auto& entries = min(near_distances, far_distances);
+            const auto& exits = max(near_distances, far_distances);
+            const auto entry = std::max({entries.x, entries.y, entries.z, 0.0f});
+            const auto exit = std::min({exits.x, exits.y, exits.z});
+            return entry <= exit ? entry : ::utility::constant::numeric::numberic_max<float>;
+        };
+
+        optional<pair<size_t, float>> nearest;
+        if(empty()) return nearest;
+
+        auto nearest_distance = max_distance;
+        vector<pair<uint32_t, float>> pending{{0, entry_distance(nodes_.front().bounds)}};
+        while(!pending.empty())
+        {
+            const auto [node_index, distance] = pending.back();
+            pending.pop_back();
+            if(distance >= nearest_distance) continue;
+
+            const auto& current = nodes_[node_index];
+            if(current.count == 0)
+            {
+                //the nearer child is visited first, so it can prune the farther one
+                pair<uint32_t, float> children[] = {
+                    {current.first, entry_distance(nodes_[current.first].bounds)},
+                    {current.first + 1, entry_distance(nodes_[current.first + 1].bounds)}
+                };
+                if(children[0].second < children[1].second) std::swap(children[0], children[1]);
+                for(const auto& child : children)
+                    if(child.second < nearest_distance) pending.push_back(child);
+                continue;
+            }
+
+            for(auto i = current.first; i < current.first + current.count; ++i)
+            {
+                const auto instance_distance = entry_distance(instance_bounds_[instances_[i]]);
+                if(instance_distance < nearest_distance)
+                {
+                    nearest_distance = instance_distance;
+                    nearest = {instances_[i], instance_distance};
+                }
+            }
+        }
+        return nearest;
+    }
+}
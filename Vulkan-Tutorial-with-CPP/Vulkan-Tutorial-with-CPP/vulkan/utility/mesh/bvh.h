@@ -0,0 +1,79 @@
+#pragma once
+
+#include "vulkan/utility/utility_core.h"
+#include "utility/constant/numberic.h"
+
+namespace vulkan::utility
+{
+    //box around the given box after the matrix maps it, from the mapped center and the absolute linear part
+    [[nodiscard]] pair<vec3, vec3> transform_bounds(const mat4&, const pair<vec3, vec3>&) noexcept;
+
+    //bounding volume hierarchy over the boxes of instances, split by the surface area heuristic over binned centroids,
+    //instances keep the index of their box in the boxes it was built from
+    class bvh
+    {
+    public:
+        //a leaf holds count instances from first on in the instance order, an inner node has a zero count
+        //and its children at first and first + 1
+        struct node
+        {
+            pair<vec3, vec3> bounds;
+            uint32_t first = 0;
+            uint32_t count = 0;
+        };
+
+        static constexpr size_t bin_count = 12;
+        //splits are only given up for the leaf cost below this size
+        static constexpr size_t max_leaf_size = 4;
+
+    private:
+        static constexpr auto no_parent = ::utility::constant::numeric::numberic_max<uint32_t>;
+
+        vector<node> nodes_;
+        vector<uint32_t> instances_;
+        vector<pair<vec3, vec3>> instance_bounds_;
+        vector<uint32_t> parents_;
+        vector<uint32_t> instance_leaves_;
+
+        [[nodiscard]] pair<vec3, vec3> node_bounds(const node&) const noexcept;
+
+        //frustum planes of a view projection matrix with depth from zero to one, normals pointing inside
+        [[nodiscard]] static array<vec4, 6> frustum_planes(const mat4&) noexcept;
+
+        template<typename Func>
+        void for_each_instance(const uint32_t, Func&&) const;
+
+    public:
+        bvh() noexcept = default;
+
+        explicit bvh(vector<pair<vec3, vec3>>);
+
+        [[nodiscard]] bool empty() const noexcept;
+
+        //box around every instance, an empty hierarchy has a zero box
+        [[nodiscard]] pair<vec3, vec3> bounds() const noexcept;
+
+        //replaces the box of an instance and refits its ancestors up to the first one that keeps its box,
+        //the tree keeps its shape, so it loses quality after large moves
+        void refit(const size_t, const pair<vec3, vec3>&);
+
+        //calls the function with the index of every instance whose box is not outside the frustum of the matrix,
+        //subtrees inside the frustum are reported without testing their boxes
+        template<typename Func>
+        void query_frustum(const mat4&, Func&&) const;
+
+        //calls the function with the index of every instance whose box overlaps the sphere
+        template<typename Func>
+        void query_sphere(const vec3&, const float, Func&&) const;
+
+        //nearest instance whose box the ray enters within the given distance, along with the distance,
+        //which is measured in lengths of the direction
+        [[nodiscard]] optional<pair<size_t, float>> intersect_ray(
+            const vec3&,
+            const vec3&,
+            const float = ::utility::constant::numeric::numberic_max<float>
+        ) const;
+    };
+}
+
+#include "bvh.tpp"
@@ -0,0 +1,94 @@
+#pragma once
+
+namespace vulkan::utility
+{
+    template<typename Func>
+    void bvh::for_each_instance(const uint32_t node_index, Func&& func) const
+    {
+        vector<uint32_t> pending{node_index};
+        while(!pending.empty())
+        {
+            const auto& current = nodes_[pending.back()];
+            pending.pop_back();
+            if(current.count == 0)
+            {
+                pending.push_back(current.first);
+                pending.push_back(current.first + 1);
+                continue;
+            }
+            for(auto i = current.first; i < current.first + current.count; ++i) func(size_t{instances_[i]});
+        }
+    }
+
+    template<typename Func>
+    void bvh::query_frustum(const mat4& mat, Func&& func) const
+    {
+        if(empty()) return;
+
+        const auto& planes = frustum_planes(mat);
+        vector<uint32_t> pending{0};
+        while(!pending.empty())
+        {
+            const auto node_index = pending.back();
+            pending.pop_back();
+            const auto& current = nodes_[node_index];
+            const auto& [min_pos, max_pos] = current.bounds;
+
+            //the corner farthest along the normal decides outside, the nearest one inside
+            auto is_inside = true;
+            auto is_outside = false;
+            for(const auto& plane : planes)
+            {
+                const vec3 normal{plane};
+                const auto& far_corner = mix(min_pos, max_pos, greaterThan(normal, vec3{0}));
+                const auto& near_corner = mix(max_pos, min_pos, greaterThan(normal, vec3{0}));
+                if(dot(normal, far_corner) + plane.w < 0)
+                {
+                    is_outside = true;
+                    break;
+                }
+                if(dot(normal, near_corner) + plane.w < 0) is_inside = false;
+            }
+            if(is_outside) continue;
+
+            if(is_inside) for_each_instance(node_index, func);
+            else if(current.count == 0)
+            {
+                pending.push_back(current.first);
+                pending.push_back(current.first + 1);
+            }
+            //the few instances of a leaf crossing a plane are reported along with it
+            else
+                for(auto i = current.first; i < current.first + current.count; ++i) func(size_t{instances_[i]});
+        }
+    }
+
+    template<typename Func>
+    void bvh::query_sphere(const vec3& center, const float radius, Func&& func) const
+    {
+        if(empty()) return;
+
+        const auto& overlaps = [&center, radius_square = radius * radius](const pair<vec3, vec3>& box)
+        {
+            const auto& offset = clamp(center, box.first, box.second) - center;
+            return dot(offset, offset) <= radius_square;
+        };
+
+        vector<uint32_t> pending{0};
+        while(!pending.empty())
+        {
+            const auto& current = nodes_[pending.back()];
+            pending.pop_back();
+            if(!overlaps(current.bounds)) continue;
+
+            if(current.count == 0)
+            {
+                pending.push_back(current.first);
+                pending.push_back(current.first + 1);
+                continue;
+            }
+            for(auto i = current.first; i < current.first + current.count; ++i)
+                if(overlaps(instance_bounds_[instances_[i]])) func(size_t{instances_[i]});
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#include "meshlet.h"
+
+namespace vulkan::utility
+{
+    pair<vec4, vec4> meshlet_bounds(const vec3* const begin, const vec3* const end)
+    {
+        if(begin == end) return {vec4{0}, vec4{0, 0, 0, 1}};
+
+        vec3 min_pos{*begin};
+        vec3 max_pos{*begin};
+        for(auto it = begin; it != end; ++it)
+        {
+            min_pos = min(min_pos, *it);
+            max_pos = max(max_pos, *it);
+        }
+
+        const auto& center = (min_pos + max_pos) / 2.0f;
+        float radius = 0;
+        for(auto it = begin; it != end; ++it) radius = std::max(radius, distance(center, *it));
+
+        //degenerate triangles have no facing and are left out of the cone
+        vector<vec3> normals;
+        normals.reserve(static_cast<size_t>(end - begin) / 3);
+        vec3 normal_sum{0};
+        for(auto it = begin; it + 2 < end; it += 3)
+        {
+            const auto& cross_product = cross(it[1] - it[0], it[2] - it[0]);
+            const auto cross_length = length(cross_product);
+            if(cross_length <= 0) continue;
+
+            normal_sum += normals.emplace_back(cross_product / cross_length);
+        }
+
+        const auto normal_sum_length = length(normal_sum);
+        if(normal_sum_length <= 0) return {vec4{center, radius}, vec4{0, 0, 0, 1}};
+
+        const auto& axis = normal_sum / normal_sum_length;
+        auto min_dot = 1.0f;
+        for(const auto& normal : normals) min_dot = std::min(min_dot, dot(axis, normal));
+
+        //a cone close to a half space almost never faces away as a whole, so it is not worth testing
+        static constexpr auto min_cone_dot = 0.1f;
+        return {
+            vec4{center, radius},
+            vec4{axis, min_dot <= min_cone_dot ? 1.0f : std::sqrt(1 - min_dot * min_dot)}
+        };
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "vulkan/utility/utility_core.h"
+
+namespace vulkan::utility
+{
+    //vertex and triangle limits of a meshlet, the sizes mesh shading hardware favors
+    inline constexpr size_t meshlet_max_vertices = 64;
+    inline constexpr size_t meshlet_max_triangles = 124;
+
+    //a run of triangles in the index buffer that is culled as a whole, laid out for a std430 buffer,
+    //the cone holds the average normal and the cutoff of the back facing test, 1 when it never culls,
+    //the draw index picks the indirect command and the transform index the world matrix of the draw
+    struct meshlet
+    {
+        vec4 sphere;
+        vec4 cone;
+        uint32_t first_index;
+        uint32_t index_count;
+        uint32_t draw_index;
+        uint32_t transform_index = 0;
+    };
+
+    //bounding sphere and normal cone of the triangles whose corners are given in order
+    [[nodiscard]] pair<vec4, vec4> meshlet_bounds(const vec3*, const vec3*);
+
+    //splits the triangles of an index range into meshlets without reordering them, so the locality the vertex cache
+    //optimization gave the range is kept, first_index is where the range starts in the index buffer
+    template<typename PositionFunc>
+    [[nodiscard]] vector<meshlet> build_meshlets(
+        const uint32_t*,
+        const uint32_t*,
+        const uint32_t,
+        const uint32_t,
+        PositionFunc&&
+    );
+}
+
+#include "meshlet.tpp"
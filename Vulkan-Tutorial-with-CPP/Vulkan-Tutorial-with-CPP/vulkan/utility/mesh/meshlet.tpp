@@ -0,0 +1,64 @@
+#pragma once
+
+namespace vulkan::utility
+{
+    template<typename PositionFunc>
+    vector<meshlet> build_meshlets(
+        const uint32_t* const begin,
+        const uint32_t* const end,
+        const uint32_t first_index,
+        const uint32_t draw_index,
+        PositionFunc&& position_func
+    )
+    {
+        const auto index_count = static_cast<size_t>(end - begin) / 3 * 3;
+        vector<meshlet> meshlets;
+        vector<uint32_t> vertices;
+        vertices.reserve(meshlet_max_vertices);
+        vector<vec3> corners;
+        corners.reserve(meshlet_max_triangles * 3);
+        size_t meshlet_begin = 0;
+
+        const auto close = [&](const size_t meshlet_end)
+        {
+            if(meshlet_end == meshlet_begin) return;
+
+            const auto& [sphere, cone] = meshlet_bounds(corners.data(), corners.data() + corners.size());
+            meshlets.push_back(
+                {
+                    sphere,
+                    cone,
+                    first_index + static_cast<uint32_t>(meshlet_begin),
+                    static_cast<uint32_t>(meshlet_end - meshlet_begin),
+                    draw_index
+                }
+            );
+            vertices.clear();
+            corners.clear();
+            meshlet_begin = meshlet_end;
+        };
+
+        for(size_t i = 0; i < index_count; i += 3)
+        {
+            //a triangle that does not fit starts the next meshlet
+            size_t new_vertex_count = 0;
+            for(size_t j = 0; j < 3; ++j)
+                if(std::find(vertices.cbegin(), vertices.cend(), begin[i + j]) == vertices.cend() &&
+                    std::find(begin + i, begin + i + j, begin[i + j]) == begin + i + j)
+                    ++new_vertex_count;
+            if(vertices.size() + new_vertex_count > meshlet_max_vertices ||
+                (i - meshlet_begin) / 3 == meshlet_max_triangles)
+                close(i);
+
+            for(size_t j = 0; j < 3; ++j)
+            {
+                const auto vertex = begin[i + j];
+                if(std::find(vertices.cbegin(), vertices.cend(), vertex) == vertices.cend()) vertices.push_back(vertex);
+                corners.push_back(position_func(vertex));
+            }
+        }
+        close(index_count);
+
+        return meshlets;
+    }
+}
@@ -0,0 +1,465 @@
+#include "meshopt_codec.h"
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define MESHOPT_CODEC_SIMD
+#include <immintrin.h>
+#endif
+
+namespace vulkan::utility
+{
+    namespace
+    {
+        constexpr unsigned char vertex_header = 0xa0;
+        constexpr unsigned char triangle_header = 0xe0;
+        constexpr unsigned char sequence_header = 0xd0;
+        constexpr size_t byte_group_size = 16;
+        //a group of four bit values followed by an escaped byte for each of them
+        constexpr size_t byte_group_max_size = byte_group_size / 2 + byte_group_size;
+        //the encoder pads the tail holding the first vertex to this size, so a group read never passes the end
+        constexpr size_t vertex_tail_min_size = 32;
+
+        void check(const bool condition)
+        {
+            if(!condition) throw std::runtime_error{"meshopt compressed data is malformed"};
+        }
+
+        //the header bits give every group of 16 bytes zero, two, four or eight bits per value,
+        //two and four bit values at their maximum are escaped by a byte following the packed values
+        const unsigned char* decode_byte_groups(
+            const unsigned char* data,
+            const unsigned char* const data_end,
+            unsigned char* const destination,
+            const size_t size
+        )
+        {
+            const auto header_size = (size / byte_group_size + 3) / 4;
+            check(static_cast<size_t>(data_end - data) >= header_size);
+            const auto* const header = data;
+            data += header_size;
+
+            for(size_t i = 0; i < size; i += byte_group_size)
+            {
+                check(static_cast<size_t>(data_end - data) >= byte_group_max_size);
+
+                const auto group = i / byte_group_size;
+                const auto bits_log2 = (header[group / 4] >> group % 4 * 2) & 3;
+                auto* const values = destination + i;
+                if(bits_log2 == 0)
+                {
+                    std::memset(values, 0, byte_group_size);
+                    continue;
+                }
+                if(bits_log2 == 3)
+                {
+                    std::memcpy(values, data, byte_group_size);
+                    data += byte_group_size;
+                    continue;
+                }
+
+                //values are packed from the high bits of every byte on
+                const auto bits = 1u << bits_log2;
+                const auto escape = (1u << bits) - 1;
+                const auto* escaped = data + byte_group_size * bits / 8;
+                for(size_t j = 0; j < byte_group_size; ++j)
+                {
+                    const auto bit_offset = j * bits;
+                    const auto value = (static_cast<unsigned>(data[bit_offset / 8]) >> (8 - bits - bit_offset % 8)) &
+                        escape;
+                    values[j] = static_cast<unsigned char>(value == escape ? *escaped++ : value);
+                }
+                data = escaped;
+            }
+            return data;
+        }
+
+        //every byte of a vertex is a stream of zigzag deltas to the same byte of the previous vertex,
+        //the streams are decoded 16 vertices at a time and interleaved into the destination
+        const unsigned char* decode_vertex_block(
+            const unsigned char* data,
+            const unsigned char* const data_end,
+            unsigned char* const destination,
+            const size_t vertex_count,
+            const size_t stride,
+            unsigned char* const last_vertex
+        )
+        {
+            const auto aligned_count = (vertex_count + byte_group_size - 1) & ~(byte_group_size - 1);
+            array<unsigned char, 256> deltas{};
+            for(size_t k = 0; k < stride; ++k)
+            {
+                data = decode_byte_groups(data, data_end, deltas.data(), aligned_count);
+
+                auto previous = last_vertex[k];
+                for(size_t i = 0; i < vertex_count; i += byte_group_size)
+                {
+                    array<unsigned char, byte_group_size> values;
+#ifdef MESHOPT_CODEC_SIMD
+                    //unzigzag, then a prefix sum in four shifted additions carried over from the previous group
+                    auto group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(deltas.data() + i));
+                    const auto& sign = _mm_sub_epi8(_mm_setzero_si128(), _mm_and_si128(group, _mm_set1_epi8(1)));
+                    group = _mm_xor_si128(_mm_and_si128(_mm_srli_epi16(group, 1), _mm_set1_epi8(0x7f)), sign);
+                    group = _mm_add_epi8(group, _mm_slli_si128(group, 1));
+                    group = _mm_add_epi8(group, _mm_slli_si128(group, 2));
+                    group = _mm_add_epi8(group, _mm_slli_si128(group, 4));
+                    group = _mm_add_epi8(group, _mm_slli_si128(group, 8));
+                    group = _mm_add_epi8(group, _mm_set1_epi8(static_cast<char>(previous)));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(values.data()), group);
+#else
+                    auto sum = previous;
+                    for(size_t j = 0; j < byte_group_size; ++j)
+                    {
+                        const auto delta = deltas[i + j];
+                        sum = static_cast<unsigned char>(sum + ((delta >> 1) ^ (0u - (delta & 1u))));
+                        values[j] = sum;
+                    }
+#endif
+                    const auto count = std::min(byte_group_size, vertex_count - i);
+                    for(size_t j = 0; j < count; ++j) destination[(i + j) * stride + k] = values[j];
+                    previous = values[count - 1];
+                }
+            }
+            std::memcpy(last_vertex, destination + (vertex_count - 1) * stride, stride);
+            return data;
+        }
+
+        void decode_vertices(
+            unsigned char* const destination,
+            const size_t count,
+            const size_t stride,
+            const pair<const unsigned char*, const unsigned char*>& source
+        )
+        {
+            auto [data, data_end] = source;
+            check(stride > 0 && stride <= 256 && stride % 4 == 0);
+            check(static_cast<size_t>(data_end - data) >= 1 + stride);
+            check((*data & 0xf0) == vertex_header && (*data & 0x0f) == 0);
+            ++data;
+
+            //the first vertex is predicted from the end of the tail
+            array<unsigned char, 256> last_vertex{};
+            std::memcpy(last_vertex.data(), data_end - stride, stride);
+
+            const auto block_size = meshopt_vertex_block_size(stride);
+            for(size_t first = 0; first < count; first += block_size)
+                data = decode_vertex_block(
+                    data,
+                    data_end,
+                    destination + first * stride,
+                    std::min(block_size, count - first),
+                    stride,
+                    last_vertex.data()
+                );
+            check(static_cast<size_t>(data_end - data) == std::max(stride, vertex_tail_min_size));
+        }
+
+        uint32_t decode_vbyte(const unsigned char*& data)
+        {
+            const auto lead = *data++;
+            if(lead < 128) return lead;
+
+            uint32_t value = lead & 127;
+            for(uint32_t shift = 7; shift < 35; shift += 7)
+            {
+                const auto group = *data++;
+                value |= static_cast<uint32_t>(group & 127) << shift;
+                if(group < 128) break;
+            }
+            return value;
+        }
+
+        //free indices are zigzag deltas to the last free index
+        uint32_t decode_index(const unsigned char*& data, const uint32_t last)
+        {
+            const auto value = decode_vbyte(data);
+            return last + ((value >> 1) ^ (0u - (value & 1)));
+        }
+
+        void write_index(unsigned char* const destination, const size_t index_size, const size_t i, const uint32_t index)
+        {
+            if(index_size == 2)
+            {
+                const auto narrowed = static_cast<uint16_t>(index);
+                std::memcpy(destination + i * 2, &narrowed, 2);
+            }
+            else std::memcpy(destination + i * 4, &index, 4);
+        }
+
+        //every triangle is a code byte naming its vertices by the edge and vertex fifos of the triangles before it,
+        //new vertices or free indices, the last 16 bytes are a table of common codes for new triangles
+        void decode_triangles(
+            unsigned char* const destination,
+            const size_t count,
+            const size_t index_size,
+            const pair<const unsigned char*, const unsigned char*>& source
+        )
+        {
+            const auto& [begin, end] = source;
+            check(count % 3 == 0 && (index_size == 2 || index_size == 4));
+            check(static_cast<size_t>(end - begin) >= 1 + count / 3 + 16);
+            check((*begin & 0xf0) == triangle_header && (*begin & 0x0f) <= 1);
+
+            const auto version = *begin & 0x0f;
+            //version 1 takes the codes 13 and 14 for free indices next to the last one
+            const uint32_t fifo_code_max = version >= 1 ? 13 : 15;
+
+            array<uint32_t, 16> vertex_fifo;
+            array<array<uint32_t, 2>, 16> edge_fifo;
+            vertex_fifo.fill(~0u);
+            edge_fifo.fill({~0u, ~0u});
+            size_t vertex_fifo_offset = 0;
+            size_t edge_fifo_offset = 0;
+            const auto push_vertex = [&vertex_fifo, &vertex_fifo_offset](const uint32_t v, const bool condition = true)
+            {
+                vertex_fifo[vertex_fifo_offset] = v;
+                vertex_fifo_offset = (vertex_fifo_offset + condition) & 15;
+            };
+            const auto push_edge = [&edge_fifo, &edge_fifo_offset](const uint32_t a, const uint32_t b)
+            {
+                edge_fifo[edge_fifo_offset] = {a, b};
+                edge_fifo_offset = (edge_fifo_offset + 1) & 15;
+            };
+
+            uint32_t next = 0;
+            uint32_t last = 0;
+            const auto* code = begin + 1;
+            const auto* data = code + count / 3;
+            const auto* const data_safe_end = end - 16;
+            const auto* const code_table = data_safe_end;
+
+            for(size_t i = 0; i < count; i += 3)
+            {
+                check(data <= data_safe_end);
+                const auto code_triangle = *code++;
+                uint32_t a;
+                uint32_t b;
+                uint32_t c;
+
+                //an edge of a recent triangle with a new, recent or free third vertex
+                if(code_triangle < 0xf0)
+                {
+                    const auto& edge = edge_fifo[(edge_fifo_offset - 1 - (code_triangle >> 4)) & 15];
+                    a = edge[0];
+                    b = edge[1];
+                    const uint32_t fifo_code = code_triangle & 15;
+                    if(fifo_code < fifo_code_max)
+                    {
+                        c = fifo_code == 0 ? next++ : vertex_fifo[(vertex_fifo_offset - 1 - fifo_code) & 15];
+                        push_vertex(c, fifo_code == 0);
+                    }
+                    else
+                    {
+                        //13 and 14 step the last free index by -1 and 1
+                        last = c = fifo_code != 15 ?
+                            last + static_cast<uint32_t>(static_cast<int>(fifo_code) - static_cast<int>(fifo_code ^ 3)) :
+                            decode_index(data, last);
+                        push_vertex(c);
+                    }
+                    push_edge(c, b);
+                    push_edge(a, c);
+                    write_index(destination, index_size, i, a);
+                    write_index(destination, index_size, i + 1, b);
+                    write_index(destination, index_size, i + 2, c);
+                    continue;
+                }
+
+                //a triangle with no known edge, its codes come from the table or the byte after the free indices
+                uint32_t code_aux;
+                uint32_t first_code;
+                if(code_triangle < 0xfe)
+                {
+                    code_aux = code_table[code_triangle & 15];
+                    first_code = 0;
+                }
+                else
+                {
+                    code_aux = *data++;
+                    first_code = code_triangle == 0xfe ? 0 : 15;
+                    if(code_aux == 0) next = 0;
+                }
+                const auto second_code = code_aux >> 4;
+                const auto third_code = code_aux & 15;
+
+                a = first_code == 0 ? next++ : 0;
+                b = second_code == 0 ? next++ : vertex_fifo[(vertex_fifo_offset - second_code) & 15];
+                c = third_code == 0 ? next++ : vertex_fifo[(vertex_fifo_offset - third_code) & 15];
+                if(first_code == 15) last = a = decode_index(data, last);
+                if(second_code == 15) last = b = decode_index(data, last);
+                if(third_code == 15) last = c = decode_index(data, last);
+
+                push_vertex(a);
+                push_vertex(b, second_code == 0 || second_code == 15);
+                push_vertex(c, third_code == 0 || third_code == 15);
+                push_edge(b, a);
+                push_edge(c, b);
+                push_edge(a, c);
+                write_index(destination, index_size, i, a);
+                write_index(destination, index_size, i + 1, b);
+                write_index(destination, index_size, i + 2, c);
+            }
+            check(data == data_safe_end);
+        }
+
+        //every index is a zigzag delta to one of two baselines, the low bit of its varint picks the baseline
+        void decode_index_sequence(
+            unsigned char* const destination,
+            const size_t count,
+            const size_t index_size,
+            const pair<const unsigned char*, const unsigned char*>& source
+        )
+        {
+            const auto& [begin, end] = source;
+            check(index_size == 2 || index_size == 4);
+            check(static_cast<size_t>(end - begin) >= 1 + count + 4);
+            check((*begin & 0xf0) == sequence_header && (*begin & 0x0f) <= 1);
+
+            array<uint32_t, 2> last{};
+            const auto* data = begin + 1;
+            const auto* const data_safe_end = end - 4;
+            for(size_t i = 0; i < count; ++i)
+            {
+                check(data < data_safe_end);
+                auto value = decode_vbyte(data);
+                const auto baseline = value & 1;
+                value >>= 1;
+                last[baseline] += (value >> 1) ^ (0u - (value & 1));
+                write_index(destination, index_size, i, last[baseline]);
+            }
+            check(data == data_safe_end);
+        }
+
+        template<typename T>
+        void filter_octahedral(unsigned char* const data, const size_t count)
+        {
+            constexpr auto max = static_cast<float>(::utility::constant::numeric::numberic_max<T>);
+            for(size_t i = 0; i < count; ++i)
+            {
+                array<T, 4> components;
+                std::memcpy(components.data(), data + i * sizeof(components), sizeof(components));
+
+                //the third component holds one at the same precision, z is what the octahedron leaves of it
+                auto x = static_cast<float>(components[0]);
+                auto y = static_cast<float>(components[1]);
+                const auto z = static_cast<float>(components[2]) - std::abs(x) - std::abs(y);
+                const auto t = std::min(z, 0.0f);
+                x += x >= 0 ? t : -t;
+                y += y >= 0 ? t : -t;
+
+                const auto scale = max / std::sqrt(x * x + y * y + z * z);
+                components[0] = static_cast<T>(std::lround(x * scale));
+                components[1] = static_cast<T>(std::lround(y * scale));
+                components[2] = static_cast<T>(std::lround(z * scale));
+                std::memcpy(data + i * sizeof(components), components.data(), sizeof(components));
+            }
+        }
+
+        //the largest component is dropped and its index kept in the low bits of the fourth,
+        //whose other bits scale the remaining three
+        void filter_quaternion(unsigned char* const data, const size_t count)
+        {
+            for(size_t i = 0; i < count; ++i)
+            {
+                array<int16_t, 4> components;
+                std::memcpy(components.data(), data + i * sizeof(components), sizeof(components));
+
+                const auto scale = 1 / std::sqrt(2.0f) / static_cast<float>(components[3] | 3);
+                const auto x = static_cast<float>(components[0]) * scale;
+                const auto y = static_cast<float>(components[1]) * scale;
+                const auto z = static_cast<float>(components[2]) * scale;
+                const auto w = std::sqrt(std::max(1 - x * x - y * y - z * z, 0.0f));
+
+                const auto dropped = components[3] & 3;
+                components[(dropped + 1) & 3] = static_cast<int16_t>(std::lround(x * 32767));
+                components[(dropped + 2) & 3] = static_cast<int16_t>(std::lround(y * 32767));
+                components[(dropped + 3) & 3] = static_cast<int16_t>(std::lround(z * 32767));
+                components[dropped] = static_cast<int16_t>(std::lround(w * 32767));
+                std::memcpy(data + i * sizeof(components), components.data(), sizeof(components));
+            }
+        }
+
+        //a 24 bit signed mantissa and an 8 bit signed exponent per 32 bit value
+        void filter_exponential(unsigned char* const data, const size_t count)
+        {
+            size_t i = 0;
+#ifdef MESHOPT_CODEC_SIMD
+            for(; i + 4 <= count; i += 4)
+            {
+                auto* const values = reinterpret_cast<__m128i*>(data + i * 4);
+                const auto& encoded = _mm_loadu_si128(values);
+                const auto& mantissa = _mm_srai_epi32(_mm_slli_epi32(encoded, 8), 8);
+                const auto& exponent = _mm_srai_epi32(encoded, 24);
+                const auto& power = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(exponent, _mm_set1_epi32(127)), 23));
+                _mm_storeu_si128(values, _mm_castps_si128(_mm_mul_ps(power, _mm_cvtepi32_ps(mantissa))));
+            }
+#endif
+            for(; i < count; ++i)
+            {
+                int32_t encoded;
+                std::memcpy(&encoded, data + i * 4, 4);
+                const auto mantissa = static_cast<int32_t>(static_cast<uint32_t>(encoded) << 8) >> 8;
+                const auto power_bits = static_cast<uint32_t>((encoded >> 24) + 127) << 23;
+                float power;
+                std::memcpy(&power, &power_bits, 4);
+                const auto value = power * static_cast<float>(mantissa);
+                std::memcpy(data + i * 4, &value, 4);
+            }
+        }
+    }
+
+    meshopt_mode to_meshopt_mode(const string& name)
+    {
+        if(name == "ATTRIBUTES") return meshopt_mode::attributes;
+        if(name == "TRIANGLES") return meshopt_mode::triangles;
+        if(name == "INDICES") return meshopt_mode::indices;
+        throw std::runtime_error{"meshopt compression mode is not supported: " + name};
+    }
+
+    meshopt_filter to_meshopt_filter(const string& name)
+    {
+        if(name.empty() || name == "NONE") return meshopt_filter::none;
+        if(name == "OCTAHEDRAL") return meshopt_filter::octahedral;
+        if(name == "QUATERNION") return meshopt_filter::quaternion;
+        if(name == "EXPONENTIAL") return meshopt_filter::exponential;
+        throw std::runtime_error{"meshopt compression filter is not supported: " + name};
+    }
+
+    void decode_meshopt(
+        unsigned char* const destination,
+        const size_t count,
+        const size_t stride,
+        const pair<const unsigned char*, const unsigned char*>& source,
+        const meshopt_mode mode,
+        const meshopt_filter filter
+    )
+    {
+        if(count == 0) return;
+
+        switch(mode)
+        {
+        case meshopt_mode::attributes: decode_vertices(destination, count, stride, source);
+            break;
+        case meshopt_mode::triangles: decode_triangles(destination, count, stride, source);
+            break;
+        case meshopt_mode::indices: decode_index_sequence(destination, count, stride, source);
+            break;
+        }
+
+        switch(filter)
+        {
+        case meshopt_filter::none: break;
+        case meshopt_filter::octahedral:
+            check(mode == meshopt_mode::attributes && (stride == 4 || stride == 8));
+            if(stride == 4) filter_octahedral<int8_t>(destination, count);
+            else filter_octahedral<int16_t>(destination, count);
+            break;
+        case meshopt_filter::quaternion:
+            check(mode == meshopt_mode::attributes && stride == 8);
+            filter_quaternion(destination, count);
+            break;
+        case meshopt_filter::exponential:
+            check(mode == meshopt_mode::attributes);
+            filter_exponential(destination, count * stride / 4);
+            break;
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "vulkan/utility/utility_core.h"
+
+namespace vulkan::utility
+{
+    //how a buffer view of EXT_meshopt_compression is encoded, attributes are any interleaved vertex data,
+    //triangles and indices are index lists of two or four bytes
+    enum class meshopt_mode
+    {
+        attributes,
+        triangles,
+        indices
+    };
+
+    //applied to the decoded attributes, octahedral normals and quaternions expand their dropped component
+    //and exponential values turn into floats
+    enum class meshopt_filter
+    {
+        none,
+        octahedral,
+        quaternion,
+        exponential
+    };
+
+    [[nodiscard]] meshopt_mode to_meshopt_mode(const string&);
+    [[nodiscard]] meshopt_filter to_meshopt_filter(const string&);
+
+    //vertices the attribute codec encodes in one block, 16 byte groups fitting an 8KB block
+    [[nodiscard]] constexpr size_t meshopt_vertex_block_size(const size_t) noexcept;
+
+    //decodes the count elements of the stride into the destination, which has to hold count * stride bytes,
+    //throws on malformed data
+    void decode_meshopt(
+        unsigned char*,
+        const size_t,
+        const size_t,
+        const pair<const unsigned char*, const unsigned char*>&,
+        const meshopt_mode,
+        const meshopt_filter = meshopt_filter::none
+    );
+}
+
+#include "meshopt_codec.tpp"
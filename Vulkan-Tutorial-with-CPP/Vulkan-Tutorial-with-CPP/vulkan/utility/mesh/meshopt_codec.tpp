@@ -0,0 +1,9 @@
+#pragma once
+
+namespace vulkan::utility
+{
+    constexpr size_t meshopt_vertex_block_size(const size_t stride) noexcept
+    {
+        return std::min(8192 / stride & ~size_t{15}, size_t{256});
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "vulkan/utility/utility_core.h"
+
+namespace vulkan::utility
+{
+    //what the tangent of a vertex is derived from, the texture coordinate is the set the normal texture uses
+    struct tangent_source_vertex
+    {
+        vec3 position;
+        vec3 normal;
+        vec2 texture_coordinate;
+    };
+
+    //mikktspace-like tangents of the vertices of the triangles the indices list, each an angle weighted sum of the
+    //tangents of its triangles, it does not group corners or merge tangent spaces by the mikktspace rules, so a baker
+    //using those may disagree slightly on shared vertices, xyz is the tangent and w the sign that
+    //makes cross(normal, tangent) * w the bitangent, the function gives the source vertex of an index,
+    //vertices no triangle with texture area reaches get any tangent perpendicular to their normal
+    //
+    //a vertex shared by triangles that keep and mirror the texture is split, the side with the smaller angle
+    //around it moves to a duplicate appended after the vertices and its indices are rewritten in place,
+    //returns the tangents of the vertices and their duplicates along with the vertex each duplicate copies
+    template<typename VertexFunc>
+    [[nodiscard]] pair<vector<vec4>, vector<uint32_t>> generate_tangents(
+        uint32_t*,
+        uint32_t*,
+        const size_t,
+        VertexFunc&&
+    );
+}
+
+#include "tangent.tpp"
@@ -0,0 +1,122 @@
+#pragma once
+
+namespace vulkan::utility
+{
+    template<typename VertexFunc>
+    pair<vector<vec4>, vector<uint32_t>> generate_tangents(
+        uint32_t* const begin,
+        uint32_t* const end,
+        const size_t vertex_count,
+        VertexFunc&& vertex_func
+    )
+    {
+        //triangles that keep the orientation of the texture and those that mirror it are summed apart,
+        //so the two are never blended, each with the corner angles it was weighted by
+        struct tangent_sum
+        {
+            array<vec3, 2> tangents{vec3{0}, vec3{0}};
+            array<float, 2> weights{};
+        };
+
+        const auto project = [](const vec3& direction, const vec3& normal)
+        {
+            return direction - dot(normal, direction) * normal;
+        };
+        const auto normalize_or_zero = [](const vec3& direction)
+        {
+            const auto direction_length = length(direction);
+            return direction_length > 0 ? direction / direction_length : vec3{0};
+        };
+
+        //triangles without texture area have no orientation and stay on the vertices they index
+        static constexpr uint8_t no_orientation = 2;
+
+        vector<tangent_sum> sums(vertex_count);
+        const auto index_count = static_cast<size_t>(end - begin) / 3 * 3;
+        vector<uint8_t> orientations(index_count / 3, no_orientation);
+        for(size_t i = 0; i < index_count; i += 3)
+        {
+            const array<uint32_t, 3> corners{begin[i], begin[i + 1], begin[i + 2]};
+            if(corners[0] == corners[1] || corners[1] == corners[2] || corners[2] == corners[0]) continue;
+
+            const array<tangent_source_vertex, 3> triangle{
+                vertex_func(corners[0]),
+                vertex_func(corners[1]),
+                vertex_func(corners[2])
+            };
+            const auto& first_edge = triangle[1].position - triangle[0].position;
+            const auto& second_edge = triangle[2].position - triangle[0].position;
+            const auto& first_uv_edge = triangle[1].texture_coordinate - triangle[0].texture_coordinate;
+            const auto& second_uv_edge = triangle[2].texture_coordinate - triangle[0].texture_coordinate;
+
+            //triangles without texture area have no tangent of their own
+            const auto signed_area = first_uv_edge.x * second_uv_edge.y - first_uv_edge.y * second_uv_edge.x;
+            if(std::abs(signed_area) <= ::utility::constant::numeric::numberic_min<float>) continue;
+
+            const size_t orientation = signed_area > 0 ? 1 : 0;
+            orientations[i / 3] = static_cast<uint8_t>(orientation);
+            const auto& triangle_tangent = normalize_or_zero(
+                (second_uv_edge.y * first_edge - first_uv_edge.y * second_edge) * (signed_area > 0 ? 1.0f : -1.0f)
+            );
+
+            //the tangent and the corner angle are taken in the tangent plane of the corner
+            for(size_t j = 0; j < corners.size(); ++j)
+            {
+                const auto& current = triangle[j];
+                const auto& to_next = normalize_or_zero(
+                    project(triangle[(j + 1) % 3].position - current.position, current.normal)
+                );
+                const auto& to_previous = normalize_or_zero(
+                    project(triangle[(j + 2) % 3].position - current.position, current.normal)
+                );
+                const auto angle = std::acos(std::clamp(dot(to_next, to_previous), -1.0f, 1.0f));
+
+                auto& sum = sums[corners[j]];
+                sum.tangents[orientation] += angle * normalize_or_zero(project(triangle_tangent, current.normal));
+                sum.weights[orientation] += angle;
+            }
+        }
+
+        const auto make_tangent = [&](const size_t vertex, const size_t orientation)
+        {
+            auto tangent = normalize_or_zero(sums[vertex].tangents[orientation]);
+            if(tangent == vec3{0})
+            {
+                const auto& normal = vertex_func(static_cast<uint32_t>(vertex)).normal;
+                tangent = normalize_or_zero(project(std::abs(normal.x) < 0.9f ? vec3{1, 0, 0} : vec3{0, 1, 0}, normal));
+                if(tangent == vec3{0}) tangent = {1, 0, 0};
+            }
+            return vec4{tangent, orientation == 1 ? 1.0f : -1.0f};
+        };
+
+        pair<vector<vec4>, vector<uint32_t>> result;
+        auto& [tangents, duplicates] = result;
+        tangents.resize(vertex_count);
+        vector<uint8_t> kept_orientations(vertex_count);
+        vector<uint32_t> duplicate_positions(vertex_count, 0);
+        for(size_t i = 0; i < vertex_count; ++i)
+        {
+            const auto& sum = sums[i];
+            const size_t orientation = sum.weights[1] >= sum.weights[0] ? 1 : 0;
+            kept_orientations[i] = static_cast<uint8_t>(orientation);
+            tangents[i] = make_tangent(i, orientation);
+            if(sum.weights[1 - orientation] <= 0) continue;
+
+            duplicate_positions[i] = static_cast<uint32_t>(tangents.size());
+            duplicates.push_back(static_cast<uint32_t>(i));
+            tangents.push_back(make_tangent(i, 1 - orientation));
+        }
+
+        //the corners of the side that lost a split vertex move to its duplicate
+        if(!duplicates.empty())
+            for(size_t i = 0; i < index_count; ++i)
+            {
+                const auto orientation = orientations[i / 3];
+                auto& index = begin[i];
+                if(orientation != no_orientation && duplicate_positions[index] != 0 &&
+                    orientation != kept_orientations[index])
+                    index = duplicate_positions[index];
+            }
+        return result;
+    }
+}
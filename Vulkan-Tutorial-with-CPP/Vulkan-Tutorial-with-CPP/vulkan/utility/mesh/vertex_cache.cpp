@@ -0,0 +1,138 @@
+#include "vertex_cache.h"
+
+namespace vulkan::utility
+{
+    float average_cache_miss_ratio(const uint32_t* const begin, const uint32_t* const end, const uint32_t cache_size)
+    {
+        const auto triangle_count = static_cast<size_t>(end - begin) / 3;
+        if(triangle_count == 0) return 0;
+
+        //a vertex stays cached until cache_size misses followed the one that loaded it, zero is never loaded
+        vector<size_t> loaded(*std::max_element(begin, end) + size_t{1}, 0);
+        size_t misses = 0;
+        for(auto it = begin; it != begin + triangle_count * 3; ++it)
+        {
+            auto& loaded_at = loaded[*it];
+            if(loaded_at != 0 && misses - loaded_at < cache_size) continue;
+            loaded_at = ++misses;
+        }
+        return static_cast<float>(misses) / static_cast<float>(triangle_count);
+    }
+
+    vector<size_t> optimize_vertex_cache(
+        uint32_t* const begin,
+        uint32_t* const end,
+        const size_t vertex_count,
+        const uint32_t cache_size
+    )
+    {
+        const auto triangle_count = static_cast<size_t>(end - begin) / 3;
+        vector<size_t> clusters;
+        if(triangle_count == 0) return clusters;
+
+        //triangles around every vertex, packed in one array with an offset per vertex
+        vector<uint32_t> live_triangles(vertex_count, 0);
+        for(auto it = begin; it != begin + triangle_count * 3; ++it) ++live_triangles[*it];
+
+        vector<size_t> adjacency_offsets(vertex_count + 1, 0);
+        for(size_t i = 0; i < vertex_count; ++i)
+            adjacency_offsets[i + 1] = adjacency_offsets[i] + live_triangles[i];
+
+        vector<uint32_t> adjacency(adjacency_offsets.back());
+        {
+            auto cursors = adjacency_offsets;
+            for(size_t i = 0; i < triangle_count * 3; ++i)
+                adjacency[cursors[begin[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+
+        vector<size_t> cache_time(vertex_count, 0);
+        vector<bool> emitted(triangle_count, false);
+        vector<uint32_t> dead_ends;
+        vector<uint32_t> candidates;
+        vector<uint32_t> output;
+        output.reserve(triangle_count * 3);
+        auto time = size_t{cache_size} + 1;
+        size_t cursor = 0;
+
+        //the latest vertex with live triangles on the dead end stack, otherwise the next one in input order
+        const auto skip_dead_end = [&]() -> int64_t
+        {
+            while(!dead_ends.empty())
+            {
+                const auto vertex = dead_ends.back();
+                dead_ends.pop_back();
+                if(live_triangles[vertex] > 0) return vertex;
+            }
+            for(; cursor < vertex_count; ++cursor)
+                if(live_triangles[cursor] > 0) return static_cast<int64_t>(cursor);
+            return -1;
+        };
+
+        clusters.push_back(0);
+        for(auto fanning = skip_dead_end(); fanning >= 0;)
+        {
+            candidates.clear();
+            for(auto i = adjacency_offsets[fanning]; i < adjacency_offsets[fanning + 1]; ++i)
+            {
+                const auto triangle = adjacency[i];
+                if(emitted[triangle]) continue;
+
+                for(size_t j = 0; j < 3; ++j)
+                {
+                    const auto vertex = begin[triangle * 3 + j];
+                    output.push_back(vertex);
+                    dead_ends.push_back(vertex);
+                    candidates.push_back(vertex);
+                    --live_triangles[vertex];
+                    if(time - cache_time[vertex] > cache_size) cache_time[vertex] = time++;
+                }
+                emitted[triangle] = true;
+            }
+
+            //the next fan is the candidate that is still cached after its remaining triangles are emitted,
+            //the oldest one of them so that it is used before it falls out
+            int64_t next = -1;
+            int64_t best_priority = -1;
+            for(const auto vertex : candidates)
+            {
+                if(live_triangles[vertex] == 0) continue;
+
+                int64_t priority = 0;
+                if(time - cache_time[vertex] + 2 * live_triangles[vertex] <= cache_size)
+                    priority = static_cast<int64_t>(time - cache_time[vertex]);
+                if(priority > best_priority)
+                {
+                    best_priority = priority;
+                    next = vertex;
+                }
+            }
+
+            if(next < 0)
+            {
+                next = skip_dead_end();
+                if(next >= 0) clusters.push_back(output.size());
+            }
+            fanning = next;
+        }
+
+        std::copy(output.cbegin(), output.cend(), begin);
+        return clusters;
+    }
+
+    vector<uint32_t> optimize_vertex_fetch(uint32_t* const begin, uint32_t* const end, const size_t vertex_count)
+    {
+        static constexpr auto unused = UINT32_MAX;
+
+        vector<uint32_t> remap(vertex_count, unused);
+        uint32_t next = 0;
+        for(auto it = begin; it != end; ++it)
+        {
+            auto& index = remap[*it];
+            if(index == unused) index = next++;
+            *it = index;
+        }
+        for(auto& index : remap)
+            if(index == unused) index = next++;
+        return remap;
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "vulkan/utility/utility_core.h"
+
+namespace vulkan::utility
+{
+    //fifo size of the post-transform cache the triangle order is tuned for
+    inline constexpr uint32_t vertex_cache_size = 16;
+
+    //vertices shaded per triangle by a fifo post-transform cache, between 0.5 for an ideal mesh and 3
+    [[nodiscard]] float average_cache_miss_ratio(const uint32_t*, const uint32_t*, const uint32_t = vertex_cache_size);
+
+    //reorders the triangles in place with tipsify for the post-transform cache,
+    //returns the first index of every cluster, a new cluster starts wherever the fan hit a dead end
+    [[nodiscard]] vector<size_t> optimize_vertex_cache(
+        uint32_t*,
+        uint32_t*,
+        const size_t,
+        const uint32_t = vertex_cache_size
+    );
+
+    //sorts the clusters so that the ones facing away from the mesh center are drawn first and occlude the rest,
+    //triangles keep their order inside a cluster, so the cache efficiency is kept
+    template<typename PositionFunc>
+    void optimize_overdraw(uint32_t*, uint32_t*, const vector<size_t>&, PositionFunc&&);
+
+    //renumbers the vertices in the order the indices first use them and returns the new index of every old vertex,
+    //unreferenced vertices go to the end
+    [[nodiscard]] vector<uint32_t> optimize_vertex_fetch(uint32_t*, uint32_t*, const size_t);
+}
+
+#include "vertex_cache.tpp"
@@ -0,0 +1,75 @@
+#pragma once
+
+namespace vulkan::utility
+{
+    template<typename PositionFunc>
+    void optimize_overdraw(
+        uint32_t* const begin,
+        uint32_t* const end,
+        const vector<size_t>& clusters,
+        PositionFunc&& position_func
+    )
+    {
+        if(clusters.size() < 2) return;
+
+        struct cluster
+        {
+            size_t begin;
+            size_t end;
+            vec3 centroid;
+            vec3 normal;
+            float facing;
+        };
+
+        const auto index_count = static_cast<size_t>(end - begin) / 3 * 3;
+        vector<cluster> sorted;
+        sorted.reserve(clusters.size());
+
+        //centroids are area weighted, so a few large triangles are not outvoted by many slivers
+        vec3 mesh_centroid{0};
+        float mesh_area = 0;
+        for(size_t i = 0; i < clusters.size(); ++i)
+        {
+            auto& current = sorted.emplace_back(
+                cluster{clusters[i], i + 1 < clusters.size() ? clusters[i + 1] : index_count, vec3{0}, vec3{0}, 0}
+            );
+
+            float area = 0;
+            for(auto j = current.begin; j < current.end; j += 3)
+            {
+                const vec3 a = position_func(begin[j]);
+                const vec3 b = position_func(begin[j + 1]);
+                const vec3 c = position_func(begin[j + 2]);
+                const auto& cross_product = cross(b - a, c - a);
+                const auto triangle_area = length(cross_product);
+
+                current.centroid += (a + b + c) / 3.0f * triangle_area;
+                current.normal += cross_product;
+                area += triangle_area;
+            }
+
+            mesh_centroid += current.centroid;
+            mesh_area += area;
+            current.centroid = area > 0 ? current.centroid / area : vec3{position_func(begin[current.begin])};
+        }
+        if(mesh_area > 0) mesh_centroid /= mesh_area;
+
+        for(auto& current : sorted)
+        {
+            const auto normal_length = length(current.normal);
+            current.facing = normal_length > 0 ?
+                dot(current.centroid - mesh_centroid, current.normal / normal_length) :
+                0;
+        }
+        std::stable_sort(
+            sorted.begin(),
+            sorted.end(),
+            [](const cluster& left, const cluster& right) { return left.facing > right.facing; }
+        );
+
+        vector<uint32_t> reordered;
+        reordered.reserve(index_count);
+        for(const auto& current : sorted) reordered.insert(reordered.cend(), begin + current.begin, begin + current.end);
+        std::copy(reordered.cbegin(), reordered.cend(), begin);
+    }
+}
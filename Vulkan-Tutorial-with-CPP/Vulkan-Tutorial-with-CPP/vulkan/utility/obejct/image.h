@@ -3,7 +3,14 @@
 
 namespace vulkan::utility
 {
-    constexpr auto to_image_view_type(const ImageType image_type);
+    constexpr auto to_image_view_type(const ImageType image_type, const bool is_array = false);
+
+    [[nodiscard]] constexpr uint32_t mip_levels(const Extent3D) noexcept;
+
+    [[nodiscard]] constexpr Extent3D mip_level_extent(const Extent3D, const uint32_t) noexcept;
+
+    //count of texels stored before the level in a tightly packed mip chain
+    [[nodiscard]] constexpr DeviceSize mip_level_texel_offset(const Extent3D, const uint32_t) noexcept;
 
     [[nodiscard]] pair<device_memory_object, vector<DeviceSize>> generate_image_memory_info(
         const device_object&,
@@ -35,9 +42,14 @@ namespace vulkan::utility
 
         image_view_object image_view_;
 
+        //staging memory stays mapped from initialization until the memory is freed
+        constant::format_t<format_value>* staging_ = nullptr;
+
     public:
         static constexpr auto max_anisotropy = 16;
 
+        [[nodiscard]] static constexpr DeviceSize mip_level_offset(const Extent3D, const uint32_t) noexcept;
+
         constexpr texture_image() noexcept = default;
 
         constexpr texture_image(
@@ -48,16 +60,19 @@ namespace vulkan::utility
             const optional<
                 pair<decltype(ImageCreateInfo::mipLevels), decltype(ImageCreateInfo::arrayLayers)>
             >& = {},
-            const optional<SampleCountFlagBits>  = {}
+            const optional<SampleCountFlagBits>  = {},
+            const bool is_array = false
         ) noexcept;
 
         void initialize(const device_object& device_object, const PhysicalDevice physical_device);
 
+        //writes texels packed level after level, starting at the given level of one array layer
         template<typename Input>
         void write_from_src(
-            const device_object&,
             const Input&,
-            const Input& end
+            const Input& end,
+            const uint32_t mip_level = 0,
+            const uint32_t array_layer = 0
         ) const;
 
         void write_transfer_command(const device_object& device_object, const CommandBuffer&) const;
@@ -65,6 +80,9 @@ namespace vulkan::utility
 
         void write_blit_command(const device_object& device_object, const CommandBuffer&) const;
 
+        //frees the staging buffer once its transfer command has completed
+        void release_staging();
+
         constexpr const auto& buffer() const;
 
         constexpr const auto& buffer_memory() const;
@@ -3,17 +3,55 @@
 
 namespace vulkan::utility
 {
-    constexpr auto to_image_view_type(const ImageType image_type)
+    constexpr auto to_image_view_type(const ImageType image_type, const bool is_array)
     {
         switch(image_type)
         {
-        case ImageType::e1D: return ImageViewType::e1D;
-        case ImageType::e2D: return ImageViewType::e2D;
-        case ImageType::e3D: return ImageViewType::e3D;
+        case ImageType::e1D: return is_array ? ImageViewType::e1DArray : ImageViewType::e1D;
+        case ImageType::e2D: return is_array ? ImageViewType::e2DArray : ImageViewType::e2D;
+        case ImageType::e3D:
+            if(is_array) throw std::invalid_argument{"3d image cannot be viewed as an array"};
+            return ImageViewType::e3D;
         }
         throw std::invalid_argument{"unknown image type"};
     }
 
+    constexpr uint32_t mip_levels(const Extent3D extent) noexcept
+    {
+        uint32_t levels = 1;
+        for(auto size = std::max({extent.width, extent.height, extent.depth}); size > 1; size >>= 1) ++levels;
+        return levels;
+    }
+
+    constexpr Extent3D mip_level_extent(const Extent3D extent, const uint32_t level) noexcept
+    {
+        return {
+            std::max(extent.width >> level, 1u),
+            std::max(extent.height >> level, 1u),
+            std::max(extent.depth >> level, 1u)
+        };
+    }
+
+    constexpr DeviceSize mip_level_texel_offset(const Extent3D extent, const uint32_t level) noexcept
+    {
+        DeviceSize offset = 0;
+        for(uint32_t i = 0; i < level; ++i)
+        {
+            const auto& level_extent = mip_level_extent(extent, i);
+            offset += DeviceSize{level_extent.width} * level_extent.height * level_extent.depth;
+        }
+        return offset;
+    }
+
+    template<Format FormatValue>
+    constexpr DeviceSize texture_image<FormatValue>::mip_level_offset(
+        const Extent3D extent,
+        const uint32_t level
+    ) noexcept
+    {
+        return mip_level_texel_offset(extent, level) * sizeof(constant::format_t<format_value>);
+    }
+
     template<Format FormatValue>
     constexpr texture_image<FormatValue>::texture_image(
         const ImageType image_type,
@@ -24,12 +62,13 @@ namespace vulkan::utility
             decltype(ImageCreateInfo::mipLevels),
             decltype(ImageCreateInfo::arrayLayers)
         >>& mipmap,
-        const optional<SampleCountFlagBits> sampler_count
+        const optional<SampleCountFlagBits> sampler_count,
+        const bool is_array
     ) noexcept :
         buffer_(
             BufferCreateInfo{
                 {},
-                extent.width * extent.height * sizeof(constant::format_t<format_value>),
+                mip_level_offset(extent, mipmap ? mipmap->first : 1) * (mipmap ? mipmap->second : 1),
                 BufferUsageFlagBits::eTransferSrc
             }
         ),
@@ -52,7 +91,7 @@ namespace vulkan::utility
             image_view_object::base_info_type{
                 {},
                 nullptr,
-                to_image_view_type(image_type),
+                to_image_view_type(image_type, is_array),
                 format_value,
                 component ? *component : ComponentMapping{},
                 {
@@ -85,6 +124,13 @@ namespace vulkan::utility
             0,
             device_object.dispatch()
         );
+        staging_ = static_cast<decltype(staging_)>(device_object->mapMemory(
+            *buffer_memory_,
+            0,
+            constant::whole_size<DeviceSize>,
+            {},
+            device_object.dispatch()
+        ));
 
         image_.initialize(device_object);
         image_memory_ = generate_image_memory_info(
@@ -107,16 +153,40 @@ namespace vulkan::utility
     template<Format FormatValue>
     template<typename Input>
     void texture_image<FormatValue>::write_from_src(
-        const device_object& device_object,
         const Input& begin,
-        const Input& end
+        const Input& end,
+        const uint32_t mip_level,
+        const uint32_t array_layer
     ) const
     {
         using input_data_type = std::decay_t<decltype(*begin)>;
 
         static_assert(std::is_same_v<input_data_type, constant::format_t<format_value>>,
             "Input image data not compatible");
-        write(buffer_memory_, device_object, begin, end);
+
+        const auto& info = image_.info().info;
+        if(!staging_) throw std::runtime_error{"texture image is not initialized"};
+        if(array_layer >= info.arrayLayers) throw std::out_of_range{"array layer is out of image range"};
+
+        //each level holds its layers one after another, so a layer's chain is scattered level by level
+        auto it = begin;
+        for(auto level = mip_level; it != end; ++level)
+        {
+            if(level >= info.mipLevels) throw std::runtime_error("data size is out of destination memory range");
+
+            const auto& level_extent = mip_level_extent(info.extent, level);
+            const auto level_size = DeviceSize{level_extent.width} * level_extent.height * level_extent.depth;
+            const auto next = std::next(
+                it,
+                static_cast<std::ptrdiff_t>(std::min(level_size, static_cast<DeviceSize>(std::distance(it, end))))
+            );
+            std::copy(
+                it,
+                next,
+                staging_ + mip_level_texel_offset(info.extent, level) * info.arrayLayers + level_size * array_layer
+            );
+            it = next;
+        }
     }
 
     template<Format FormatValue>
@@ -126,6 +196,7 @@ namespace vulkan::utility
     ) const
     {
         const ImageSubresourceRange& sub_resource_range = image_view_.info().subresourceRange;
+        const auto& extent = image_.info().info.extent;
 
         write_transfer_image_layout_command(
             command_buffer,
@@ -136,25 +207,35 @@ namespace vulkan::utility
             device_object.dispatch()
         );
 
-        command_buffer.copyBufferToImage(
-            *buffer_,
-            *image_,
-            ImageLayout::eTransferDstOptimal,
+        //the staging buffer holds the whole mip chain tightly packed, level after level
+        vector<BufferImageCopy> regions(sub_resource_range.levelCount);
+        std::generate(
+            regions.begin(),
+            regions.end(),
+            [&, level = sub_resource_range.baseMipLevel]() mutable -> BufferImageCopy
             {
-                {
-                    0,
+                const auto offset = mip_level_offset(extent, level) * sub_resource_range.layerCount;
+                return {
+                    offset,
                     0,
                     0,
                     {
                         sub_resource_range.aspectMask,
-                        sub_resource_range.baseMipLevel,
+                        level,
                         sub_resource_range.baseArrayLayer,
                         sub_resource_range.layerCount
                     },
                     {0, 0, 0},
-                    image_.info().info.extent
-                }
-            },
+                    mip_level_extent(extent, level++)
+                };
+            }
+        );
+
+        command_buffer.copyBufferToImage(
+            *buffer_,
+            *image_,
+            ImageLayout::eTransferDstOptimal,
+            regions,
             device_object.dispatch()
         );
     }
@@ -169,7 +250,13 @@ namespace vulkan::utility
         auto mip_width = image_.info().info.width;
         auto mip_height = image_.info().info.height;
 
-        ImageSubresourceRange mip_sub_range = {sub_resource_range.aspectMask, 0, 1, sub_resource_range.baseArrayLayer};
+        ImageSubresourceRange mip_sub_range = {
+            sub_resource_range.aspectMask,
+            0,
+            1,
+            sub_resource_range.baseArrayLayer,
+            sub_resource_range.layerCount
+        };
 
         for(decltype(image_.info().info.mipLevels) i = 1; i < image_.info().info.mipLevels; ++i)
         {
@@ -197,14 +284,14 @@ namespace vulkan::utility
                         sub_resource_range.aspectMask,
                         i - 1,
                         sub_resource_range.baseArrayLayer,
-                        1
+                        sub_resource_range.layerCount
                     },
                     {Offset3D{}, Offset3D{mip_width, mip_height, 1}},
                     {
                         sub_resource_range.aspectMask,
                         i,
                         sub_resource_range.baseArrayLayer,
-                        1
+                        sub_resource_range.layerCount
                     },
                     {Offset3D{}, Offset3D{next_mip_width, next_mip_height, 1}}
                 },
@@ -223,6 +310,14 @@ namespace vulkan::utility
         }
     }
 
+    template<Format FormatValue>
+    void texture_image<FormatValue>::release_staging()
+    {
+        staging_ = nullptr;
+        buffer_ = nullptr;
+        buffer_memory_ = nullptr;
+    }
+
     template<Format FormatValue>
     constexpr const auto& texture_image<FormatValue>::buffer() const { return buffer_; }
 
@@ -225,6 +225,19 @@ namespace vulkan::utility
         ));
     }
 
+    template<>
+    auto object<ComputePipeline>::create_unique_handle(
+        const owner_type& owner,
+        const dispatch_type& dispatch,
+        const base_info_type& info,
+        const optional<AllocationCallbacks>& allocator
+    ) -> base::base
+    {
+        return base::base{
+            owner.createComputePipelineUnique(info.cache, info, allocator ? Optional{*allocator} : nullptr, dispatch)
+        };
+    }
+
     template<>
     auto pool_object<DescriptorPool>::create_element_unique_handles(
         const owner_type& owner,
@@ -278,4 +291,41 @@ namespace vulkan::utility
         dispatch_ = dispatch;
         dispatch_.init(**this);
     }
+
+    compact_vertex::compact_vertex(
+        const vec3 position,
+        const vec3 surface_normal,
+        const vec2 uv,
+        const vec4 surface_tangent,
+        const pair<vec3, vec3>& bounds
+    ) noexcept :
+        pos(
+            packUnorm<uint16_t>(
+                vec4{(position - bounds.first) / quantization_extent(bounds), surface_tangent.w < 0 ? 0 : 1}
+            )
+        ),
+        normal(octahedral(surface_normal)),
+        texture_coordinate(packHalf1x16(uv.x), packHalf1x16(uv.y)),
+        tangent(octahedral(vec3{surface_tangent})) {}
+
+    i16vec2 compact_vertex::octahedral(const vec3& direction) noexcept
+    {
+        const auto& octahedron = direction / std::max(abs(direction.x) + abs(direction.y) + abs(direction.z), 1e-6f);
+        vec2 folded{octahedron};
+        if(octahedron.z < 0)
+            folded = (1.0f - abs(vec2{octahedron.y, octahedron.x})) *
+                vec2{octahedron.x >= 0 ? 1.0f : -1.0f, octahedron.y >= 0 ? 1.0f : -1.0f};
+        return packSnorm<int16_t>(folded);
+    }
+
+    mat4 compact_vertex::dequantize_matrix(const pair<vec3, vec3>& bounds) noexcept
+    {
+        return scale(translate(mat4{1}, bounds.first), quantization_extent(bounds));
+    }
+
+    vec3 compact_vertex::quantization_extent(const pair<vec3, vec3>& bounds) noexcept
+    {
+        const auto& size = bounds.second - bounds.first;
+        return vec3{std::max({size.x, size.y, size.z, 1e-6f})};
+    }
 }
\ No newline at end of file
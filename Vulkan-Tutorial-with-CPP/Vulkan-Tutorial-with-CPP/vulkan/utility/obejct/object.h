@@ -163,6 +163,7 @@ namespace vulkan::utility
     using pipeline_layout_object = object<PipelineLayout>;
     using device_memory_object = object<DeviceMemory>;
     using graphics_pipeline_object = object<GraphicsPipeline>;
+    using compute_pipeline_object = object<ComputePipeline>;
     using command_pool_object = pool_object<CommandPool>;
     using command_buffer_object = object<CommandBuffer>;
     using semaphore_object = object<Semaphore>;
@@ -192,29 +193,59 @@ namespace vulkan::utility
             VertexInputRate::eVertex
         };
 
-        static constexpr array<VertexInputAttributeDescription, 3> attribute_descriptions{
-            VertexInputAttributeDescription{
-            0,
-            0,
-            pos_format,
-            static_cast<uint32_t>(MEMBER_OFFSET(base, pos))
-        },
-            VertexInputAttributeDescription{
-            1,
-            0,
-            color_format,
-            static_cast<uint32_t>(MEMBER_OFFSET(base, color))
-        },
-            VertexInputAttributeDescription{
-            2,
+        static constexpr auto attribute_descriptions =
+            constant::vertex_attribute_descriptions<pos_format, color_format, texture_coordinate_format>();
+
+        constexpr bool operator==(const vertex& right) const;
+    };
+
+    static_assert(
+        sizeof(vertex_base) ==
+        constant::vertex_stride<vertex::pos_format, vertex::color_format, vertex::texture_coordinate_format>
+    );
+
+    //positions are unorm within a cube around their mesh that the draw maps back, the fourth component is one
+    //where the bitangent follows cross(normal, tangent) and zero where it is mirrored, the normal and the tangent
+    //are octahedral and texture coordinates are half floats
+    struct compact_vertex
+    {
+        static constexpr auto pos_format = Format::eR16G16B16A16Unorm;
+        static constexpr auto normal_format = Format::eR16G16Snorm;
+        static constexpr auto texture_coordinate_format = Format::eR16G16Sfloat;
+        static constexpr auto tangent_format = Format::eR16G16Snorm;
+
+        constant::format_t<pos_format> pos;
+        constant::format_t<normal_format> normal;
+        constant::format_t<texture_coordinate_format> texture_coordinate;
+        constant::format_t<tangent_format> tangent;
+
+        compact_vertex() noexcept = default;
+        compact_vertex(const vec3, const vec3, const vec2, const vec4, const pair<vec3, vec3>&) noexcept;
+
+        //the lower half of the octahedron is folded over the diagonals
+        [[nodiscard]] static i16vec2 octahedral(const vec3&) noexcept;
+
+        //from the unorm positions to the box they were quantized in
+        [[nodiscard]] static mat4 dequantize_matrix(const pair<vec3, vec3>&) noexcept;
+
+        //edge of the cube around the box, its uniform scale leaves the normal to the inverse transpose of the draw
+        [[nodiscard]] static vec3 quantization_extent(const pair<vec3, vec3>&) noexcept;
+
+        static constexpr VertexInputBindingDescription description{
             0,
-            texture_coordinate_format,
-            static_cast<uint32_t>(MEMBER_OFFSET(base, texture_coordinate))
-        }
+            constant::vertex_stride<pos_format, normal_format, texture_coordinate_format, tangent_format>,
+            VertexInputRate::eVertex
         };
 
-        constexpr bool operator==(const vertex& right) const;
+        static constexpr auto attribute_descriptions = constant::vertex_attribute_descriptions<
+            pos_format,
+            normal_format,
+            texture_coordinate_format,
+            tangent_format
+        >();
     };
+
+    static_assert(sizeof(compact_vertex) == compact_vertex::description.stride);
 }
 
 #include "object.tpp"
@@ -6,6 +6,8 @@ namespace vk
 {
 	// ReSharper disable once CppInconsistentNaming
 	using GraphicsPipeline = vulkan::GraphicsPipeline;
+	// ReSharper disable once CppInconsistentNaming
+	using ComputePipeline = vulkan::ComputePipeline;
 
 	template<typename Dispatch>
 	class UniqueHandleTraits<GraphicsPipeline, Dispatch> : public UniqueHandleTraits<Pipeline, Dispatch>
@@ -24,6 +26,24 @@ namespace vk
 		using base::base;
 		UniqueHandle(base&&) noexcept;
 	};
+
+	template<typename Dispatch>
+	class UniqueHandleTraits<ComputePipeline, Dispatch> : public UniqueHandleTraits<Pipeline, Dispatch>
+	{
+	public:
+		using base = UniqueHandleTraits<Pipeline, Dispatch>;
+		using base::base;
+		using deleter = typename base::deleter;
+	};
+
+	template<typename Dispatch>
+	class UniqueHandle<ComputePipeline, Dispatch> : public UniqueHandle<Pipeline, Dispatch>
+	{
+	public:
+		using base = UniqueHandle<Pipeline, Dispatch>;
+		using base::base;
+		UniqueHandle(base&&) noexcept;
+	};
 }
 
 namespace vulkan::utility
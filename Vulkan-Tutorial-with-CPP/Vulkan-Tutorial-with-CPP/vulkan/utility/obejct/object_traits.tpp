@@ -6,6 +6,11 @@ namespace vk
     UniqueHandle<GraphicsPipeline, Dispatch>::UniqueHandle(base&& base_handle) noexcept :
         base(std::move(base_handle))
     {}
+
+    template<typename Dispatch>
+    UniqueHandle<ComputePipeline, Dispatch>::UniqueHandle(base&& base_handle) noexcept :
+        base(std::move(base_handle))
+    {}
 }
 
 namespace vulkan::utility
@@ -103,6 +103,18 @@ namespace vulkan::utility
             template<typename T, typename Op = empty_type>
             void write(value_type<T>, const Op& = {});
 
+            //copies a mapped range straight into host memory, the range is not kept for read
+            template<typename T>
+            void write(const T*, const T*);
+
+            //copies a range over the elements from the given one on, values kept for read are updated as well
+            template<typename T>
+            void write(const T*, const T*, const size_t);
+
+            //maps the whole host range of the type for the function to fill in place, the values are not kept for read
+            template<typename T, typename Func>
+            void write_in_place(Func&&);
+
             template<typename...>
             void flush();
 
@@ -111,6 +123,10 @@ namespace vulkan::utility
 
             void write_transfer_command(const CommandBuffer&) const;
 
+            //copies only the given count of elements from the given one on to the device local buffer of the type
+            template<typename T>
+            void write_transfer_command(const CommandBuffer&, const size_t, const size_t) const;
+
             constexpr const auto& device_local_buffer(const size_t i) const;
             constexpr const auto& host_buffer(const size_t i) const;
             constexpr const auto& device_local_memory() const;
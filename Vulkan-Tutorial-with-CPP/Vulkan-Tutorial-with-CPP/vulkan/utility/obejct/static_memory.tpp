@@ -219,6 +219,56 @@ namespace vulkan::utility
         write_impl<T>(value, op);
     }
 
+    template<bool Cached, typename ... Types>
+    template<template <typename T> class RangeType>
+    template<typename T>
+    void static_memory<Cached, Types...>::base_array_values<RangeType>::write(const T* const begin, const T* const end)
+    {
+        if(static_cast<size_t>(end - begin) > sizes_[type_index<T>])
+            throw std::out_of_range{"Input value out of range"};
+        if(host_memory_) utility::write(host_memory_, *device_, begin, end, type_offsets_[type_index<T>]);
+        std::get<value_type<T>>(type_values_) = {};
+    }
+
+    template<bool Cached, typename ... Types>
+    template<template <typename T> class RangeType>
+    template<typename T>
+    void static_memory<Cached, Types...>::base_array_values<RangeType>::write(
+        const T* const begin,
+        const T* const end,
+        const size_t first
+    )
+    {
+        const auto count = static_cast<size_t>(end - begin);
+        if(first + count > sizes_[type_index<T>]) throw std::out_of_range{"Input value out of range"};
+        if(host_memory_)
+            utility::write(host_memory_, *device_, begin, end, type_offsets_[type_index<T>] + sizeof(T) * first);
+
+        auto& values = std::get<value_type<T>>(type_values_);
+        if(values.size() >= first + count) std::copy(begin, end, values.begin() + first);
+    }
+
+    template<bool Cached, typename ... Types>
+    template<template <typename T> class RangeType>
+    template<typename T, typename Func>
+    void static_memory<Cached, Types...>::base_array_values<RangeType>::write_in_place(Func&& func)
+    {
+        if(host_memory_ && sizes_[type_index<T>] > 0)
+        {
+            func(
+                static_cast<T*>((*device_)->mapMemory(
+                    *host_memory_,
+                    type_offsets_[type_index<T>],
+                    sizeof(T) * sizes_[type_index<T>],
+                    {},
+                    device_->dispatch()
+                ))
+            );
+            (*device_)->unmapMemory(*host_memory_, device_->dispatch());
+        }
+        std::get<value_type<T>>(type_values_) = {};
+    }
+
     template<bool Cached, typename... Types>
     template<template <typename T> class RangeType>
     template<typename... T>
@@ -269,6 +319,26 @@ namespace vulkan::utility
         );
     }
 
+    template<bool Cached, typename ... Types>
+    template<template <typename T> class RangeType>
+    template<typename T>
+    void static_memory<Cached, Types...>::base_array_values<RangeType>::write_transfer_command(
+        const CommandBuffer& command_buffer,
+        const size_t first,
+        const size_t count
+    ) const
+    {
+        if(count == 0) return;
+
+        const auto offset = sizeof(T) * first;
+        command_buffer.copyBuffer(
+            *host_buffers_[type_index<T>],
+            *device_local_buffers_[type_index<T>],
+            {{offset, offset, sizeof(T) * count}},
+            device_->dispatch()
+        );
+    }
+
     template<bool Cached, typename ... Types>
     template<template <typename T> class RangeType>
     constexpr const auto& static_memory<Cached, Types...>::base_array_values<RangeType>::device_local_buffer(
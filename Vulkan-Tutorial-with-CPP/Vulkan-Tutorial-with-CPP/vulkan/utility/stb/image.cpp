@@ -16,4 +16,14 @@ namespace vulkan::utility::stb
     {
         return image_format_str[static_cast<image_format_underlying_type>(format)].data();
     }
+
+    tuple<size_t, size_t, channel> image_info(const path& path)
+    {
+        int width = 0;
+        int height = 0;
+        int real_channel;
+        if(!stbi_info(path.generic_u8string().c_str(), &width, &height, &real_channel))
+            throw std::runtime_error("cannot open image file:" + path.string());
+        return {static_cast<size_t>(width), static_cast<size_t>(height), channel{real_channel}};
+    }
 }
\ No newline at end of file
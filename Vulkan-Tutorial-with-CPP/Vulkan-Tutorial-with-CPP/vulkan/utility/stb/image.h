@@ -8,6 +8,7 @@ namespace vulkan::utility::stb
 	using std::vector;
 	using std::string;
 	using std::string_view;
+	using std::tuple;
 	using std::filesystem::path;
 
 	enum class image_format { jpg, png, bmp, unknown };
@@ -20,6 +21,12 @@ namespace vulkan::utility::stb
 	image_format from_string(const string& extension);
 	std::string to_string(const image_format format);
 
+	[[nodiscard]] tuple<size_t, size_t, channel> image_info(const path&);
+
+	//hands the pixels decoded by stb to the consumer before they are freed, without an owning copy
+	template<channel Channel, typename Consumer>
+	decltype(auto) decode(const path&, Consumer&&);
+
 	template<channel Channel = channel::default_desired>
 	class image
 	{
@@ -50,6 +57,9 @@ namespace vulkan::utility::stb
 
 		[[nodiscard]] vector<stbi_uc> to_stb_vec() const noexcept;
 
+		[[nodiscard]] const pixel_t* data() const noexcept;
+		[[nodiscard]] pixel_t* data() noexcept;
+
 		[[nodiscard]] auto width() const noexcept;
 		[[nodiscard]] auto height() const noexcept;
 		[[nodiscard]] auto pixel_size() const noexcept;
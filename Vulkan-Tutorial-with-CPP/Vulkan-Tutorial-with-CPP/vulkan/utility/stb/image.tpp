@@ -2,6 +2,24 @@
 
 namespace vulkan::utility::stb
 {
+	template<channel Channel, typename Consumer>
+	decltype(auto) decode(const path& path, Consumer&& consumer)
+	{
+		int width = 0;
+		int height = 0;
+		int real_channel;
+		const std::unique_ptr<stbi_uc, decltype(&stbi_image_free)> ptr{
+			stbi_load(path.generic_u8string().c_str(), &width, &height, &real_channel, static_cast<int>(Channel)),
+			stbi_image_free
+		};
+		if(!ptr) throw std::runtime_error("cannot open image file:" + path.string());
+		return consumer(
+			reinterpret_cast<const pixel_t<Channel>*>(ptr.get()),
+			static_cast<size_t>(width),
+			static_cast<size_t>(height)
+		);
+	}
+
 	template<channel Channel>
 	image<Channel>::image(const size_type width, const size_type height, const channel real_channel) noexcept :
 		pixels_(width* height* channel_type),
@@ -59,24 +77,16 @@ namespace vulkan::utility::stb
 
 	template<channel Channel>
 	template<channel RequiredChannel>
-	image<Channel>::image(image<RequiredChannel> right)
+	image<Channel>::image(image<RequiredChannel> right) :
+		height_(right.height()),
+		real_channel_type_(right.real_channel())
 	{
 		if constexpr(Channel == RequiredChannel)
-			*this = std::move(right);
+			pixels_ = std::move(right.pixels_);
 		else
 		{
-			auto vec = right.to_stb_vec();
-			int width, height, real_channel;
-			auto converted_ptr = stbi_load_from_memory(
-				vec.data(),
-				right * width(), right.height() * RequiredChannel,
-				&width,
-				&height,
-				&real_channel,
-				static_cast<int>(channel_type)
-			);
-			*this = image{converted_ptr, width, height, real_channel};
-			stbi_image_free(converted_ptr);
+			pixels_.resize(right.pixel_size());
+			convert_pixels<RequiredChannel, Channel>(right.data(), right.pixel_size(), pixels_.data());
 		}
 	}
 
@@ -87,6 +97,12 @@ namespace vulkan::utility::stb
 		return {ptr, ptr + width() * height() * static_cast<channel_underlying_type>(channel_type)};
 	}
 
+	template<channel Channel>
+	auto image<Channel>::data() const noexcept -> const pixel_t* { return pixels_.data(); }
+
+	template<channel Channel>
+	auto image<Channel>::data() noexcept -> pixel_t* { return pixels_.data(); }
+
 	template<channel Channel>
 	auto image<Channel>::width() const noexcept
 	{
@@ -0,0 +1,550 @@
+#include "pixel_traits.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define STB_PIXEL_SIMD
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define STB_TARGET_SSSE3
+#define STB_TARGET_AVX2
+#else
+#define STB_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define STB_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace vulkan::utility::stb
+{
+    namespace
+    {
+        using byte_type = uint8_t;
+
+        //scalar kernels, also used for the tails of the vector kernels
+
+        void grey_to_rgba_scalar(const byte_type* const src, const size_t first, const size_t last, byte_type* const dst)
+        {
+            for(auto i = last; i-- > first;)
+            {
+                const auto grey = src[i];
+                dst[4 * i] = dst[4 * i + 1] = dst[4 * i + 2] = grey;
+                dst[4 * i + 3] = 255;
+            }
+        }
+
+        void grey_alpha_to_rgba_scalar(
+            const byte_type* const src,
+            const size_t first,
+            const size_t last,
+            byte_type* const dst
+        )
+        {
+            for(auto i = last; i-- > first;)
+            {
+                const auto grey = src[2 * i];
+                const auto alpha = src[2 * i + 1];
+                dst[4 * i] = dst[4 * i + 1] = dst[4 * i + 2] = grey;
+                dst[4 * i + 3] = alpha;
+            }
+        }
+
+        void rgb_to_rgba_scalar(const byte_type* const src, const size_t first, const size_t last, byte_type* const dst)
+        {
+            for(auto i = last; i-- > first;)
+            {
+                const auto red = src[3 * i];
+                const auto green = src[3 * i + 1];
+                const auto blue = src[3 * i + 2];
+                dst[4 * i] = red;
+                dst[4 * i + 1] = green;
+                dst[4 * i + 2] = blue;
+                dst[4 * i + 3] = 255;
+            }
+        }
+
+        void swizzle_bgra_scalar(const byte_type* const src, const size_t first, const size_t last, byte_type* const dst)
+        {
+            for(auto i = first; i < last; ++i)
+            {
+                const auto red = src[4 * i];
+                const auto green = src[4 * i + 1];
+                const auto blue = src[4 * i + 2];
+                const auto alpha = src[4 * i + 3];
+                dst[4 * i] = blue;
+                dst[4 * i + 1] = green;
+                dst[4 * i + 2] = red;
+                dst[4 * i + 3] = alpha;
+            }
+        }
+
+        //rounded division by 255, exact for every product of two bytes
+        constexpr byte_type multiply(const unsigned left, const unsigned right) noexcept
+        {
+            const auto product = left * right + 128;
+            return static_cast<byte_type>((product + (product >> 8)) >> 8);
+        }
+
+        void premultiply_alpha_scalar(
+            const byte_type* const src,
+            const size_t first,
+            const size_t last,
+            byte_type* const dst
+        )
+        {
+            for(auto i = first; i < last; ++i)
+            {
+                const auto alpha = src[4 * i + 3];
+                dst[4 * i] = multiply(src[4 * i], alpha);
+                dst[4 * i + 1] = multiply(src[4 * i + 1], alpha);
+                dst[4 * i + 2] = multiply(src[4 * i + 2], alpha);
+                dst[4 * i + 3] = alpha;
+            }
+        }
+
+        void downsample_row_scalar(
+            const byte_type* const row0,
+            const byte_type* const row1,
+            const size_t width,
+            const size_t first,
+            const size_t last,
+            byte_type* const dst
+        )
+        {
+            for(auto x = first; x < last; ++x)
+            {
+                const auto x0 = 4 * std::min(2 * x, width - 1);
+                const auto x1 = 4 * std::min(2 * x + 1, width - 1);
+                for(size_t i = 0; i < 4; ++i)
+                    dst[4 * x + i] = static_cast<byte_type>(
+                        (row0[x0 + i] + row0[x1 + i] + row1[x0 + i] + row1[x1 + i] + 2) / 4
+                    );
+            }
+        }
+
+#ifdef STB_PIXEL_SIMD
+        struct cpu_features
+        {
+            bool ssse3 = false;
+            bool avx2 = false;
+        };
+
+        cpu_features detect_cpu_features() noexcept
+        {
+            cpu_features features;
+#ifdef _MSC_VER
+            int info[4];
+            __cpuid(info, 0);
+            const auto max_leaf = info[0];
+            __cpuid(info, 1);
+            features.ssse3 = (info[2] & 1 << 9) != 0;
+            const auto os_saves_avx = (info[2] & 1 << 27) != 0 && (info[2] & 1 << 28) != 0 &&
+                (_xgetbv(0) & 6) == 6;
+            if(max_leaf >= 7)
+            {
+                __cpuidex(info, 7, 0);
+                features.avx2 = os_saves_avx && (info[1] & 1 << 5) != 0;
+            }
+#else
+            __builtin_cpu_init();
+            features.ssse3 = __builtin_cpu_supports("ssse3");
+            features.avx2 = __builtin_cpu_supports("avx2");
+#endif
+            return features;
+        }
+
+        const cpu_features& get_cpu_features() noexcept
+        {
+            static const auto features = detect_cpu_features();
+            return features;
+        }
+
+        //widening kernels process blocks backward, every block is loaded before it is stored,
+        //and a store never reaches source bytes of a lower block, so the source may be overwritten in place
+
+        size_t grey_to_rgba_sse2(const byte_type* const src, const size_t count, byte_type* const dst)
+        {
+            const auto alpha = _mm_set1_epi8(static_cast<char>(255));
+            const auto end = count / 16 * 16;
+            for(auto i = end; i > 0;)
+            {
+                i -= 16;
+                const auto grey = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                const auto grey_grey_low = _mm_unpacklo_epi8(grey, grey);
+                const auto grey_grey_high = _mm_unpackhi_epi8(grey, grey);
+                const auto grey_alpha_low = _mm_unpacklo_epi8(grey, alpha);
+                const auto grey_alpha_high = _mm_unpackhi_epi8(grey, alpha);
+                auto* const out = reinterpret_cast<__m128i*>(dst + 4 * i);
+                _mm_storeu_si128(out, _mm_unpacklo_epi16(grey_grey_low, grey_alpha_low));
+                _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(grey_grey_low, grey_alpha_low));
+                _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(grey_grey_high, grey_alpha_high));
+                _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(grey_grey_high, grey_alpha_high));
+            }
+            return end;
+        }
+
+        STB_TARGET_AVX2 size_t grey_to_rgba_avx2(const byte_type* const src, const size_t count, byte_type* const dst)
+        {
+            const auto spread = _mm256_set1_epi32(0x010101);
+            const auto alpha = _mm256_set1_epi32(static_cast<int>(0xff000000));
+            const auto end = count / 8 * 8;
+            for(auto i = end; i > 0;)
+            {
+                i -= 8;
+                const auto grey = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)));
+                _mm256_storeu_si256(
+                    reinterpret_cast<__m256i*>(dst + 4 * i),
+                    _mm256_or_si256(_mm256_mullo_epi32(grey, spread), alpha)
+                );
+            }
+            return end;
+        }
+
+        STB_TARGET_SSSE3 size_t grey_alpha_to_rgba_ssse3(
+            const byte_type* const src,
+            const size_t count,
+            byte_type* const dst
+        )
+        {
+            const auto shuffle = _mm_setr_epi8(0, 0, 0, 1, 2, 2, 2, 3, 4, 4, 4, 5, 6, 6, 6, 7);
+            const auto end = count / 4 * 4;
+            for(auto i = end; i > 0;)
+            {
+                i -= 4;
+                const auto pixels = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + 2 * i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * i), _mm_shuffle_epi8(pixels, shuffle));
+            }
+            return end;
+        }
+
+        STB_TARGET_AVX2 size_t grey_alpha_to_rgba_avx2(
+            const byte_type* const src,
+            const size_t count,
+            byte_type* const dst
+        )
+        {
+            //each pixel is widened to its own dword first, the shuffle then only works inside dwords
+            const auto shuffle = _mm256_setr_epi8(
+                0, 0, 0, 1, 4, 4, 4, 5, 8, 8, 8, 9, 12, 12, 12, 13,
+                0, 0, 0, 1, 4, 4, 4, 5, 8, 8, 8, 9, 12, 12, 12, 13
+            );
+            const auto end = count / 8 * 8;
+            for(auto i = end; i > 0;)
+            {
+                i -= 8;
+                const auto pixels = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * i), _mm256_shuffle_epi8(pixels, shuffle));
+            }
+            return end;
+        }
+
+        //a 16 byte load covers 4 pixels and reads 4 bytes past them, the last 2 pixels are left to the scalar tail
+        constexpr size_t rgb_block_end(const size_t count, const size_t block) noexcept
+        {
+            return count < 2 ? 0 : (count - 2) / block * block;
+        }
+
+        STB_TARGET_SSSE3 size_t rgb_to_rgba_ssse3(const byte_type* const src, const size_t count, byte_type* const dst)
+        {
+            const auto shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+            const auto alpha = _mm_set1_epi32(static_cast<int>(0xff000000));
+            const auto end = rgb_block_end(count, 4);
+            for(auto i = end; i > 0;)
+            {
+                i -= 4;
+                const auto pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 3 * i));
+                _mm_storeu_si128(
+                    reinterpret_cast<__m128i*>(dst + 4 * i),
+                    _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), alpha)
+                );
+            }
+            return end;
+        }
+
+        STB_TARGET_AVX2 size_t rgb_to_rgba_avx2(const byte_type* const src, const size_t count, byte_type* const dst)
+        {
+            const auto shuffle = _mm256_setr_epi8(
+                0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1
+            );
+            const auto alpha = _mm256_set1_epi32(static_cast<int>(0xff000000));
+            const auto end = rgb_block_end(count, 8);
+            for(auto i = end; i > 0;)
+            {
+                i -= 8;
+                const auto low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 3 * i));
+                const auto high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 3 * i + 12));
+                const auto pixels = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+                _mm256_storeu_si256(
+                    reinterpret_cast<__m256i*>(dst + 4 * i),
+                    _mm256_or_si256(_mm256_shuffle_epi8(pixels, shuffle), alpha)
+                );
+            }
+            return end;
+        }
+
+        STB_TARGET_SSSE3 size_t swizzle_bgra_ssse3(const byte_type* const src, const size_t count, byte_type* const dst)
+        {
+            const auto shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+            const auto end = count / 4 * 4;
+            for(size_t i = 0; i < end; i += 4)
+            {
+                const auto pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * i), _mm_shuffle_epi8(pixels, shuffle));
+            }
+            return end;
+        }
+
+        STB_TARGET_AVX2 size_t swizzle_bgra_avx2(const byte_type* const src, const size_t count, byte_type* const dst)
+        {
+            const auto shuffle = _mm256_setr_epi8(
+                2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15
+            );
+            const auto end = count / 8 * 8;
+            for(size_t i = 0; i < end; i += 8)
+            {
+                const auto pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 4 * i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * i), _mm256_shuffle_epi8(pixels, shuffle));
+            }
+            return end;
+        }
+
+        //16 bit lanes of two pixels times their alpha, alpha itself is multiplied by 255 to stay unchanged
+        __m128i premultiply_sse2(const __m128i pixels, const __m128i alpha_lane_mask, const __m128i alpha_lane_max)
+        {
+            auto alpha = _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+            alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+            alpha = _mm_or_si128(_mm_andnot_si128(alpha_lane_mask, alpha), alpha_lane_max);
+
+            const auto product = _mm_add_epi16(_mm_mullo_epi16(pixels, alpha), _mm_set1_epi16(128));
+            return _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+        }
+
+        size_t premultiply_alpha_sse2(const byte_type* const src, const size_t count, byte_type* const dst)
+        {
+            const auto zero = _mm_setzero_si128();
+            const auto alpha_lane_mask = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+            const auto alpha_lane_max = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+            const auto end = count / 4 * 4;
+            for(size_t i = 0; i < end; i += 4)
+            {
+                const auto pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i));
+                const auto low = premultiply_sse2(_mm_unpacklo_epi8(pixels, zero), alpha_lane_mask, alpha_lane_max);
+                const auto high = premultiply_sse2(_mm_unpackhi_epi8(pixels, zero), alpha_lane_mask, alpha_lane_max);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * i), _mm_packus_epi16(low, high));
+            }
+            return end;
+        }
+
+        STB_TARGET_AVX2 __m256i premultiply_avx2(
+            const __m256i pixels,
+            const __m256i alpha_lane_mask,
+            const __m256i alpha_lane_max
+        )
+        {
+            auto alpha = _mm256_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+            alpha = _mm256_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+            alpha = _mm256_or_si256(_mm256_andnot_si256(alpha_lane_mask, alpha), alpha_lane_max);
+
+            const auto product = _mm256_add_epi16(_mm256_mullo_epi16(pixels, alpha), _mm256_set1_epi16(128));
+            return _mm256_srli_epi16(_mm256_add_epi16(product, _mm256_srli_epi16(product, 8)), 8);
+        }
+
+        STB_TARGET_AVX2 size_t premultiply_alpha_avx2(
+            const byte_type* const src,
+            const size_t count,
+            byte_type* const dst
+        )
+        {
+            const auto zero = _mm256_setzero_si256();
+            const auto alpha_lane_mask = _mm256_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1);
+            const auto alpha_lane_max = _mm256_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255);
+            const auto end = count / 8 * 8;
+            for(size_t i = 0; i < end; i += 8)
+            {
+                const auto pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 4 * i));
+                const auto low = premultiply_avx2(_mm256_unpacklo_epi8(pixels, zero), alpha_lane_mask, alpha_lane_max);
+                const auto high = premultiply_avx2(_mm256_unpackhi_epi8(pixels, zero), alpha_lane_mask, alpha_lane_max);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * i), _mm256_packus_epi16(low, high));
+            }
+            return end;
+        }
+
+        //two destination pixels from four columns of both rows, widened to 16 bits so the rounding matches scalar code
+        __m128i downsample_sse2(const __m128i top, const __m128i bottom, const __m128i zero, const __m128i bias)
+        {
+            const auto low = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+            const auto high = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+            const auto sum = _mm_unpacklo_epi64(
+                _mm_add_epi16(low, _mm_srli_si128(low, 8)),
+                _mm_add_epi16(high, _mm_srli_si128(high, 8))
+            );
+            return _mm_srli_epi16(_mm_add_epi16(sum, bias), 2);
+        }
+
+        size_t downsample_row_sse2(
+            const byte_type* const row0,
+            const byte_type* const row1,
+            const size_t width,
+            byte_type* const dst
+        )
+        {
+            const auto zero = _mm_setzero_si128();
+            const auto bias = _mm_set1_epi16(2);
+            const auto end = width / 2 / 4 * 4;
+            for(size_t x = 0; x < end; x += 4)
+            {
+                const auto* const top = reinterpret_cast<const __m128i*>(row0 + 8 * x);
+                const auto* const bottom = reinterpret_cast<const __m128i*>(row1 + 8 * x);
+                const auto first = downsample_sse2(_mm_loadu_si128(top), _mm_loadu_si128(bottom), zero, bias);
+                const auto second = downsample_sse2(
+                    _mm_loadu_si128(top + 1),
+                    _mm_loadu_si128(bottom + 1),
+                    zero,
+                    bias
+                );
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * x), _mm_packus_epi16(first, second));
+            }
+            return end;
+        }
+#endif
+    }
+
+    void convert_pixels(
+        const pixel_t<channel::grey>* const src,
+        const size_t count,
+        pixel_t<channel::rgb_alpha>* const dst
+    ) noexcept
+    {
+        const auto* const src_bytes = reinterpret_cast<const byte_type*>(src);
+        auto* const dst_bytes = reinterpret_cast<byte_type*>(dst);
+
+        //the scalar tail goes first, since the vector kernels run backward
+#ifdef STB_PIXEL_SIMD
+        if(get_cpu_features().avx2)
+        {
+            grey_to_rgba_scalar(src_bytes, count / 8 * 8, count, dst_bytes);
+            grey_to_rgba_avx2(src_bytes, count, dst_bytes);
+        }
+        else
+        {
+            grey_to_rgba_scalar(src_bytes, count / 16 * 16, count, dst_bytes);
+            grey_to_rgba_sse2(src_bytes, count, dst_bytes);
+        }
+#else
+        grey_to_rgba_scalar(src_bytes, 0, count, dst_bytes);
+#endif
+    }
+
+    void convert_pixels(
+        const pixel_t<channel::grey_alpha>* const src,
+        const size_t count,
+        pixel_t<channel::rgb_alpha>* const dst
+    ) noexcept
+    {
+        const auto* const src_bytes = reinterpret_cast<const byte_type*>(src);
+        auto* const dst_bytes = reinterpret_cast<byte_type*>(dst);
+
+#ifdef STB_PIXEL_SIMD
+        if(get_cpu_features().avx2)
+        {
+            grey_alpha_to_rgba_scalar(src_bytes, count / 8 * 8, count, dst_bytes);
+            grey_alpha_to_rgba_avx2(src_bytes, count, dst_bytes);
+            return;
+        }
+        if(get_cpu_features().ssse3)
+        {
+            grey_alpha_to_rgba_scalar(src_bytes, count / 4 * 4, count, dst_bytes);
+            grey_alpha_to_rgba_ssse3(src_bytes, count, dst_bytes);
+            return;
+        }
+#endif
+        grey_alpha_to_rgba_scalar(src_bytes, 0, count, dst_bytes);
+    }
+
+    void convert_pixels(
+        const pixel_t<channel::rgb>* const src,
+        const size_t count,
+        pixel_t<channel::rgb_alpha>* const dst
+    ) noexcept
+    {
+        const auto* const src_bytes = reinterpret_cast<const byte_type*>(src);
+        auto* const dst_bytes = reinterpret_cast<byte_type*>(dst);
+
+#ifdef STB_PIXEL_SIMD
+        if(get_cpu_features().avx2)
+        {
+            rgb_to_rgba_scalar(src_bytes, rgb_block_end(count, 8), count, dst_bytes);
+            rgb_to_rgba_avx2(src_bytes, count, dst_bytes);
+            return;
+        }
+        if(get_cpu_features().ssse3)
+        {
+            rgb_to_rgba_scalar(src_bytes, rgb_block_end(count, 4), count, dst_bytes);
+            rgb_to_rgba_ssse3(src_bytes, count, dst_bytes);
+            return;
+        }
+#endif
+        rgb_to_rgba_scalar(src_bytes, 0, count, dst_bytes);
+    }
+
+    void swizzle_bgra(
+        const pixel_t<channel::rgb_alpha>* const src,
+        const size_t count,
+        pixel_t<channel::rgb_alpha>* const dst
+    ) noexcept
+    {
+        const auto* const src_bytes = reinterpret_cast<const byte_type*>(src);
+        auto* const dst_bytes = reinterpret_cast<byte_type*>(dst);
+        size_t end = 0;
+
+#ifdef STB_PIXEL_SIMD
+        if(get_cpu_features().avx2) end = swizzle_bgra_avx2(src_bytes, count, dst_bytes);
+        else if(get_cpu_features().ssse3) end = swizzle_bgra_ssse3(src_bytes, count, dst_bytes);
+#endif
+        swizzle_bgra_scalar(src_bytes, end, count, dst_bytes);
+    }
+
+    void premultiply_alpha(
+        const pixel_t<channel::rgb_alpha>* const src,
+        const size_t count,
+        pixel_t<channel::rgb_alpha>* const dst
+    ) noexcept
+    {
+        const auto* const src_bytes = reinterpret_cast<const byte_type*>(src);
+        auto* const dst_bytes = reinterpret_cast<byte_type*>(dst);
+        size_t end = 0;
+
+#ifdef STB_PIXEL_SIMD
+        end = get_cpu_features().avx2 ?
+            premultiply_alpha_avx2(src_bytes, count, dst_bytes) :
+            premultiply_alpha_sse2(src_bytes, count, dst_bytes);
+#endif
+        premultiply_alpha_scalar(src_bytes, end, count, dst_bytes);
+    }
+
+    void downsample(
+        const pixel_t<channel::rgb_alpha>* const src,
+        const size_t width,
+        const size_t height,
+        pixel_t<channel::rgb_alpha>* const dst
+    ) noexcept
+    {
+        const auto* const src_bytes = reinterpret_cast<const byte_type*>(src);
+        auto* const dst_bytes = reinterpret_cast<byte_type*>(dst);
+        const auto dst_width = std::max<size_t>(width / 2, 1);
+        const auto dst_height = std::max<size_t>(height / 2, 1);
+
+        for(size_t y = 0; y < dst_height; ++y)
+        {
+            const auto* const row0 = src_bytes + 4 * width * std::min(2 * y, height - 1);
+            const auto* const row1 = src_bytes + 4 * width * std::min(2 * y + 1, height - 1);
+            auto* const row_dst = dst_bytes + 4 * dst_width * y;
+            size_t end = 0;
+
+#ifdef STB_PIXEL_SIMD
+            end = downsample_row_sse2(row0, row1, width, row_dst);
+#endif
+            downsample_row_scalar(row0, row1, width, end, dst_width, row_dst);
+        }
+    }
+}
@@ -23,4 +23,33 @@ namespace vulkan::utility::stb
 
 	template<channel Channel>
 	using pixel_t = vec<static_cast<length_t>(Channel), uint8_t>;
+
+	template<channel To, channel From>
+	[[nodiscard]] constexpr pixel_t<To> convert_pixel(const pixel_t<From>&) noexcept;
+
+	//kernels below pick avx2 or ssse3 code at runtime and fall back to scalar code,
+	//conversions to rgba can run in place when the destination starts at the source
+	void convert_pixels(const pixel_t<channel::grey>*, const size_t, pixel_t<channel::rgb_alpha>*) noexcept;
+	void convert_pixels(const pixel_t<channel::grey_alpha>*, const size_t, pixel_t<channel::rgb_alpha>*) noexcept;
+	void convert_pixels(const pixel_t<channel::rgb>*, const size_t, pixel_t<channel::rgb_alpha>*) noexcept;
+
+	//entry point for any channel pair, conversions to rgba use the kernels above
+	template<channel From, channel To>
+	void convert_pixels(const pixel_t<From>*, const size_t, pixel_t<To>*) noexcept;
+
+	//swaps red and blue, turning bgra into rgba and the other way around
+	void swizzle_bgra(const pixel_t<channel::rgb_alpha>*, const size_t, pixel_t<channel::rgb_alpha>*) noexcept;
+
+	void premultiply_alpha(const pixel_t<channel::rgb_alpha>*, const size_t, pixel_t<channel::rgb_alpha>*) noexcept;
+
+	//halves width and height with a rounded 2x2 box filter, the last row or column is repeated for odd sizes,
+	//the destination holds max(width / 2, 1) * max(height / 2, 1) pixels
+	void downsample(
+		const pixel_t<channel::rgb_alpha>*,
+		const size_t,
+		const size_t,
+		pixel_t<channel::rgb_alpha>*
+	) noexcept;
 }
+
+#include "pixel_traits.tpp"
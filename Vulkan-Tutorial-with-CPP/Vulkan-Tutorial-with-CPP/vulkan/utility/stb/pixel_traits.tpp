@@ -0,0 +1,50 @@
+#pragma once
+
+namespace vulkan::utility::stb
+{
+	template<channel To, channel From>
+	constexpr pixel_t<To> convert_pixel(const pixel_t<From>& pixel) noexcept
+	{
+		constexpr auto from_length = static_cast<length_t>(From);
+		constexpr auto to_length = static_cast<length_t>(To);
+
+		if constexpr(From == To) return pixel;
+		else
+		{
+			pixel_t<channel::rgb_alpha> rgba{0, 0, 0, 255};
+			if constexpr(from_length <= 2)
+			{
+				rgba.x = rgba.y = rgba.z = pixel.x;
+				if constexpr(from_length == 2) rgba.w = pixel.y;
+			}
+			else
+			{
+				rgba.x = pixel.x;
+				rgba.y = pixel.y;
+				rgba.z = pixel.z;
+				if constexpr(from_length == 4) rgba.w = pixel.w;
+			}
+
+			if constexpr(to_length <= 2)
+			{
+				//same luma weights as stb
+				const auto luma = static_cast<uint8_t>((rgba.x * 77 + rgba.y * 150 + rgba.z * 29) >> 8);
+				if constexpr(to_length == 1) return pixel_t<To>{luma};
+				else return pixel_t<To>{luma, rgba.w};
+			}
+			else if constexpr(to_length == 3) return pixel_t<To>{rgba.x, rgba.y, rgba.z};
+			else return rgba;
+		}
+	}
+
+	template<channel From, channel To>
+	void convert_pixels(const pixel_t<From>* const src, const size_t count, pixel_t<To>* const dst) noexcept
+	{
+		if constexpr(To == channel::rgb_alpha && From != channel::rgb_alpha) convert_pixels(src, count, dst);
+		//widening conversions walk backward so that they can run in place
+		else if constexpr(sizeof(pixel_t<To>) > sizeof(pixel_t<From>))
+			for(auto i = count; i-- > 0;) dst[i] = convert_pixel<To, From>(src[i]);
+		else
+			for(size_t i = 0; i < count; ++i) dst[i] = convert_pixel<To, From>(src[i]);
+	}
+}
@@ -0,0 +1,26 @@
+#include "texture_budget.h"
+
+namespace vulkan::utility
+{
+    auto texture_budget_policy::at(const texture_slot slot) const noexcept -> const slot_policy&
+    {
+        return slots[static_cast<size_t>(slot)];
+    }
+
+    auto texture_budget_policy::at(const texture_slot slot) noexcept -> slot_policy&
+    {
+        return slots[static_cast<size_t>(slot)];
+    }
+
+    DeviceSize texture_budget(
+        const PhysicalDeviceMemoryProperties& properties,
+        const texture_budget_policy& policy
+    ) noexcept
+    {
+        DeviceSize heap_size = 0;
+        for(uint32_t i = 0; i < properties.memoryHeapCount; ++i)
+            if(properties.memoryHeaps[i].flags & MemoryHeapFlagBits::eDeviceLocal)
+                heap_size = std::max(heap_size, properties.memoryHeaps[i].size);
+        return static_cast<DeviceSize>(static_cast<double>(heap_size) * policy.heap_fraction);
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "vulkan/utility/obejct/image.h"
+#include <queue>
+
+namespace vulkan::utility
+{
+    enum class texture_slot
+    {
+        base_color,
+        emissive,
+        normal,
+        specular,
+        occlusion,
+        metallic_roughness,
+        count
+    };
+
+    //how much of the device memory textures may take and which slots give up resolution first
+    struct texture_budget_policy
+    {
+        struct slot_policy
+        {
+            //higher weights keep their resolution longer
+            float weight = 1;
+            //downscaling stops before the larger side drops below this size
+            uint32_t min_size = 1;
+        };
+
+        float heap_fraction = 0.5f;
+
+        array<slot_policy, static_cast<size_t>(texture_slot::count)> slots{
+            {
+                {1, 512},
+                {0.75f, 256},
+                {0.75f, 256},
+                {0.5f, 128},
+                {0.25f, 64},
+                {0.25f, 64}
+            }
+        };
+
+        [[nodiscard]] const slot_policy& at(const texture_slot) const noexcept;
+        [[nodiscard]] slot_policy& at(const texture_slot) noexcept;
+    };
+
+    //share of the largest device local heap given by the policy
+    [[nodiscard]] DeviceSize texture_budget(const PhysicalDeviceMemoryProperties&, const texture_budget_policy&) noexcept;
+
+    template<typename Key>
+    struct texture_budget_request
+    {
+        Key key;
+        Extent3D extent;
+        DeviceSize texel_size;
+        texture_slot slot = texture_slot::base_color;
+    };
+
+    //finest level each texture keeps so that the mip chains from those levels fit in the budget,
+    //the texture with the most memory per unit of slot weight is halved first
+    template<typename Key>
+    [[nodiscard]] map<Key, uint32_t> fit_texture_budget(
+        const vector<texture_budget_request<Key>>&,
+        const DeviceSize,
+        const texture_budget_policy&
+    );
+}
+
+#include "texture_budget.tpp"
@@ -0,0 +1,53 @@
+#pragma once
+
+namespace vulkan::utility
+{
+    template<typename Key>
+    map<Key, uint32_t> fit_texture_budget(
+        const vector<texture_budget_request<Key>>& requests,
+        const DeviceSize budget,
+        const texture_budget_policy& policy
+    )
+    {
+        using request_type = texture_budget_request<Key>;
+
+        const auto chain_size = [](const request_type& request, const uint32_t level)
+        {
+            return (mip_level_texel_offset(request.extent, mip_levels(request.extent)) -
+                mip_level_texel_offset(request.extent, level)) * request.texel_size;
+        };
+        const auto cost = [&policy, &chain_size](const request_type& request, const uint32_t level)
+        {
+            return static_cast<float>(chain_size(request, level)) / policy.at(request.slot).weight;
+        };
+
+        map<Key, uint32_t> levels;
+        DeviceSize total_size = 0;
+        for(const auto& request : requests)
+        {
+            levels.insert_or_assign(request.key, 0);
+            total_size += chain_size(request, 0);
+        }
+
+        using candidate = pair<float, const request_type*>;
+        std::priority_queue<candidate> candidates;
+        for(const auto& request : requests) candidates.emplace(cost(request, 0), &request);
+
+        while(total_size > budget && !candidates.empty())
+        {
+            const auto& request = *candidates.top().second;
+            candidates.pop();
+
+            auto& level = levels.at(request.key);
+            const auto& next_extent = mip_level_extent(request.extent, level + 1);
+            if(level + 1 >= mip_levels(request.extent) ||
+                std::max(next_extent.width, next_extent.height) < policy.at(request.slot).min_size)
+                continue;
+
+            total_size -= chain_size(request, level) - chain_size(request, level + 1);
+            candidates.emplace(cost(request, ++level), &request);
+        }
+
+        return levels;
+    }
+}
@@ -0,0 +1,12 @@
+#include "texture_streaming.h"
+
+namespace vulkan::utility
+{
+    uint32_t demanded_mip_level(const float texel_span, const float projected_diameter, const uint32_t levels)
+    {
+        if(projected_diameter <= 0) return levels;
+        if(texel_span <= projected_diameter) return 0;
+
+        return std::min(static_cast<uint32_t>(std::log2(texel_span / projected_diameter)), levels - 1);
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "vulkan/utility/obejct/image.h"
+
+namespace vulkan::utility
+{
+    struct bounding_sphere
+    {
+        vec3 center{};
+        float radius = 0;
+    };
+
+    //finest level of a mip chain whose texel density does not exceed the screen pixel density,
+    //returns the level count when the surface is not visible at all
+    [[nodiscard]] uint32_t demanded_mip_level(const float texel_span, const float projected_diameter, const uint32_t levels);
+
+    //first level whose extent fits in the given size, levels from it on are always kept resident
+    [[nodiscard]] constexpr uint32_t tail_mip_level(const Extent3D, const uint32_t) noexcept;
+
+    //decides which textures gain or drop high mip levels under a fixed memory budget
+    template<typename Key>
+    class mip_residency
+    {
+        struct texture
+        {
+            Extent3D extent;
+            DeviceSize texel_size;
+            uint32_t floor_level;
+            uint32_t tail_level;
+            uint32_t committed_level;
+            uint32_t demanded_level;
+            uint64_t last_used = 0;
+            bool loading = false;
+
+            [[nodiscard]] DeviceSize size(const uint32_t) const noexcept;
+        };
+
+        DeviceSize budget_;
+        DeviceSize committed_size_ = 0;
+        map<Key, texture> textures_;
+
+    public:
+        explicit mip_residency(const DeviceSize) noexcept;
+
+        //levels finer than the floor level are never made resident
+        void insert(Key, const Extent3D, const DeviceSize, const uint32_t, const uint32_t = 0);
+
+        void demand(const Key&, const uint32_t, const uint64_t);
+
+        //transitions to start, each texture is locked until its transition completes
+        [[nodiscard]] vector<pair<Key, uint32_t>> plan();
+
+        void complete(const Key&);
+
+        [[nodiscard]] DeviceSize committed_size() const noexcept;
+    };
+}
+
+#include "texture_streaming.tpp"
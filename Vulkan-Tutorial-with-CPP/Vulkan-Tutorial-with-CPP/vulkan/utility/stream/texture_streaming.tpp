@@ -0,0 +1,120 @@
+#pragma once
+
+namespace vulkan::utility
+{
+    constexpr uint32_t tail_mip_level(const Extent3D extent, const uint32_t size) noexcept
+    {
+        uint32_t level = 0;
+        for(auto level_extent = extent;
+            level_extent.width > size || level_extent.height > size || level_extent.depth > size;
+            level_extent = mip_level_extent(extent, ++level));
+        return level;
+    }
+
+    template<typename Key>
+    DeviceSize mip_residency<Key>::texture::size(const uint32_t level) const noexcept
+    {
+        return (mip_level_texel_offset(extent, mip_levels(extent)) - mip_level_texel_offset(extent, level)) *
+            texel_size;
+    }
+
+    template<typename Key>
+    mip_residency<Key>::mip_residency(const DeviceSize budget) noexcept : budget_(budget) {}
+
+    template<typename Key>
+    void mip_residency<Key>::insert(
+        Key key,
+        const Extent3D extent,
+        const DeviceSize texel_size,
+        const uint32_t tail_level,
+        const uint32_t floor_level
+    )
+    {
+        const texture inserted{
+            extent,
+            texel_size,
+            std::min(floor_level, tail_level),
+            tail_level,
+            tail_level,
+            tail_level
+        };
+        if(const auto it = textures_.find(key); it != textures_.cend())
+            committed_size_ -= it->second.size(it->second.committed_level);
+        committed_size_ += inserted.size(tail_level);
+        textures_.insert_or_assign(std::move(key), inserted);
+    }
+
+    template<typename Key>
+    void mip_residency<Key>::demand(const Key& key, const uint32_t level, const uint64_t frame)
+    {
+        auto& demanded = textures_.at(key);
+        demanded.demanded_level = std::clamp(level, demanded.floor_level, demanded.tail_level);
+        if(demanded.demanded_level < demanded.tail_level) demanded.last_used = frame;
+    }
+
+    template<typename Key>
+    auto mip_residency<Key>::plan() -> vector<pair<Key, uint32_t>>
+    {
+        using iterator = typename decltype(textures_)::iterator;
+
+        vector<iterator> loads;
+        vector<iterator> victims;
+        for(auto it = textures_.begin(); it != textures_.end(); ++it)
+        {
+            if(it->second.loading) continue;
+            if(it->second.demanded_level < it->second.committed_level) loads.push_back(it);
+            else if(it->second.demanded_level > it->second.committed_level) victims.push_back(it);
+        }
+
+        //the most under-resolved textures load first, the least recently used high mips are dropped first
+        std::sort(
+            loads.begin(),
+            loads.end(),
+            [](const iterator left, const iterator right)
+            {
+                return left->second.committed_level - left->second.demanded_level >
+                    right->second.committed_level - right->second.demanded_level;
+            }
+        );
+        std::sort(
+            victims.begin(),
+            victims.end(),
+            [](const iterator left, const iterator right) { return left->second.last_used > right->second.last_used; }
+        );
+
+        vector<pair<Key, uint32_t>> transitions;
+        const auto commit = [&](texture& target, const Key& key, const uint32_t level)
+        {
+            committed_size_ = committed_size_ - target.size(target.committed_level) + target.size(level);
+            target.committed_level = level;
+            target.loading = true;
+            transitions.emplace_back(key, level);
+        };
+
+        for(const auto& load : loads)
+        {
+            auto& target = load->second;
+            auto level = target.demanded_level;
+            for(; level < target.committed_level; ++level)
+            {
+                const auto required = target.size(level) - target.size(target.committed_level);
+                while(committed_size_ + required > budget_ && !victims.empty())
+                {
+                    auto& victim = victims.back()->second;
+                    commit(victim, victims.back()->first, victim.demanded_level);
+                    victims.pop_back();
+                }
+                if(committed_size_ + required <= budget_) break;
+            }
+            if(level < target.committed_level) commit(target, load->first, level);
+        }
+
+        return transitions;
+    }
+
+    template<typename Key>
+    void mip_residency<Key>::complete(const Key& key) { textures_.at(key).loading = false; }
+
+    template<typename Key>
+    DeviceSize mip_residency<Key>::committed_size() const noexcept { return committed_size_; }
+}
@@ -0,0 +1,496 @@
+#include "virtual_texture.h"
+
+namespace vulkan::utility
+{
+    page_file::page_file(const path& file_path) :
+        file_(file_path.string().c_str(), boost::interprocess::read_only),
+        region_(file_, boost::interprocess::read_only) {}
+
+    bool page_file::is_valid(const uint64_t key) const noexcept
+    {
+        if(region_.get_size() < sizeof(header)) return false;
+
+        const auto& file_header = get_header();
+        const auto page_count = page_layout::level_offset(extent(), page_layout::levels(extent()));
+        return file_header.magic == header::magic_value &&
+            file_header.version == header::version_value &&
+            file_header.key == key &&
+            file_header.page_size == page_layout::size &&
+            file_header.page_border == page_layout::border &&
+            region_.get_size() ==
+            sizeof(header) + DeviceSize{page_count} * page_layout::texel_count * sizeof(pixel_type);
+    }
+
+    auto page_file::get_header() const noexcept -> const header&
+    {
+        return *static_cast<const header*>(region_.get_address());
+    }
+
+    Extent3D page_file::extent() const noexcept { return {get_header().width, get_header().height, 1}; }
+
+    auto page_file::page(const uint32_t index) const noexcept -> const pixel_type*
+    {
+        const auto* const pages = static_cast<const uint8_t*>(region_.get_address()) + sizeof(header);
+        return reinterpret_cast<const pixel_type*>(pages) + size_t{index} * page_layout::texel_count;
+    }
+
+    void page_file::store(
+        const path& file_path,
+        const uint64_t key,
+        const Extent2D extent,
+        const pixel_type* const mip_chain
+    ) noexcept
+    {
+        try
+        {
+            header file_header;
+            file_header.key = key;
+            file_header.width = extent.width;
+            file_header.height = extent.height;
+
+            std::filesystem::create_directories(file_path.parent_path());
+            const auto& temp_path = unique_temp_path(file_path);
+            {
+                ofstream stream{temp_path, std::ios::binary | std::ios::trunc};
+                stream.write(reinterpret_cast<const char*>(&file_header), sizeof(header));
+
+                const Extent3D chain_extent{extent.width, extent.height, 1};
+                vector<pixel_type> page_texels(page_layout::texel_count);
+                for(uint32_t level = 0; level < page_layout::levels(chain_extent); ++level)
+                {
+                    const auto* const level_texels = mip_chain + mip_level_texel_offset(chain_extent, level);
+                    const auto& level_extent = mip_level_extent(chain_extent, level);
+                    const auto& grid = page_layout::grid(chain_extent, level);
+
+                    //borders and the unused part of edge pages wrap around, matching repeat addressing
+                    const auto wrap = [](const int64_t coordinate, const uint32_t size)
+                    {
+                        return static_cast<uint32_t>((coordinate % size + size) % size);
+                    };
+
+                    for(uint32_t y = 0; y < grid.height; ++y)
+                        for(uint32_t x = 0; x < grid.width; ++x)
+                        {
+                            for(uint32_t page_y = 0; page_y < page_layout::stride; ++page_y)
+                            {
+                                const auto source_y = wrap(
+                                    int64_t{y} * page_layout::size + page_y - page_layout::border,
+                                    level_extent.height
+                                );
+                                for(uint32_t page_x = 0; page_x < page_layout::stride; ++page_x)
+                                    page_texels[page_y * page_layout::stride + page_x] = level_texels[
+                                        size_t{source_y} * level_extent.width + wrap(
+                                            int64_t{x} * page_layout::size + page_x - page_layout::border,
+                                            level_extent.width
+                                        )
+                                    ];
+                            }
+                            stream.write(
+                                reinterpret_cast<const char*>(page_texels.data()),
+                                static_cast<std::streamsize>(page_texels.size() * sizeof(pixel_type))
+                            );
+                        }
+                }
+                stream.close();
+                if(!stream)
+                {
+                    std::filesystem::remove(temp_path);
+                    return;
+                }
+            }
+            std::filesystem::rename(temp_path, file_path);
+        }
+        catch(const std::exception&) {}
+    }
+
+    virtual_texture_cache::virtual_texture_cache(
+        path directory,
+        const uint32_t slot_columns,
+        const uint32_t max_uploads
+    ) :
+        directory_(std::move(directory)),
+        slot_columns_(slot_columns),
+        max_uploads_(max_uploads) {}
+
+    path virtual_texture_cache::page_file_path(const uint64_t key) const
+    {
+        ostringstream stream;
+        stream << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+        return directory_ / stream.str();
+    }
+
+    auto virtual_texture_cache::staging() const noexcept -> pixel_type*
+    {
+        return reinterpret_cast<pixel_type*>(static_cast<uint8_t*>(host_data_) + host_offsets_[0]);
+    }
+
+    uint32_t* virtual_texture_cache::table() const noexcept
+    {
+        return reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(host_data_) + host_offsets_[1]);
+    }
+
+    uint32_t* virtual_texture_cache::feedback() const noexcept
+    {
+        return reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(host_data_) + host_offsets_[2]);
+    }
+
+    DeviceSize virtual_texture_cache::feedback_size() const noexcept
+    {
+        return std::max<DeviceSize>((pages_.size() + 31) / 32, 1) * sizeof(uint32_t);
+    }
+
+    uint32_t virtual_texture_cache::page_index(
+        const uint32_t texture,
+        const uint32_t level,
+        const uint32_t x,
+        const uint32_t y
+    ) const noexcept
+    {
+        const auto& info = textures_[texture].info;
+        const Extent3D extent{info.width, info.height, 1};
+        return info.table_offset + page_layout::level_offset(extent, level) +
+            y * page_layout::grid(extent, level).width + x;
+    }
+
+    optional<uint32_t> virtual_texture_cache::allocate_slot(const uint64_t frame)
+    {
+        optional<uint32_t> victim;
+        for(uint32_t i = 0; i < slots_.size(); ++i)
+        {
+            const auto& candidate = slots_[i];
+            if(!candidate.page) return i;
+
+            //pages used by the last frame stay, the least recently used of the others is replaced
+            if(candidate.pinned || candidate.last_used + 1 >= frame) continue;
+            if(!victim || candidate.last_used < slots_[*victim].last_used) victim = i;
+        }
+        if(victim) page_slots_[*slots_[*victim].page] = nullopt;
+        return victim;
+    }
+
+    void virtual_texture_cache::write_table(const device_object& device) const
+    {
+        auto* const entries = table();
+        for(uint32_t texture = 0; texture < textures_.size(); ++texture)
+        {
+            const auto& info = textures_[texture].info;
+            const Extent3D extent{info.width, info.height, 1};
+            for(auto level = info.levels; level-- > 0;)
+            {
+                const auto& grid = page_layout::grid(extent, level);
+                //odd extents can leave the last page of a level without a parent of its own
+                const auto& parent_grid = page_layout::grid(extent, level + 1);
+                for(uint32_t y = 0; y < grid.height; ++y)
+                    for(uint32_t x = 0; x < grid.width; ++x)
+                    {
+                        const auto index = page_index(texture, level, x, y);
+                        if(const auto& slot = page_slots_[index]; slot)
+                            entries[index] = (*slot % slot_columns_) |
+                                ((*slot / slot_columns_) << slot_bits) |
+                                (level << level_shift);
+                        else
+                            entries[index] = entries[page_index(
+                                texture,
+                                level + 1,
+                                std::min(x / 2, parent_grid.width - 1),
+                                std::min(y / 2, parent_grid.height - 1)
+                            )];
+                    }
+            }
+        }
+
+        device->flushMappedMemoryRanges(
+            MappedMemoryRange{*host_memory_, 0, constant::whole_size<DeviceSize>},
+            device.dispatch()
+        );
+    }
+
+    bool virtual_texture_cache::contains(const uint64_t key) const noexcept
+    {
+        try
+        {
+            const auto& file_path = page_file_path(key);
+            return std::filesystem::exists(file_path) && page_file{file_path}.is_valid(key);
+        }
+        catch(const std::exception&) { return false; }
+    }
+
+    void virtual_texture_cache::store(
+        const uint64_t key,
+        const Extent2D extent,
+        const pixel_type* const mip_chain
+    ) const noexcept
+    {
+        try { page_file::store(page_file_path(key), key, extent, mip_chain); }
+        catch(const std::exception&) {}
+    }
+
+    auto virtual_texture_cache::insert(const uint64_t key) -> texture_info
+    {
+        if(host_data_) throw std::logic_error{"virtual textures must be inserted before initialization"};
+
+        const auto& file_path = page_file_path(key);
+        page_file file{file_path};
+        if(!file.is_valid(key)) throw std::runtime_error{"invalid page file:" + file_path.string()};
+
+        const auto& extent = file.extent();
+        const texture_info info{
+            static_cast<uint32_t>(pages_.size()),
+            extent.width,
+            extent.height,
+            page_layout::levels(extent)
+        };
+        const auto texture = static_cast<uint32_t>(textures_.size());
+        for(uint32_t level = 0; level < info.levels; ++level)
+        {
+            const auto& grid = page_layout::grid(extent, level);
+            for(uint32_t y = 0; y < grid.height; ++y)
+                for(uint32_t x = 0; x < grid.width; ++x) pages_.push_back({texture, level, x, y});
+        }
+
+        textures_.push_back({std::move(file), info});
+        return info;
+    }
+
+    void virtual_texture_cache::initialize(const device_object& device, const PhysicalDevice physical_device)
+    {
+        slots_.resize(size_t{slot_columns_} * slot_columns_);
+        if(textures_.size() > slots_.size())
+            throw std::runtime_error{"the single page levels of virtual textures do not fit in the page cache"};
+
+        //viewed as a one layer array, so it can also fill the array texture binding of virtual meshes
+        const auto cache_size = slot_columns_ * page_layout::stride;
+        image_ = image_object{
+            image_object::base_info_type{
+                {},
+                ImageType::e2D,
+                Format::eR8G8B8A8Unorm,
+                {cache_size, cache_size, 1},
+                1,
+                1,
+                SampleCountFlagBits::e1,
+                ImageTiling::eOptimal,
+                ImageUsageFlagBits::eTransferDst | ImageUsageFlagBits::eSampled
+            }
+        };
+        image_.initialize(device);
+        image_memory_ = generate_image_memory_info(
+            device,
+            {*image_},
+            physical_device,
+            MemoryPropertyFlagBits::eDeviceLocal
+        ).first;
+        image_memory_.initialize(device);
+        device->bindImageMemory(*image_, *image_memory_, 0, device.dispatch());
+
+        image_view_ = image_view_object{
+            image_view_object::base_info_type{
+                {},
+                *image_,
+                ImageViewType::e2DArray,
+                Format::eR8G8B8A8Unorm,
+                {},
+                {ImageAspectFlagBits::eColor, 0, 1, 0, 1}
+            }
+        };
+        image_view_.initialize(device);
+
+        {
+            sampler_object::info_type info;
+            info.magFilter = info.minFilter = Filter::eLinear;
+            info.addressModeU = info.addressModeV = info.addressModeW = SamplerAddressMode::eClampToEdge;
+            info.compareOp = CompareOp::eAlways;
+            info.borderColor = BorderColor::eIntOpaqueBlack;
+            sampler_ = sampler_object{info};
+        }
+        sampler_.initialize(device);
+
+        const auto upload_capacity = std::max<size_t>(max_uploads_, textures_.size());
+        staging_buffer_ = buffer_object{
+            BufferCreateInfo{
+                {},
+                upload_capacity * page_layout::texel_count * sizeof(pixel_type),
+                BufferUsageFlagBits::eTransferSrc
+            }
+        };
+        table_buffer_ = buffer_object{
+            BufferCreateInfo{
+                {},
+                std::max<size_t>(pages_.size(), 1) * sizeof(uint32_t),
+                BufferUsageFlagBits::eStorageBuffer
+            }
+        };
+        feedback_buffer_ = buffer_object{
+            BufferCreateInfo{{}, feedback_size(), BufferUsageFlagBits::eStorageBuffer}
+        };
+        //the three buffers share one host visible allocation, in the order of the offsets
+        const array<buffer_object*, 3> host_buffers{&staging_buffer_, &table_buffer_, &feedback_buffer_};
+        for(auto* const buffer : host_buffers) buffer->initialize(device);
+
+        std::tie(host_memory_, host_offsets_) = generate_buffer_memory_info(
+            device,
+            {*staging_buffer_, *table_buffer_, *feedback_buffer_},
+            physical_device,
+            MemoryPropertyFlagBits::eHostVisible
+        );
+        host_memory_.initialize(device);
+        for(size_t i = 0; i < host_buffers.size(); ++i)
+            device->bindBufferMemory(**host_buffers[i], *host_memory_, host_offsets_[i], device.dispatch());
+        host_data_ = device->mapMemory(*host_memory_, 0, constant::whole_size<DeviceSize>, {}, device.dispatch());
+
+        //the single page level of every texture stays resident as the fallback of all its pages
+        page_slots_.assign(pages_.size(), nullopt);
+        for(uint32_t texture = 0; texture < textures_.size(); ++texture)
+        {
+            const auto& [file, info] = textures_[texture];
+            const auto page = page_index(texture, info.levels - 1, 0, 0);
+            const auto* const texels = file.page(page - info.table_offset);
+
+            slots_[texture] = {page, 0, true};
+            page_slots_[page] = texture;
+            std::copy(
+                texels,
+                texels + page_layout::texel_count,
+                staging() + size_t{texture} * page_layout::texel_count
+            );
+            uploads_.push_back({page, texture});
+        }
+
+        std::fill_n(feedback(), feedback_size() / sizeof(uint32_t), 0);
+        write_table(device);
+    }
+
+    vector<uint32_t> virtual_texture_cache::read_feedback(const device_object& device, const uint64_t frame)
+    {
+        const MappedMemoryRange range{*host_memory_, 0, constant::whole_size<DeviceSize>};
+        device->invalidateMappedMemoryRanges(range, device.dispatch());
+
+        vector<uint32_t> requested;
+        auto* const bits = feedback();
+        for(uint32_t word = 0; word < feedback_size() / sizeof(uint32_t); ++word)
+        {
+            if(bits[word] == 0) continue;
+
+            for(uint32_t bit = 0; bit < 32; ++bit)
+            {
+                if(((bits[word] >> bit) & 1) == 0) continue;
+
+                const auto page = word * 32 + bit;
+                if(const auto& slot = page_slots_[page]; slot) slots_[*slot].last_used = frame;
+                else requested.push_back(page);
+            }
+            bits[word] = 0;
+        }
+        device->flushMappedMemoryRanges(range, device.dispatch());
+
+        //coarse pages first, so a sudden burst of requests still sharpens everything a little
+        std::stable_sort(
+            requested.begin(),
+            requested.end(),
+            [this](const uint32_t left, const uint32_t right) { return pages_[left].level > pages_[right].level; }
+        );
+        return requested;
+    }
+
+    bool virtual_texture_cache::load(
+        const device_object& device,
+        const vector<uint32_t>& requested,
+        const uint64_t frame,
+        ::utility::thread_pool& thread_pool
+    )
+    {
+        for(const auto page : requested)
+        {
+            if(uploads_.size() >= max_uploads_) break;
+
+            const auto& slot = allocate_slot(frame);
+            if(!slot) break;
+
+            slots_[*slot] = {page, frame, false};
+            page_slots_[page] = *slot;
+            uploads_.push_back({page, *slot});
+        }
+        if(uploads_.empty()) return false;
+
+        //page reads may fault in file pages, so they are spread over the thread pool
+        vector<future<void>> copies;
+        copies.reserve(uploads_.size());
+        for(size_t i = 0; i < uploads_.size(); ++i)
+            copies.push_back(
+                thread_pool.submit(
+                    [this, i]
+                    {
+                        const auto& texture = textures_[pages_[uploads_[i].page].texture];
+                        const auto* const texels = texture.file.page(uploads_[i].page - texture.info.table_offset);
+                        std::copy(texels, texels + page_layout::texel_count, staging() + i * page_layout::texel_count);
+                    }
+                )
+            );
+        for(auto& copy : copies) copy.get();
+
+        write_table(device);
+        return true;
+    }
+
+    void virtual_texture_cache::write_transfer_command(const device_object& device, const CommandBuffer& command_buffer)
+    {
+        //the first call also moves the cache out of the undefined layout when there is nothing to copy
+        if(uploads_.empty() && is_uploaded_) return;
+
+        const ImageSubresourceRange range{ImageAspectFlagBits::eColor, 0, 1, 0, 1};
+        write_transfer_image_layout_command(
+            command_buffer,
+            *image_,
+            range,
+            is_uploaded_ ? ImageLayout::eShaderReadOnlyOptimal : ImageLayout::eUndefined,
+            ImageLayout::eTransferDstOptimal,
+            device.dispatch()
+        );
+
+        vector<BufferImageCopy> regions;
+        regions.reserve(uploads_.size());
+        for(size_t i = 0; i < uploads_.size(); ++i)
+            regions.push_back(
+                {
+                    i * page_layout::texel_count * sizeof(pixel_type),
+                    0,
+                    0,
+                    {ImageAspectFlagBits::eColor, 0, 0, 1},
+                    {
+                        static_cast<int32_t>(uploads_[i].slot % slot_columns_ * page_layout::stride),
+                        static_cast<int32_t>(uploads_[i].slot / slot_columns_ * page_layout::stride),
+                        0
+                    },
+                    {page_layout::stride, page_layout::stride, 1}
+                }
+            );
+        if(!regions.empty())
+            command_buffer.copyBufferToImage(
+                *staging_buffer_,
+                *image_,
+                ImageLayout::eTransferDstOptimal,
+                regions,
+                device.dispatch()
+            );
+
+        write_transfer_image_layout_command(
+            command_buffer,
+            *image_,
+            range,
+            ImageLayout::eTransferDstOptimal,
+            ImageLayout::eShaderReadOnlyOptimal,
+            device.dispatch()
+        );
+
+        is_uploaded_ = true;
+        uploads_.clear();
+    }
+
+    const image_view_object& virtual_texture_cache::image_view() const noexcept { return image_view_; }
+
+    const sampler_object& virtual_texture_cache::sampler() const noexcept { return sampler_; }
+
+    const buffer_object& virtual_texture_cache::table_buffer() const noexcept { return table_buffer_; }
+
+    const buffer_object& virtual_texture_cache::feedback_buffer() const noexcept { return feedback_buffer_; }
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "vulkan/utility/cache/texture_cache.h"
+#include "texture_streaming.h"
+
+namespace vulkan::utility
+{
+    //pages cover a square of texels of one mip level and carry a border for filtering across page edges
+    struct page_layout
+    {
+        static constexpr uint32_t size = 128;
+        static constexpr uint32_t border = 4;
+        static constexpr uint32_t stride = size + 2 * border;
+        static constexpr uint32_t texel_count = stride * stride;
+
+        //pages per row and column of a level
+        [[nodiscard]] static constexpr Extent2D grid(const Extent3D, const uint32_t) noexcept;
+
+        //levels down to the first one held by a single page
+        [[nodiscard]] static constexpr uint32_t levels(const Extent3D) noexcept;
+
+        //index of the first page of a level in the level-major page list of a texture
+        [[nodiscard]] static constexpr uint32_t level_offset(const Extent3D, const uint32_t) noexcept;
+    };
+
+    //mip chain of a texture cut into bordered pages and stored page after page, memory-mapped when read
+    class page_file
+    {
+    public:
+        using pixel_type = constant::format_t<Format::eR8G8B8A8Unorm>;
+
+        struct header
+        {
+            static constexpr uint32_t magic_value = 0x45475056;
+            static constexpr uint32_t version_value = 1;
+
+            uint32_t magic = magic_value;
+            uint32_t version = version_value;
+            uint64_t key = 0;
+            uint32_t width = 0;
+            uint32_t height = 0;
+            uint32_t page_size = page_layout::size;
+            uint32_t page_border = page_layout::border;
+        };
+
+    private:
+        boost::interprocess::file_mapping file_;
+        boost::interprocess::mapped_region region_;
+
+    public:
+        explicit page_file(const path&);
+
+        [[nodiscard]] bool is_valid(const uint64_t) const noexcept;
+
+        [[nodiscard]] const header& get_header() const noexcept;
+        [[nodiscard]] Extent3D extent() const noexcept;
+
+        [[nodiscard]] const pixel_type* page(const uint32_t) const noexcept;
+
+        //tiles a packed mip chain with repeat addressing at the page borders, best-effort like the texture cache
+        static void store(const path&, const uint64_t, const Extent2D, const pixel_type*) noexcept;
+    };
+
+    //software virtual texturing: a physical page cache image, a page table storage buffer telling the shader
+    //which cache slot holds the finest resident page of each virtual page, and a feedback storage buffer
+    //with one bit per virtual page the shader asked for
+    class virtual_texture_cache
+    {
+    public:
+        using pixel_type = page_file::pixel_type;
+
+        //layout of the per texture data the fragment shader reads from push constants
+        struct texture_info
+        {
+            uint32_t table_offset = 0;
+            uint32_t width = 0;
+            uint32_t height = 0;
+            uint32_t levels = 0;
+        };
+
+        static constexpr uint32_t slot_bits = 10;
+        static constexpr uint32_t level_shift = 2 * slot_bits;
+
+    private:
+        struct texture
+        {
+            page_file file;
+            texture_info info;
+        };
+
+        struct page
+        {
+            uint32_t texture;
+            uint32_t level;
+            uint32_t x;
+            uint32_t y;
+        };
+
+        struct slot
+        {
+            optional<uint32_t> page;
+            uint64_t last_used = 0;
+            bool pinned = false;
+        };
+
+        struct upload
+        {
+            uint32_t page;
+            uint32_t slot;
+        };
+
+        path directory_;
+        uint32_t slot_columns_;
+        uint32_t max_uploads_;
+
+        vector<texture> textures_;
+        vector<page> pages_;
+        vector<optional<uint32_t>> page_slots_;
+        vector<slot> slots_;
+        vector<upload> uploads_;
+
+        image_object image_;
+        device_memory_object image_memory_;
+        image_view_object image_view_;
+        sampler_object sampler_;
+
+        buffer_object staging_buffer_;
+        buffer_object table_buffer_;
+        buffer_object feedback_buffer_;
+        device_memory_object host_memory_;
+        vector<DeviceSize> host_offsets_;
+        void* host_data_ = nullptr;
+
+        bool is_uploaded_ = false;
+
+        [[nodiscard]] path page_file_path(const uint64_t) const;
+
+        [[nodiscard]] pixel_type* staging() const noexcept;
+        [[nodiscard]] uint32_t* table() const noexcept;
+        [[nodiscard]] uint32_t* feedback() const noexcept;
+        [[nodiscard]] DeviceSize feedback_size() const noexcept;
+
+        //index of a page in the page table and the feedback bits, from texture, level and page coordinates
+        [[nodiscard]] uint32_t page_index(
+            const uint32_t,
+            const uint32_t,
+            const uint32_t,
+            const uint32_t
+        ) const noexcept;
+
+        [[nodiscard]] optional<uint32_t> allocate_slot(const uint64_t);
+
+        //every page points to its finest resident ancestor, so sampling falls back to a coarser level
+        void write_table(const device_object&) const;
+
+    public:
+        explicit virtual_texture_cache(path, const uint32_t = 16, const uint32_t = 32);
+
+        [[nodiscard]] bool contains(const uint64_t) const noexcept;
+
+        //cuts a packed mip chain into the page file of a key
+        void store(const uint64_t, const Extent2D, const pixel_type*) const noexcept;
+
+        [[nodiscard]] texture_info insert(const uint64_t);
+
+        void initialize(const device_object&, const PhysicalDevice);
+
+        //reads and clears the pages the shader asked for in the last frame, coarse pages first
+        [[nodiscard]] vector<uint32_t> read_feedback(const device_object&, const uint64_t);
+
+        //assigns cache slots to missing pages and copies them from their page files into staging memory,
+        //returns false when nothing has to be uploaded
+        bool load(const device_object&, const vector<uint32_t>&, const uint64_t, ::utility::thread_pool&);
+
+        void write_transfer_command(const device_object&, const CommandBuffer&);
+
+        [[nodiscard]] const image_view_object& image_view() const noexcept;
+        [[nodiscard]] const sampler_object& sampler() const noexcept;
+        [[nodiscard]] const buffer_object& table_buffer() const noexcept;
+        [[nodiscard]] const buffer_object& feedback_buffer() const noexcept;
+    };
+}
+
+#include "virtual_texture.tpp"
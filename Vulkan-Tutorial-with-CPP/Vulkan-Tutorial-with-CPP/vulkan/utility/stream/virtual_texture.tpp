@@ -0,0 +1,26 @@
+#pragma once
+
+namespace vulkan::utility
+{
+    constexpr Extent2D page_layout::grid(const Extent3D extent, const uint32_t level) noexcept
+    {
+        const auto& level_extent = mip_level_extent(extent, level);
+        return {(level_extent.width + size - 1) / size, (level_extent.height + size - 1) / size};
+    }
+
+    constexpr uint32_t page_layout::levels(const Extent3D extent) noexcept
+    {
+        return tail_mip_level(extent, size) + 1;
+    }
+
+    constexpr uint32_t page_layout::level_offset(const Extent3D extent, const uint32_t level) noexcept
+    {
+        uint32_t offset = 0;
+        for(uint32_t i = 0; i < level; ++i)
+        {
+            const auto& level_grid = grid(extent, i);
+            offset += level_grid.width * level_grid.height;
+        }
+        return offset;
+    }
+}
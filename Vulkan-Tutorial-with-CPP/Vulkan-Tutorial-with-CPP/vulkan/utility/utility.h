@@ -2,6 +2,19 @@
 
 #include "obejct/image.h"
 #include "obejct/static_memory.h"
+#include "cache/texture_cache.h"
+#include "cache/interner.h"
+#include "cache/mesh_cache.h"
+#include "cache/tangent_cache.h"
+#include "mesh/vertex_cache.h"
+#include "mesh/meshlet.h"
+#include "mesh/bvh.h"
+#include "mesh/meshopt_codec.h"
+#include "mesh/tangent.h"
+#include "animation/animation_tracks.h"
+#include "stream/texture_streaming.h"
+#include "stream/texture_budget.h"
+#include "stream/virtual_texture.h"
 #include "stb/image.h"
 #include "shaderc/shaderc.h"
 #include <tiny_obj_loader.h>
\ No newline at end of file
@@ -1,8 +1,14 @@
 ﻿#include "vulkan_sample.h"
+#include "glm_camera.h"
+#include <cstring>
 
 namespace vulkan
 {
     const string vulkan_sample::window_title = "vulkan";
+    const path vulkan_sample::skinned_test_model_path = path{"resource"} / "skinned_strip" / "scene.gltf";
+    const path vulkan_sample::model_path = use_skinned_test_model ?
+        skinned_test_model_path :
+        path{"resource"} / "interior_scene_-_living" / "scene.gltf";
 
     void vulkan_sample::initialize_window() noexcept
     {
@@ -105,7 +111,14 @@ namespace vulkan
         const surface_object& surface_object
     )
     {
-        if(physical_device.getProperties(instance_.dispatch()).deviceType == PhysicalDeviceType::eDiscreteGpu)
+        constexpr auto device_type = use_software_rasterizer ?
+            PhysicalDeviceType::eCpu :
+            PhysicalDeviceType::eDiscreteGpu;
+        const auto& features = physical_device.getFeatures(instance_.dispatch());
+
+        //the fragment shader reports the virtual texture pages it samples with storage buffer atomics
+        if(physical_device.getProperties(instance_.dispatch()).deviceType == device_type &&
+            features.samplerAnisotropy && features.fragmentStoresAndAtomics)
         {
             size_t i = 0;
             for(const auto& p : physical_device.getQueueFamilyProperties(instance_.dispatch()))
@@ -133,6 +146,12 @@ namespace vulkan
     void vulkan_sample::initialize_physical_device()
     {
         physical_device_ = {*instance_, [this](const auto& d) { return generate_physical_device(d, surface_); }};
+        if(!*physical_device_)
+            throw std::runtime_error(
+                use_software_rasterizer ?
+                    "no software rasterizer with fragment stores and atomics is available!" :
+                    "no discrete gpu with fragment stores and atomics is available!"
+            );
     }
 
     void vulkan_sample::generate_device_create_info()
@@ -142,6 +161,8 @@ namespace vulkan
         using set_type = decay_to_origin_t<decltype(device_.info().queue_create_infos_set_property())>;
         PhysicalDeviceFeatures features;
         features.samplerAnisotropy = true;
+        //the fragment shader reports the virtual texture pages it samples
+        features.fragmentStoresAndAtomics = true;
         device_ = device_type{
             device_info_type{
                 {
@@ -173,9 +194,79 @@ namespace vulkan
     }
 
     void vulkan_sample::generate_model()
+    {
+        if(model_path.extension() == ".gltf" || model_path.extension() == ".glb")
+        {
+            load_scene();
+            return;
+        }
+
+        load_obj_model();
+
+        const auto& directory = model_path.parent_path();
+        texture_paths_ = {
+            directory / "Alyscamps_Arles_dos.jpg",
+            directory / "bad1.jpg",
+            directory / "belye.jpg",
+            directory / "chair1.jpg",
+            directory / "doors1.jpg",
+            directory / "floor1.jpg",
+            directory / "glass_left.png",
+            directory / "glass_right.png",
+            directory / "rest.jpg",
+            directory / "table.jpg",
+            directory / "veshalka.jpg",
+            directory / "wall1.jpg",
+            directory / "wall_staff.jpg",
+            directory / "win_left.jpg",
+            directory / "win_right.jpg"
+        };
+
+        //untextured obj materials keep their diffuse color
+        materials_ = ::utility::container_transform<decltype(materials_)>(
+            model_.materials,
+            [](const tinyobj::material_t& material)
+            {
+                return material_binding{
+                    path{material.diffuse_texname}.stem().generic_u8string(),
+                    material.diffuse_texname.empty() ? vec4{make_vec3(material.diffuse), 1} : vec4{1}
+                };
+            }
+        );
+    }
+
+    void vulkan_sample::load_obj_model()
     {
         string err, warn;
-        const auto& model_path = path{"resource"} / "room" / "room.obj";
+
+        //material ids follow the order of the material library, so it is part of the cache key
+        path material_path;
+        {
+            ifstream stream{model_path};
+            for(string line; std::getline(stream, line);)
+                if(line.rfind("mtllib ", 0) == 0)
+                {
+                    line.erase(line.find_last_not_of(" \t\r") + 1);
+                    material_path = model_path.parent_path() / line.substr(7);
+                    break;
+                }
+        }
+
+        model_key_ = model_cache::key(model_path, material_path.empty() ? 0 : file_hash(material_path));
+        model_cache_entry_ = mesh_cache_.find(model_key_);
+
+        //a warm start only parses the material library, the geometry comes welded from the cache
+        if(model_cache_entry_)
+        {
+            if(material_path.empty()) return;
+
+            ifstream stream{material_path};
+            map<string, int> material_map;
+            tinyobj::LoadMtl(&material_map, &model_.materials, &stream, &warn, &err);
+            std::cout << warn;
+            if(!err.empty()) throw std::runtime_error{err};
+            return;
+        }
 
         if(!LoadObj(
             &model_.attribute,
@@ -190,6 +281,54 @@ namespace vulkan
         std::cout << warn;
     }
 
+    void vulkan_sample::load_scene()
+    {
+        scene_.emplace(model_path);
+        scene_start_ = time::steady_clock_timer();
+
+        //the converted buffers of the primitives are cached like a welded obj model
+        model_key_ = model_cache::key(scene_->get_content_hash());
+        model_cache_entry_ = mesh_cache_.find(model_key_);
+
+        //materials sample the images of their base color and normal textures, decoded from their files next to
+        //the scene like any other texture, embedded images are left untextured
+        const auto& directory = model_path.parent_path();
+        const auto& add_texture = [this, &directory](const gltf_model::material::material_texture_type& texture)
+            -> string
+        {
+            const auto& image = **texture.first.image;
+            if(image.uri.empty()) return {};
+
+            const auto& texture_path = directory / path{image.uri};
+            auto name = texture_path.stem().generic_u8string();
+
+            //filtering and wrapping come from the scene, anisotropy stays with the default sampler
+            const auto& gltf_info = *texture.first.sampler_create_info;
+            auto info = generate_texture_sampler_create_info();
+            info.magFilter = gltf_info.magFilter;
+            info.minFilter = gltf_info.minFilter;
+            info.mipmapMode = gltf_info.mipmapMode;
+            info.addressModeU = gltf_info.addressModeU;
+            info.addressModeV = gltf_info.addressModeV;
+            info.addressModeW = gltf_info.addressModeW;
+            texture_sampler_infos_.try_emplace(name, info);
+
+            if(std::find(texture_paths_.cbegin(), texture_paths_.cend(), texture_path) == texture_paths_.cend())
+                texture_paths_.push_back(texture_path);
+            return name;
+        };
+        for(const auto& material : scene_->get_materials())
+        {
+            auto& binding = materials_.emplace_back();
+            binding.base_color_factor = material.base_color_factor;
+            if(material.base_color_texture) binding.texture_name = add_texture(*material.base_color_texture);
+
+            //only the first texture coordinate set is uploaded, which the tangents have to be generated for
+            if(material.normal_texture && material.normal_texture->second == 0)
+                binding.normal_texture_name = add_texture(*material.normal_texture);
+        }
+    }
+
     void vulkan_sample::generate_shader_module_create_infos()
     {
         using shader_module_type = decltype(vertex_shader_module_);
@@ -198,9 +337,12 @@ namespace vulkan
         const auto& shaders_path = path{"resource"} / "shaders";
         const auto& vertex_shader_code_path = shaders_path / "shader.vert";
         const auto& fragment_shader_code_path = shaders_path / "shader.frag";
+        const auto& cull_shader_code_path = shaders_path / "cull.comp";
+        const auto& skin_shader_code_path = shaders_path / "skin.comp";
         CompileOptions options;
         options.SetGenerateDebugInfo();
         options.SetOptimizationLevel(shaderc_optimization_level_performance);
+        if constexpr(use_compact_vertex) options.AddMacroDefinition("COMPACT_VERTEX");
 
         cfin.open(vertex_shader_code_path);
         if(!cfin) throw std::runtime_error("failed to load vertex code file\n");
@@ -238,6 +380,44 @@ namespace vulkan
             fragment_shader_module_ = shader_module_type{shader_module_info_type{std::move(spriv_code)}};
         }
         cfin.close();
+
+        cfin.open(cull_shader_code_path);
+        if(!cfin) throw std::runtime_error("failed to load cull code file\n");
+        csout.str("");
+        csout << cfin.rdbuf();
+        {
+            auto&& [spriv_code, error_str, status] = glsl_compile_to_spriv(
+                csout.str(),
+                shaderc_compute_shader,
+                "cull",
+                options
+            );
+            if(status != shaderc_compilation_status_success)
+                throw std::runtime_error(
+                    "cull code compile failure\n" + error_str
+                );
+            cull_shader_module_ = shader_module_type{shader_module_info_type{std::move(spriv_code)}};
+        }
+        cfin.close();
+
+        cfin.open(skin_shader_code_path);
+        if(!cfin) throw std::runtime_error("failed to load skin code file\n");
+        csout.str("");
+        csout << cfin.rdbuf();
+        {
+            auto&& [spriv_code, error_str, status] = glsl_compile_to_spriv(
+                csout.str(),
+                shaderc_compute_shader,
+                "skin",
+                options
+            );
+            if(status != shaderc_compilation_status_success)
+                throw std::runtime_error(
+                    "skin code compile failure\n" + error_str
+                );
+            skin_shader_module_ = shader_module_type{shader_module_info_type{std::move(spriv_code)}};
+        }
+        cfin.close();
     }
 
     void vulkan_sample::generate_descriptor_set_layout_create_info()
@@ -253,123 +433,759 @@ namespace vulkan
                         DescriptorType::eCombinedImageSampler,
                         1,
                         ShaderStageFlagBits::eFragment
+                    },
+                    DescriptorSetLayoutBinding{
+                        2,
+                        DescriptorType::eCombinedImageSampler,
+                        1,
+                        ShaderStageFlagBits::eFragment
+                    },
+                    DescriptorSetLayoutBinding{3, DescriptorType::eStorageBuffer, 1, ShaderStageFlagBits::eFragment},
+                    DescriptorSetLayoutBinding{4, DescriptorType::eStorageBuffer, 1, ShaderStageFlagBits::eFragment},
+                    DescriptorSetLayoutBinding{5, DescriptorType::eStorageBuffer, 1, ShaderStageFlagBits::eVertex},
+                    DescriptorSetLayoutBinding{
+                        6,
+                        DescriptorType::eCombinedImageSampler,
+                        1,
+                        ShaderStageFlagBits::eFragment
                     }
                 }
             }
         };
     }
 
-    map<string, stb::image<channel::rgb_alpha>> vulkan_sample::generate_texture_image_create_info()
+    void vulkan_sample::generate_texture_image_create_info()
     {
-        const auto& directory = path{"resource"} / "room";
-        const auto& paths = {
-            directory / "Alyscamps_Arles_dos.jpg",
-            directory / "bad1.jpg",
-            directory / "belye.jpg",
-            directory / "chair1.jpg",
-            directory / "doors1.jpg",
-            directory / "floor1.jpg",
-            directory / "glass_left.png",
-            directory / "glass_right.png",
-            directory / "rest.jpg",
-            directory / "table.jpg",
-            directory / "veshalka.jpg",
-            directory / "wall1.jpg",
-            directory / "wall_staff.jpg",
-            directory / "win_left.jpg",
-            directory / "win_right.jpg"
+        //only the cache entries or image headers are read here, decoding is deferred to the thread pool
+        for(const auto& path : texture_paths_)
+        {
+            const auto key = decltype(texture_cache_)::key(path);
+            auto&& cached = texture_cache_.find(key);
+            Extent3D extent;
+            if(cached) extent = cached->extent();
+            else
+            {
+                const auto& [width, height, real_channel] = stb::image_info(path);
+                extent = {static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1};
+            }
+
+            const auto& name = path.stem().generic_u8string();
+            auto& source = texture_sources_[name] = {path, key, extent, std::move(cached)};
+            const auto& sampler_info = texture_sampler_infos_.find(name);
+            source.sampler_info = sampler_info != texture_sampler_infos_.cend() ?
+                sampler_info->second :
+                generate_texture_sampler_create_info();
+        }
+
+        //a texture used by several material slots is treated as the most important of them
+        map<string, texture_slot> slots;
+        for(const auto& material : model_.materials)
+            for(const auto& [texture_name, slot] : {
+                    pair{&material.diffuse_texname, texture_slot::base_color},
+                    pair{&material.emissive_texname, texture_slot::emissive},
+                    pair{&material.bump_texname, texture_slot::normal},
+                    pair{&material.normal_texname, texture_slot::normal},
+                    pair{&material.specular_texname, texture_slot::specular},
+                    pair{&material.ambient_texname, texture_slot::occlusion},
+                    pair{&material.roughness_texname, texture_slot::metallic_roughness},
+                    pair{&material.metallic_texname, texture_slot::metallic_roughness}
+                })
+            {
+                if(texture_name->empty()) continue;
+
+                const auto& [it, is_inserted] = slots.try_emplace(path{*texture_name}.stem().generic_u8string(), slot);
+                if(!is_inserted && texture_budget_policy_.at(slot).weight > texture_budget_policy_.at(it->second).weight)
+                    it->second = slot;
+            }
+        //gltf materials only mark their normal textures, their base color ones keep the default slot
+        for(const auto& binding : materials_)
+            if(!binding.normal_texture_name.empty())
+                slots.try_emplace(binding.normal_texture_name, texture_slot::normal);
+        for(const auto& [name, slot] : slots)
+            if(const auto& it = texture_sources_.find(name); it != texture_sources_.end()) it->second.slot = slot;
+
+        //textures with identical content and sampler state are uploaded once, cached sources compare their
+        //decoded pixels and uncached ones fall back to the source file content
+        interner<const string> texture_interner;
+        map<string, string> canonical_names;
+        for(const auto& [name, source] : texture_sources_)
+        {
+            using pixel_type = decltype(texture_cache_)::pixel_type;
+
+            const auto& canonical_name = texture_interner.intern(
+                hash_combine(
+                    source.cached ? source.cached->get_header().content_hash : source.key,
+                    sampler_hash(source.sampler_info)
+                ),
+                mip_level_texel_offset(source.extent, mip_levels(source.extent)) * sizeof(pixel_type),
+                [&name = name] { return name; },
+                [this, &source = source](const string& interned)
+                {
+                    const auto& other = texture_sources_.at(interned);
+                    if(source.sampler_info != other.sampler_info) return false;
+                    if(source.cached && other.cached)
+                        return source.extent == other.extent && std::equal(
+                            source.cached->cbegin(),
+                            source.cached->cbegin() + mip_level_texel_offset(source.extent, 1),
+                            other.cached->cbegin()
+                        );
+                    return !source.cached && !other.cached && source.key == other.key;
+                }
+            );
+            canonical_names.emplace(name, *canonical_name);
+        }
+
+        if constexpr(is_debug)
+        {
+            const auto& statistics = texture_interner.get_statistics();
+            std::cout << "textures: " << statistics.unique << " unique of " << statistics.requests << ", " <<
+                statistics.saved_bytes << " bytes saved\n";
+        }
+
+        //small textures of the same extent and sampler state are packed as layers of one array image
+        const auto max_layers = physical_device_->getProperties(instance_.dispatch()).limits.maxImageArrayLayers;
+        map<tuple<uint32_t, uint32_t, uint64_t>, string> open_arrays;
+        for(auto& [name, source] : texture_sources_)
+        {
+            //duplicates sample the layer of the texture they were interned to
+            if(const auto& canonical_name = canonical_names.at(name); canonical_name != name)
+            {
+                const auto& canonical = texture_sources_.at(canonical_name);
+                source.array_name = canonical.array_name;
+                source.array_layer = canonical.array_layer;
+                source.is_virtual = canonical.is_virtual;
+                continue;
+            }
+
+            const decltype(open_arrays)::key_type array_key{
+                source.extent.width,
+                source.extent.height,
+                sampler_hash(source.sampler_info)
+            };
+
+            //larger textures are paged through the virtual texture cache, only the visible pages are resident
+            if(source.extent.width > texture_array_max_size || source.extent.height > texture_array_max_size)
+            {
+                source.array_name = name;
+                source.is_virtual = true;
+                continue;
+            }
+
+            if(const auto& it = open_arrays.find(array_key); it != open_arrays.end() &&
+                texture_arrays_[it->second].size() < max_layers &&
+                texture_sources_.at(it->second).sampler_info == source.sampler_info)
+                source.array_name = it->second;
+            else
+            {
+                source.array_name = name;
+                open_arrays.insert_or_assign(array_key, name);
+            }
+
+            auto& layers = texture_arrays_[source.array_name];
+            source.array_layer = static_cast<uint32_t>(layers.size());
+            layers.push_back(name);
+        }
+
+        using pixel_type = format_t<decltype(texture_image_map_)::mapped_type::format_value>;
+
+        //an array image keeps the resolution its most important layer asks for
+        vector<texture_budget_request<string>> budget_requests;
+        budget_requests.reserve(texture_arrays_.size());
+        for(const auto& [array_name, layers] : texture_arrays_)
+        {
+            const auto& slot = texture_sources_.at(
+                *std::max_element(
+                    layers.cbegin(),
+                    layers.cend(),
+                    [this](const string& left, const string& right)
+                    {
+                        return texture_budget_policy_.at(texture_sources_.at(left).slot).weight <
+                            texture_budget_policy_.at(texture_sources_.at(right).slot).weight;
+                    }
+                )
+            ).slot;
+            budget_requests.push_back(
+                {array_name, texture_sources_.at(layers.front()).extent, sizeof(pixel_type) * layers.size(), slot}
+            );
+        }
+
+        //oversized textures never load the levels above their floor, so they are effectively downscaled
+        //with the mip chain filter, the same budget caps what streaming may make resident
+        const auto budget = texture_budget(
+            physical_device_->getMemoryProperties(instance_.dispatch()),
+            texture_budget_policy_
+        );
+        const auto& floor_levels = fit_texture_budget(budget_requests, budget, texture_budget_policy_);
+        texture_residency_ = decltype(texture_residency_){budget};
+
+        for(const auto& [array_name, layers] : texture_arrays_)
+        {
+            const auto& extent = texture_sources_.at(layers.front()).extent;
+            const auto layer_count = static_cast<uint32_t>(layers.size());
+            const auto floor_level = floor_levels.at(array_name);
+
+            //textures start with their small mip tail resident, finer levels are streamed on demand
+            const auto tail_level = std::max(tail_mip_level(extent, resident_tail_size), floor_level);
+            texture_image_map_[array_name] = generate_texture_image(extent, layer_count, tail_level);
+            texture_residency_.insert(array_name, extent, sizeof(pixel_type) * layer_count, tail_level, floor_level);
+
+            if constexpr(is_debug)
+                if(floor_level > 0)
+                    std::cout << "texture " << array_name << " downscaled by " << floor_level << " levels\n";
+        }
+    }
+
+    auto vulkan_sample::generate_texture_image(
+        const Extent3D extent,
+        const uint32_t layers,
+        const uint32_t base_level
+    ) -> texture_image<Format::eR8G8B8A8Unorm>
+    {
+        return {
+            ImageType::e2D,
+            mip_level_extent(extent, base_level),
+            {},
+            {},
+            {{mip_levels(extent) - base_level, layers}},
+            {},
+            true
         };
+    }
 
-        map<string, stb::image<channel::rgb_alpha>> image_sources;
+    pair<vec3, vec3> vulkan_sample::quantization_bounds(const bounding_sphere& bounds) noexcept
+    {
+        return {bounds.center - bounds.radius, bounds.center + bounds.radius};
+    }
 
-        for(const auto& path : paths)
-            image_sources[path.stem().generic_u8string()] = stb::image<channel::rgb_alpha>{path};
+    auto vulkan_sample::make_draw_transform(const mat4& world_matrix) noexcept -> draw_transform
+    {
+        return {world_matrix, determinant(world_matrix) != 0 ? inverse(world_matrix) : mat4{0}};
+    }
 
-        return image_sources;
+    bool vulkan_sample::is_skinned(const gltf_model::draw& draw) noexcept
+    {
+        return draw.skin > -1 && !draw.mesh_primitive->skin_vertices.empty();
     }
 
-    pair<vector<vertex>, vector<uint32_t>> vulkan_sample::generate_buffer_allocate_info()
+    auto vulkan_sample::weld_model() -> tuple<vector<model_cache::mesh>, vector<vertex>, vector<uint32_t>>
     {
+        //attributes as parsed, the vertex format is only made once the bounds of the mesh are known
+        struct parsed_vertex
+        {
+            vec3 pos;
+            vec3 normal;
+            vec2 texture_coordinate;
+        };
+
+        //vertices are welded by their raw bytes, so hashing and comparing agree on every bit pattern
         struct vertex_hasher
         {
-            size_t operator()(const vertex& v) const
-            {
-                const auto hash_pos = std::hash<decltype(v.pos)>{}(v.pos);
-                const auto hash_color = std::hash<decltype(v.color)>{}(v.color);
-                const auto hash_tex_coordinate = std::hash<decltype(v.texture_coordinate)>{}(v.texture_coordinate);
+            size_t operator()(const parsed_vertex& v) const { return xxhash64(&v, sizeof(parsed_vertex)); }
+        };
 
-                return hash_pos ^ hash_color << 1 ^ hash_tex_coordinate << 2;
+        struct vertex_equal
+        {
+            bool operator()(const parsed_vertex& left, const parsed_vertex& right) const
+            {
+                return std::memcmp(&left, &right, sizeof(parsed_vertex)) == 0;
             }
         };
 
-        vector<uint32_t> indices;
+        using vertex_map = flat_hash_map<parsed_vertex, uint32_t, vertex_hasher, vertex_equal>;
 
-        unordered_map<vertex, uint32_t, vertex_hasher> vertices_map;
-        vector<vertex> vertices;
+        struct welded_shape
+        {
+            vertex_map vertices;
+            vector<uint32_t> indices;
+            bounding_sphere bounds;
+            vec2 texture_coordinate_span{};
+            pair<float, float> average_cache_miss_ratios{};
+        };
 
-        meshes_.reserve(model_.shapes.size());
+        //every shape is welded on its own thread, the local vertices are merged in shape order afterwards
+        vector<future<welded_shape>> welds;
+        welds.reserve(model_.shapes.size());
         for(const auto& shape : model_.shapes)
+            welds.push_back(
+                thread_pool_.submit(
+                    [this, &mesh = shape.mesh]
+                    {
+                        welded_shape welded{vertex_map{mesh.indices.size()}};
+                        welded.indices.reserve(mesh.indices.size());
+
+                        //bounds of the mesh and the texture area it covers drive the mip streaming demand
+                        vec3 min_pos{numberic_max<float>};
+                        vec3 max_pos{numberic_lowest<float>};
+                        vec2 min_texture_coordinate{numberic_max<float>};
+                        vec2 max_texture_coordinate{numberic_lowest<float>};
+                        for(const auto& index : mesh.indices)
+                        {
+                            //normals only take part in welding when the vertex format keeps them
+                            vec3 normal{0};
+                            if constexpr(use_compact_vertex)
+                                if(index.normal_index >= 0)
+                                    normal = {
+                                        model_.attribute.normals[3 * index.normal_index + 0],
+                                        model_.attribute.normals[3 * index.normal_index + 1],
+                                        model_.attribute.normals[3 * index.normal_index + 2]
+                                    };
+
+                            const parsed_vertex vertex = {
+                                {
+                                    model_.attribute.vertices[3 * index.vertex_index + 0],
+                                    model_.attribute.vertices[3 * index.vertex_index + 1],
+                                    model_.attribute.vertices[3 * index.vertex_index + 2]
+                                },
+                                normal,
+                                {
+                                    model_.attribute.texcoords[2 * index.texcoord_index],
+                                    1 - model_.attribute.texcoords[2 * index.texcoord_index + 1]
+                                }
+                            };
+                            min_pos = min(min_pos, vertex.pos);
+                            max_pos = max(max_pos, vertex.pos);
+                            min_texture_coordinate = min(min_texture_coordinate, vertex.texture_coordinate);
+                            max_texture_coordinate = max(max_texture_coordinate, vertex.texture_coordinate);
+
+                            welded.indices.push_back(
+                                welded.vertices.try_emplace(
+                                    vertex,
+                                    static_cast<uint32_t>(welded.vertices.size())
+                                ).first->second
+                            );
+                        }
+                        if(!mesh.indices.empty())
+                        {
+                            welded.bounds = {(min_pos + max_pos) / 2.0f, distance(min_pos, max_pos) / 2};
+                            welded.texture_coordinate_span = max_texture_coordinate - min_texture_coordinate;
+                        }
+
+                        //triangles are reordered for the post-transform cache, then their clusters for overdraw
+                        auto* const indices_begin = welded.indices.data();
+                        auto* const indices_end = indices_begin + welded.indices.size();
+                        welded.average_cache_miss_ratios.first = average_cache_miss_ratio(indices_begin, indices_end);
+                        optimize_overdraw(
+                            indices_begin,
+                            indices_end,
+                            optimize_vertex_cache(indices_begin, indices_end, welded.vertices.size()),
+                            [&vertices = welded.vertices](const uint32_t index)
+                            {
+                                return (vertices.begin() + index)->first.pos;
+                            }
+                        );
+                        welded.average_cache_miss_ratios.second = average_cache_miss_ratio(indices_begin, indices_end);
+                        return welded;
+                    }
+                )
+            );
+
+        vector<welded_shape> welded_shapes;
+        welded_shapes.reserve(welds.size());
+        size_t vertex_count = 0;
+        size_t index_count = 0;
+        for(auto& weld : welds)
         {
-            const auto& mesh = shape.mesh;
-            meshes_.push_back(
+            const auto& welded = welded_shapes.emplace_back(weld.get());
+            vertex_count += welded.vertices.size();
+            index_count += welded.indices.size();
+        }
+
+        //compact vertices are quantized in the bounds of their mesh, so only full ones are shared between meshes
+        vertex_map vertices_map{use_compact_vertex ? 0 : vertex_count};
+        vector<vertex> vertices;
+        vertices.reserve(vertex_count);
+        vector<uint32_t> indices;
+        indices.reserve(index_count);
+        vector<uint32_t> remap;
+        pair<float, float> average_cache_miss_ratios{};
+
+        vector<model_cache::mesh> mesh_table;
+        mesh_table.reserve(model_.shapes.size());
+        for(size_t i = 0; i < model_.shapes.size(); ++i)
+        {
+            const auto& mesh = model_.shapes[i].mesh;
+            const auto& welded = welded_shapes[i];
+            mesh_table.push_back(
                 {
                     static_cast<uint32_t>(indices.size()),
-                    static_cast<uint32_t>(mesh.indices.size()),
-                    mesh.material_ids.size() ?
-                    &texture_image_map_[path{model_.materials[mesh.material_ids.front()].diffuse_texname}.stem().
-                        generic_u8string()] :
-                    nullptr
+                    static_cast<uint32_t>(welded.indices.size()),
+                    mesh.material_ids.empty() ? -1 : mesh.material_ids.front(),
+                    welded.bounds,
+                    welded.texture_coordinate_span
                 }
             );
-            for(const auto& index : mesh.indices)
+
+            //vertices are merged in the order the optimized indices first use them, so fetches stay sequential
+            const auto& bounds = quantization_bounds(welded.bounds);
+            remap.assign(welded.vertices.size(), UINT32_MAX);
+            for(const auto index : welded.indices)
+            {
+                auto& global_index = remap[index];
+                if(global_index == UINT32_MAX)
+                {
+                    const auto& parsed = (welded.vertices.begin() + index)->first;
+                    const auto next_index = static_cast<uint32_t>(vertices.size());
+                    if constexpr(use_compact_vertex) global_index = next_index;
+                    else global_index = vertices_map.try_emplace(parsed, next_index).first->second;
+                    if(global_index == next_index)
+                        vertices.push_back(
+                            make_vertex(parsed.pos, parsed.normal, parsed.texture_coordinate, vec4{0}, bounds)
+                        );
+                }
+                indices.push_back(global_index);
+            }
+
+            const auto triangle_count = static_cast<float>(welded.indices.size() / 3);
+            average_cache_miss_ratios.first += welded.average_cache_miss_ratios.first * triangle_count;
+            average_cache_miss_ratios.second += welded.average_cache_miss_ratios.second * triangle_count;
+        }
+
+        if constexpr(is_debug)
+            std::cout << "vertex cache: acmr " <<
+                average_cache_miss_ratios.first / std::max(static_cast<float>(indices.size() / 3), 1.0f) << " -> " <<
+                average_cache_miss_ratios.second / std::max(static_cast<float>(indices.size() / 3), 1.0f) << '\n';
+
+        return {std::move(mesh_table), std::move(vertices), std::move(indices)};
+    }
+
+    auto vulkan_sample::generate_scene_layout() const
+        -> tuple<vector<model_cache::mesh>, vector<mat4>, pair<size_t, size_t>>
+    {
+        const auto& draws = scene_->get_draws();
+
+        vector<model_cache::mesh> mesh_table;
+        vector<mat4> world_matrices;
+        mesh_table.reserve(draws.size());
+        world_matrices.reserve(draws.size());
+        pair<size_t, size_t> buffer_sizes{};
+        for(const auto& draw : draws)
+        {
+            const auto& primitive = *draw.mesh_primitive;
+            world_matrices.push_back(draw.world_matrix * vertex_matrix(primitive.bounding));
+            if(model_cache_entry_) continue;
+
+            //vertices stay in model space for the per-draw world matrix, the bounds the streaming demand
+            //is measured against are in world space
+            vec3 min_pos{numberic_max<float>};
+            vec3 max_pos{numberic_lowest<float>};
+            vec2 min_texture_coordinate{numberic_max<float>};
+            vec2 max_texture_coordinate{numberic_lowest<float>};
+            for(const auto& primitive_vertex : primitive.vertices)
+            {
+                const vec3 world_pos{draw.world_matrix * vec4{primitive_vertex.position, 1}};
+                min_pos = min(min_pos, world_pos);
+                max_pos = max(max_pos, world_pos);
+                min_texture_coordinate = min(min_texture_coordinate, primitive_vertex.uv0);
+                max_texture_coordinate = max(max_texture_coordinate, primitive_vertex.uv0);
+            }
+
+            auto& mesh = mesh_table.emplace_back();
+            mesh.first_index = static_cast<uint32_t>(buffer_sizes.second);
+            mesh.index_count = static_cast<uint32_t>(
+                primitive.indices.empty() ? primitive.vertices.size() : primitive.indices.size()
+            );
+            mesh.material_id = primitive.material_index;
+            if(!primitive.vertices.empty())
+            {
+                mesh.bounds = {(min_pos + max_pos) / 2.0f, distance(min_pos, max_pos) / 2};
+                mesh.texture_coordinate_span = max_texture_coordinate - min_texture_coordinate;
+            }
+
+            buffer_sizes.first += primitive.vertices.size();
+            buffer_sizes.second += mesh.index_count;
+        }
+
+        return {std::move(mesh_table), std::move(world_matrices), buffer_sizes};
+    }
+
+    void vulkan_sample::write_scene_buffers()
+    {
+        const auto& draws = scene_->get_draws();
+
+        transfer_memory_.write_in_place<vertex>(
+            [this, &draws](vertex* const mapped_begin)
+            {
+                auto* mapped = mapped_begin;
+                for(const auto& draw : draws)
+                    for(const auto& primitive_vertex : draw.mesh_primitive->vertices)
+                        *mapped++ = make_vertex(
+                            primitive_vertex.position,
+                            primitive_vertex.normal,
+                            primitive_vertex.uv0,
+                            primitive_vertex.tangent,
+                            draw.mesh_primitive->bounding
+                        );
+                model_cache_writer_->write(mapped_begin, mapped);
+            }
+        );
+
+        //indices are rebased onto the packed vertices, non-indexed primitives draw their vertices in order
+        transfer_memory_.write_in_place<uint32_t>(
+            [this, &draws](uint32_t* const mapped_begin)
             {
-                vertex vertex = {
+                auto* mapped = mapped_begin;
+                uint32_t base_vertex = 0;
+                for(const auto& draw : draws)
+                {
+                    const auto& primitive = *draw.mesh_primitive;
+                    const auto vertex_count = static_cast<uint32_t>(primitive.vertices.size());
+                    if(primitive.indices.empty())
+                        for(uint32_t i = 0; i < vertex_count; ++i) *mapped++ = base_vertex + i;
+                    else for(const auto index : primitive.indices) *mapped++ = base_vertex + index;
+                    base_vertex += vertex_count;
+                }
+                model_cache_writer_->write(mapped_begin, mapped);
+            }
+        );
+
+        model_cache_writer_->commit();
+        model_cache_writer_ = nullopt;
+    }
+
+    pair<vector<vertex>, vector<uint32_t>> vulkan_sample::generate_buffer_allocate_info()
+    {
+        //a warm start reads the mesh table from the mapped cache entry, its buffers are copied in initialize_buffer,
+        //gltf scenes are written there straight from their primitives and draw with the world matrices of their nodes
+        vector<model_cache::mesh> mesh_table;
+        vector<mat4> world_matrices;
+        vector<vertex> vertices;
+        vector<uint32_t> indices;
+        pair<size_t, size_t> buffer_sizes;
+        if(scene_) std::tie(mesh_table, world_matrices, buffer_sizes) = generate_scene_layout();
+        if(model_cache_entry_)
+        {
+            const auto& header = model_cache_entry_->get_header();
+            buffer_sizes = {header.vertex_count, header.index_count};
+        }
+        else if(scene_)
+            model_cache_writer_.emplace(
+                mesh_cache_.store(model_key_, mesh_table, buffer_sizes.first, buffer_sizes.second)
+            );
+        else
+        {
+            std::tie(mesh_table, vertices, indices) = weld_model();
+            mesh_cache_.store(model_key_, mesh_table, vertices, indices);
+            buffer_sizes = {vertices.size(), indices.size()};
+        }
+
+        const auto& [meshes_begin, meshes_end] = model_cache_entry_ ?
+            model_cache_entry_->meshes() :
+            decltype(model_cache_entry_->meshes()){mesh_table.data(), mesh_table.data() + mesh_table.size()};
+
+        meshes_.reserve(static_cast<size_t>(meshes_end - meshes_begin));
+        for(auto it = meshes_begin; it != meshes_end; ++it)
+        {
+            const auto& material = it->material_id >= 0 ? materials_[it->material_id] : material_binding{};
+            const auto& texture_name = material.texture_name;
+            const auto* const source = texture_name.empty() ? nullptr : &texture_sources_.at(texture_name);
+            const auto is_virtual = source && source->is_virtual;
+
+            //a normal texture in an array image is bound next to the array image of the base color
+            const auto& normal_texture_name = material.normal_texture_name;
+            const auto* const normal_source = normal_texture_name.empty() ?
+                nullptr :
+                &texture_sources_.at(normal_texture_name);
+            const auto is_normal_virtual = normal_source && normal_source->is_virtual;
+
+            meshes_.push_back(
+                {
+                    it->first_index,
+                    it->index_count,
+                    source && !is_virtual ? &texture_image_map_.at(source->array_name) : nullptr,
+                    normal_source && !is_normal_virtual ? &texture_image_map_.at(normal_source->array_name) : nullptr,
+                    nullptr,
+                    texture_name,
+                    normal_texture_name,
                     {
-                        model_.attribute.vertices[3 * index.vertex_index + 0],
-                        model_.attribute.vertices[3 * index.vertex_index + 1],
-                        model_.attribute.vertices[3 * index.vertex_index + 2]
+                        material.base_color_factor,
+                        source ? source->array_layer : no_texture_layer,
+                        is_virtual ?
+                            virtual_texture_infos_.at(source->array_name) :
+                            decltype(virtual_texture_infos_)::mapped_type{},
+                        normal_source && !is_normal_virtual ? normal_source->array_layer : no_texture_layer,
+                        is_normal_virtual ?
+                            virtual_texture_infos_.at(normal_source->array_name) :
+                            decltype(virtual_texture_infos_)::mapped_type{}
                     },
-                    vec3{1},
+                    it->bounds,
+                    it->texture_coordinate_span,
+                    world_matrices.empty() ?
+                        vertex_matrix(quantization_bounds(it->bounds)) :
+                        world_matrices[static_cast<size_t>(it - meshes_begin)],
+                    static_cast<uint32_t>(it - meshes_begin)
+                }
+            );
+        }
+
+        //meshes sharing array images are drawn together to skip redundant descriptor set binds,
+        //virtual textured meshes have no array image of their base color
+        std::stable_sort(
+            meshes_.begin(),
+            meshes_.end(),
+            [](decltype(meshes_)::const_reference left, decltype(meshes_)::const_reference right)
+            {
+                return std::less<>{}(
+                    pair{left.texture, left.normal_texture},
+                    pair{right.texture, right.normal_texture}
+                );
+            }
+        );
+
+        transfer_memory_ = decltype(transfer_memory_){
+            *physical_device_,
+            device_,
+            {
+                BufferUsageFlagBits::eVertexBuffer | BufferUsageFlagBits::eStorageBuffer,
+                BufferUsageFlagBits::eIndexBuffer | BufferUsageFlagBits::eStorageBuffer
+            },
+            {buffer_sizes.first, buffer_sizes.second}
+        };
+
+        return {vertices, indices};
+    }
+
+    auto vulkan_sample::generate_cull_buffer_allocate_info(
+        const vector<vertex>& vertices,
+        const vector<uint32_t>& indices
+    ) -> vector<meshlet>
+    {
+        //meshlets are built from the positions the vertex shader reads, the cull pass takes them to world space
+        //with the world matrix of their draw, the cone stays in that space since facing survives affine maps
+        vector<meshlet> meshlets;
+        const auto& append = [&meshlets](vector<meshlet> mesh_meshlets, const uint32_t transform_index)
+        {
+            for(auto& mesh_meshlet : mesh_meshlets) mesh_meshlet.transform_index = transform_index;
+            meshlets.insert(meshlets.cend(), mesh_meshlets.cbegin(), mesh_meshlets.cend());
+        };
+
+        if(scene_)
+        {
+            //draws are laid out in order, so a mesh belongs to the last draw starting at or before its first index
+            const auto& draws = scene_->get_draws();
+            vector<uint32_t> draw_first_indices;
+            draw_first_indices.reserve(draws.size());
+            uint32_t first_index = 0;
+            for(const auto& draw : draws)
+            {
+                const auto& primitive = *draw.mesh_primitive;
+                draw_first_indices.push_back(first_index);
+                first_index += static_cast<uint32_t>(
+                    primitive.indices.empty() ? primitive.vertices.size() : primitive.indices.size()
+                );
+            }
+
+            vector<vec3> positions;
+            vector<uint32_t> primitive_indices;
+            for(size_t i = 0; i < meshes_.size(); ++i)
+            {
+                const auto& mesh = meshes_[i];
+                if(mesh.index_count == 0) continue;
+
+                const auto& draw = draws[static_cast<size_t>(
+                    std::upper_bound(draw_first_indices.cbegin(), draw_first_indices.cend(), mesh.first_index) -
+                    draw_first_indices.cbegin() - 1
+                )];
+                const auto& primitive = *draw.mesh_primitive;
+
+                positions = ::utility::container_transform<vector<vec3>>(
+                    primitive.vertices,
+                    [&bounds = primitive.bounding](const auto& primitive_vertex)
                     {
-                        model_.attribute.texcoords[2 * index.texcoord_index],
-                        1 - model_.attribute.texcoords[2 * index.texcoord_index + 1]
+                        return vertex_position(
+                            make_vertex(
+                                primitive_vertex.position,
+                                primitive_vertex.normal,
+                                primitive_vertex.uv0,
+                                primitive_vertex.tangent,
+                                bounds
+                            )
+                        );
                     }
-                };
-                auto&& it = vertices_map.find(vertex);
-                if(it == vertices_map.cend())
+                );
+                primitive_indices = primitive.indices;
+                if(primitive_indices.empty())
                 {
-                    it = vertices_map.insert(
-                        {vertex, static_cast<decltype(vertices_map)::mapped_type>(vertices_map.size())}
-                    ).first;
-                    vertices.push_back(vertex);
+                    primitive_indices.resize(primitive.vertices.size());
+                    std::iota(primitive_indices.begin(), primitive_indices.end(), uint32_t{0});
                 }
-                indices.push_back(it->second);
+
+                auto&& mesh_meshlets = build_meshlets(
+                    primitive_indices.data(),
+                    primitive_indices.data() + primitive_indices.size(),
+                    mesh.first_index,
+                    static_cast<uint32_t>(i),
+                    [&positions](const uint32_t index) { return positions[index]; }
+                );
+
+                //skinning moves the triangles away from the bounds of their rest pose, so the cull pass keeps them
+                if(is_skinned(draw))
+                    for(auto& mesh_meshlet : mesh_meshlets) mesh_meshlet.sphere.w = numberic_max<float>;
+                append(std::move(mesh_meshlets), mesh.transform_index);
             }
         }
-        transfer_memory_ = decltype(transfer_memory_){
+        else
+        {
+            //a warm start still reads the buffers from the mapped cache entry
+            const auto* vertices_begin = vertices.data();
+            const auto* indices_begin = indices.data();
+            if(model_cache_entry_)
+            {
+                vertices_begin = model_cache_entry_->vertices().first;
+                indices_begin = model_cache_entry_->indices().first;
+            }
+
+            for(size_t i = 0; i < meshes_.size(); ++i)
+            {
+                const auto& mesh = meshes_[i];
+                append(
+                    build_meshlets(
+                        indices_begin + mesh.first_index,
+                        indices_begin + mesh.first_index + mesh.index_count,
+                        mesh.first_index,
+                        static_cast<uint32_t>(i),
+                        [vertices_begin](const uint32_t index) { return vertex_position(vertices_begin[index]); }
+                    ),
+                    mesh.transform_index
+                );
+            }
+        }
+
+        cull_memory_ = decltype(cull_memory_){
             *physical_device_,
             device_,
-            {BufferUsageFlagBits::eVertexBuffer, BufferUsageFlagBits::eIndexBuffer},
-            {vertices.size(), indices.size()}
+            {
+                BufferUsageFlagBits::eStorageBuffer,
+                BufferUsageFlagBits::eStorageBuffer,
+                BufferUsageFlagBits::eStorageBuffer | BufferUsageFlagBits::eIndirectBuffer,
+                BufferUsageFlagBits::eStorageBuffer | BufferUsageFlagBits::eIndexBuffer
+            },
+            {
+                meshlets.size(),
+                meshes_.size(),
+                meshes_.size(),
+                static_cast<size_t>(
+                    transfer_memory_.host_buffer(indices_buffer_index).info().info.size / sizeof(uint32_t)
+                )
+            }
         };
 
-        return {vertices, indices};
+        if constexpr(is_debug)
+            std::cout << "meshlets: " << meshlets.size() << " for " << meshes_.size() << " meshes\n";
+
+        return meshlets;
     }
 
-    void vulkan_sample::generate_texture_sampler_create_info()
+    sampler_object::info_type vulkan_sample::generate_texture_sampler_create_info() const
     {
-        using sampler_type = decltype(texture_sampler_);
-        using sampler_info_type = sampler_type::info_type;
-
-        sampler_info_type info;
+        sampler_object::info_type info;
         info.magFilter = info.minFilter = Filter::eLinear;
         info.mipmapMode = SamplerMipmapMode::eLinear;
+        info.maxLod = VK_LOD_CLAMP_NONE;
         info.anisotropyEnable = true;
         info.maxAnisotropy = decltype(texture_image_map_)::mapped_type::max_anisotropy;
         info.compareOp = CompareOp::eAlways;
         info.borderColor = BorderColor::eIntOpaqueBlack;
-
-        texture_sampler_ = sampler_type{std::move(info)};
+        return info;
     }
 
     void vulkan_sample::generate_transform_buffer_create_info()
@@ -395,6 +1211,8 @@ namespace vulkan
         generate_shader_module_create_infos();
         vertex_shader_module_.initialize(device_);
         fragment_shader_module_.initialize(device_);
+        cull_shader_module_.initialize(device_);
+        skin_shader_module_.initialize(device_);
     }
 
     void vulkan_sample::initialize_descriptor_set_layout()
@@ -403,31 +1221,286 @@ namespace vulkan
         descriptor_set_layout_.initialize(device_);
     }
 
-    void vulkan_sample::initialize_texture_image()
+    void vulkan_sample::initialize_texture_image()
+    {
+        generate_texture_image_create_info();
+
+        texture_image_futures_.reserve(texture_arrays_.size());
+        for(const auto& [array_name, layers] : texture_arrays_)
+        {
+            auto& texture_image = texture_image_map_.at(array_name);
+            texture_image.initialize(device_, *physical_device_);
+
+            auto& futures = texture_image_futures_.emplace_back(&texture_image, vector<texture_load>{}).second;
+            for(const auto& name : layers)
+            {
+                auto& source = texture_sources_.at(name);
+                futures.emplace_back(
+                    &source,
+                    thread_pool_.submit(
+                        [this, &texture_image, &source]
+                        {
+                            return write_texture_levels(
+                                texture_image,
+                                source,
+                                tail_mip_level(source.extent, resident_tail_size)
+                            );
+                        }
+                    )
+                );
+            }
+        }
+
+        //page files are cut from the cached mip chain, which a cold start has to build first
+        vector<pair<string, future<decltype(texture_source::cached)>>> page_file_futures;
+        for(auto& [name, source] : texture_sources_)
+        {
+            if(!source.is_virtual || source.array_name != name) continue;
+
+            page_file_futures.emplace_back(
+                name,
+                thread_pool_.submit(
+                    [this, &source = source]() -> decltype(texture_source::cached)
+                    {
+                        if(virtual_textures_.contains(source.key)) return nullopt;
+
+                        decltype(texture_source::cached) cached;
+                        if(!source.cached)
+                        {
+                            stb::decode<channel::rgb_alpha>(
+                                source.source_path,
+                                [&](const auto* const pixels, const size_t width, const size_t height)
+                                {
+                                    const Extent2D extent{static_cast<uint32_t>(width), static_cast<uint32_t>(height)};
+                                    texture_cache_.store(
+                                        source.key,
+                                        extent,
+                                        pixels,
+                                        decltype(texture_cache_)::generate_mip_levels(pixels, extent)
+                                    );
+                                }
+                            );
+                            cached = texture_cache_.find(source.key);
+                            if(!cached)
+                                throw std::runtime_error("failed to cache texture " + source.source_path.string());
+                        }
+
+                        virtual_textures_.store(
+                            source.key,
+                            {source.extent.width, source.extent.height},
+                            (cached ? cached : source.cached)->cbegin()
+                        );
+                        return cached;
+                    }
+                )
+            );
+        }
+
+        for(auto& [name, future] : page_file_futures)
+        {
+            auto& source = texture_sources_.at(name);
+            if(auto cached = future.get()) source.cached = std::move(cached);
+            virtual_texture_infos_.emplace(name, virtual_textures_.insert(source.key));
+        }
+        virtual_textures_.initialize(device_, *physical_device_);
+    }
+
+    auto vulkan_sample::write_texture_levels(
+        const texture_image<Format::eR8G8B8A8Unorm>& texture_image,
+        const texture_source& source,
+        const uint32_t base_level
+    ) -> decltype(texture_source::cached)
+    {
+        //a warm start copies the mapped mip chain without touching stb
+        if(source.cached)
+        {
+            texture_image.write_from_src(
+                source.cached->cbegin() + mip_level_texel_offset(source.extent, base_level),
+                source.cached->cend(),
+                0,
+                source.array_layer
+            );
+            return nullopt;
+        }
+
+        //the decoded levels go straight into the mapped staging memory
+        stb::decode<channel::rgb_alpha>(
+            source.source_path,
+            [&](const auto* const pixels, const size_t width, const size_t height)
+            {
+                const Extent2D extent{static_cast<uint32_t>(width), static_cast<uint32_t>(height)};
+                const auto& mip_levels = decltype(texture_cache_)::generate_mip_levels(pixels, extent);
+
+                if(base_level == 0)
+                {
+                    texture_image.write_from_src(pixels, pixels + width * height, 0, source.array_layer);
+                    texture_image.write_from_src(mip_levels.cbegin(), mip_levels.cend(), 1, source.array_layer);
+                }
+                else
+                    texture_image.write_from_src(
+                        mip_levels.cbegin() + (mip_level_texel_offset(source.extent, base_level) - width * height),
+                        mip_levels.cend(),
+                        0,
+                        source.array_layer
+                    );
+                texture_cache_.store(source.key, extent, pixels, mip_levels);
+            }
+        );
+
+        //later level requests are served from the cache entry
+        return texture_cache_.find(source.key);
+    }
+
+    void vulkan_sample::collect_texture_loads(vector<texture_load>& loads)
+    {
+        for(auto& [source, future] : loads)
+            if(auto cached = future.get()) source->cached = std::move(cached);
+    }
+
+    void vulkan_sample::initialize_buffer()
+    {
+        auto&& [vertices,indices] = generate_buffer_allocate_info();
+        transfer_memory_.initialize(*physical_device_);
+        initialize_cull_buffer(vertices, indices);
+        if(scene_) initialize_skin_buffer();
+        if(model_cache_entry_)
+        {
+            const auto& [vertices_begin, vertices_end] = model_cache_entry_->vertices();
+            const auto& [indices_begin, indices_end] = model_cache_entry_->indices();
+            transfer_memory_.write(vertices_begin, vertices_end);
+            transfer_memory_.write(indices_begin, indices_end);
+            model_cache_entry_ = nullopt;
+            return;
+        }
+        if(scene_)
+        {
+            write_scene_buffers();
+            return;
+        }
+        transfer_memory_.write(std::move(vertices));
+        transfer_memory_.write(std::move(indices));
+    }
+
+    void vulkan_sample::initialize_cull_buffer(const vector<vertex>& vertices, const vector<uint32_t>& indices)
+    {
+        auto&& meshlets = generate_cull_buffer_allocate_info(vertices, indices);
+        cull_memory_.initialize(*physical_device_);
+        cull_memory_.write(std::move(meshlets));
+
+        //the cone test moves the camera into the space of the vertex buffer, the transforms stay in draw order,
+        //so the draws below a moved scene node are one range of them
+        {
+            vector<draw_transform> draw_transforms(meshes_.size());
+            for(const auto& mesh : meshes_)
+                draw_transforms[mesh.transform_index] = make_draw_transform(mesh.world_matrix);
+            cull_memory_.write(std::move(draw_transforms));
+        }
+
+        //the commands are copied to the device every frame, so the cull pass starts from empty draws,
+        //the vertex shader finds the transform of a draw through its first instance
+        cull_memory_.write(
+            ::utility::container_transform<vector<DrawIndexedIndirectCommand>>(
+                meshes_,
+                [](decltype(meshes_)::const_reference mesh)
+                {
+                    return DrawIndexedIndirectCommand{0, 1, mesh.first_index, 0, mesh.transform_index};
+                }
+            )
+        );
+    }
+
+    void vulkan_sample::initialize_skin_buffer()
     {
-        auto&& image_sources = generate_texture_image_create_info();
-
-        for(auto& source : image_sources)
+        const auto& draws = scene_->get_draws();
+        const auto skin_firsts = scene_->get_joint_matrices().second;
+
+        //joint indices stay within their skin, the skinned draw knows where its joint matrices start,
+        //the target vertices follow the layout
+        vector<skin_vertex> skin_vertices;
+        uint32_t base_vertex = 0;
+        for(size_t i = 0; i < draws.size(); ++i)
         {
-            auto&& texture_image = decltype(texture_image_map_)::mapped_type{
-                ImageType::e2D,
-                {static_cast<uint32_t>(source.second.width()), static_cast<uint32_t>(source.second.height()), 1}
-            };
-            texture_image.initialize(device_, *physical_device_);
-            texture_image.write_from_src(device_, source.second.cbegin(), source.second.cend());
-            texture_image_map_[source.first] = std::move(texture_image);
+            const auto& draw = draws[i];
+            const auto& primitive = *draw.mesh_primitive;
+            const auto vertex_count = static_cast<uint32_t>(primitive.vertices.size());
+            if(is_skinned(draw) && skin_firsts[draw.skin + 1] > skin_firsts[draw.skin])
+            {
+                const auto last_joint = static_cast<uint32_t>(
+                    std::min(skin_firsts[draw.skin + 1] - 1 - skin_firsts[draw.skin], size_t{numberic_max<uint16_t>})
+                );
+                const auto skinned_draw_index = static_cast<uint32_t>(skinned_primitives_.size());
+                for(uint32_t j = 0; j < vertex_count; ++j)
+                {
+                    const auto& rest_vertex = primitive.vertices[j];
+                    const auto& influence = primitive.skin_vertices[j];
+                    skin_vertices.push_back(
+                        {
+                            rest_vertex.position,
+                            skinned_draw_index,
+                            rest_vertex.normal,
+                            base_vertex + j,
+                            u16vec4{min(uvec4{influence.joint}, uvec4{last_joint})},
+                            packUnorm<uint16_t>(influence.weight),
+                            rest_vertex.tangent
+                        }
+                    );
+                }
+                skinned_primitives_.push_back({&primitive, draw.skin, static_cast<uint32_t>(i)});
+            }
+            base_vertex += vertex_count;
         }
+        if(skinned_primitives_.empty()) return;
+
+        skin_memory_ = decltype(skin_memory_){
+            *physical_device_,
+            device_,
+            {
+                BufferUsageFlagBits::eStorageBuffer,
+                BufferUsageFlagBits::eStorageBuffer,
+                BufferUsageFlagBits::eStorageBuffer
+            },
+            {skin_vertices.size(), skin_firsts.back(), skinned_primitives_.size()}
+        };
+        skin_memory_.initialize(*physical_device_);
+        skin_memory_.write(std::move(skin_vertices));
+        update_skins();
+
+        if constexpr(is_debug)
+            std::cout << "skinned vertices: " << skin_memory_.read<skin_vertex>().size() << " for " <<
+                skinned_primitives_.size() << " draws\n";
     }
 
-    void vulkan_sample::initialize_buffer()
+    void vulkan_sample::initialize_texture_sampler()
     {
-        auto&& [vertices,indices] = generate_buffer_allocate_info();
-        transfer_memory_.initialize(*physical_device_);
-        transfer_memory_.write(std::move(vertices));
-        transfer_memory_.write(std::move(indices));
-    }
+        const auto& intern = [this](const string& array_name, const sampler_object::info_type& info)
+        {
+            array_samplers_.insert_or_assign(
+                array_name,
+                sampler_interner_.intern(
+                    sampler_hash(info),
+                    0,
+                    [this, &info]
+                    {
+                        sampler_object sampler{info};
+                        sampler.initialize(device_);
+                        return sampler;
+                    },
+                    [&info](const sampler_object& sampler) { return sampler.info() == info; }
+                )
+            );
+        };
+
+        //arrays already group layers by sampler state, equal states of different arrays share the handle
+        for(const auto& [array_name, layers] : texture_arrays_)
+            intern(array_name, texture_sources_.at(layers.front()).sampler_info);
 
-    void vulkan_sample::initialize_texture_sampler() { texture_sampler_.initialize(device_); }
+        //the virtual texture set still needs a sampler for its unused array binding, it is kept under no name
+        intern({}, generate_texture_sampler_create_info());
+
+        if constexpr(is_debug)
+            std::cout << "samplers: " << sampler_interner_.get_statistics().unique << " unique of " <<
+                sampler_interner_.get_statistics().requests << '\n';
+    }
 
     void vulkan_sample::initialize_transform_buffer()
     {
@@ -444,19 +1517,156 @@ namespace vulkan
         set_transform({mat4{1}});
     }
 
+    void vulkan_sample::generate_cull_pipeline_create_info()
+    {
+        using pipeline_layout_type = decltype(cull_pipeline_layout_);
+        using pipeline_layout_info_type = pipeline_layout_type::info_type;
+        using compute_pipeline_type = decltype(cull_pipeline_);
+        using compute_pipeline_info_type = compute_pipeline_type::info_type;
+
+        cull_descriptor_set_layout_ = decltype(cull_descriptor_set_layout_){
+            info_proxy<DescriptorSetLayoutCreateInfo>{
+                {
+                    DescriptorSetLayoutBinding{0, DescriptorType::eUniformBuffer, 1, ShaderStageFlagBits::eCompute},
+                    DescriptorSetLayoutBinding{1, DescriptorType::eStorageBuffer, 1, ShaderStageFlagBits::eCompute},
+                    DescriptorSetLayoutBinding{2, DescriptorType::eStorageBuffer, 1, ShaderStageFlagBits::eCompute},
+                    DescriptorSetLayoutBinding{3, DescriptorType::eStorageBuffer, 1, ShaderStageFlagBits::eCompute},
+                    DescriptorSetLayoutBinding{4, DescriptorType::eStorageBuffer, 1, ShaderStageFlagBits::eCompute},
+                    DescriptorSetLayoutBinding{5, DescriptorType::eStorageBuffer, 1, ShaderStageFlagBits::eCompute}
+                }
+            }
+        };
+        cull_descriptor_set_layout_.initialize(device_);
+
+        cull_descriptor_pool_ = decltype(cull_descriptor_pool_){
+            decltype(cull_descriptor_pool_)::info_type{
+                {
+                    DescriptorPoolSize{DescriptorType::eUniformBuffer, 1},
+                    DescriptorPoolSize{DescriptorType::eStorageBuffer, 5}
+                },
+                decltype(cull_descriptor_pool_)::info_type::base_info_type{
+                    DescriptorPoolCreateFlagBits::eFreeDescriptorSet
+                }
+            }
+        };
+
+        cull_pipeline_layout_ = pipeline_layout_type{pipeline_layout_info_type{{*cull_descriptor_set_layout_}, {}}};
+        cull_pipeline_layout_.initialize(device_);
+
+        ComputePipelineCreateInfo info;
+        info.layout = *cull_pipeline_layout_;
+        cull_pipeline_ = compute_pipeline_type{
+            compute_pipeline_info_type{
+                info_proxy<PipelineShaderStageCreateInfo>{
+                    "main",
+                    nullopt,
+                    PipelineShaderStageCreateInfo{{}, ShaderStageFlagBits::eCompute, *cull_shader_module_}
+                },
+                {std::move(info)}
+            }
+        };
+    }
+
+    void vulkan_sample::initialize_cull_pipeline()
+    {
+        generate_cull_pipeline_create_info();
+        cull_pipeline_.initialize(device_);
+        cull_descriptor_pool_.initialize(device_);
+
+        const info_proxy<DescriptorSetAllocateInfo> allocate_info{
+            {*cull_descriptor_set_layout_},
+            DescriptorSetAllocateInfo{*cull_descriptor_pool_}
+        };
+        cull_descriptor_sets_ = cull_descriptor_pool_.create_element_objects(device_, allocate_info.info);
+    }
+
+    void vulkan_sample::generate_skin_pipeline_create_info()
+    {
+        using pipeline_layout_type = decltype(skin_pipeline_layout_);
+        using pipeline_layout_info_type = pipeline_layout_type::info_type;
+        using compute_pipeline_type = decltype(skin_pipeline_);
+        using compute_pipeline_info_type = compute_pipeline_type::info_type;
+
+        skin_descriptor_set_layout_ = decltype(skin_descriptor_set_layout_){
+            info_proxy<DescriptorSetLayoutCreateInfo>{
+                {
+                    DescriptorSetLayoutBinding{0, DescriptorType::eStorageBuffer, 1, ShaderStageFlagBits::eCompute},
+                    DescriptorSetLayoutBinding{1, DescriptorType::eStorageBuffer, 1, ShaderStageFlagBits::eCompute},
+                    DescriptorSetLayoutBinding{2, DescriptorType::eStorageBuffer, 1, ShaderStageFlagBits::eCompute},
+                    DescriptorSetLayoutBinding{3, DescriptorType::eStorageBuffer, 1, ShaderStageFlagBits::eCompute},
+                    DescriptorSetLayoutBinding{4, DescriptorType::eStorageBuffer, 1, ShaderStageFlagBits::eCompute}
+                }
+            }
+        };
+        skin_descriptor_set_layout_.initialize(device_);
+
+        skin_descriptor_pool_ = decltype(skin_descriptor_pool_){
+            decltype(skin_descriptor_pool_)::info_type{
+                {DescriptorPoolSize{DescriptorType::eStorageBuffer, 5}},
+                decltype(skin_descriptor_pool_)::info_type::base_info_type{
+                    DescriptorPoolCreateFlagBits::eFreeDescriptorSet
+                }
+            }
+        };
+
+        skin_pipeline_layout_ = pipeline_layout_type{pipeline_layout_info_type{{*skin_descriptor_set_layout_}, {}}};
+        skin_pipeline_layout_.initialize(device_);
+
+        ComputePipelineCreateInfo info;
+        info.layout = *skin_pipeline_layout_;
+        skin_pipeline_ = compute_pipeline_type{
+            compute_pipeline_info_type{
+                info_proxy<PipelineShaderStageCreateInfo>{
+                    "main",
+                    nullopt,
+                    PipelineShaderStageCreateInfo{{}, ShaderStageFlagBits::eCompute, *skin_shader_module_}
+                },
+                {std::move(info)}
+            }
+        };
+    }
+
+    void vulkan_sample::initialize_skin_pipeline()
+    {
+        if(skinned_primitives_.empty()) return;
+
+        generate_skin_pipeline_create_info();
+        skin_pipeline_.initialize(device_);
+        skin_descriptor_pool_.initialize(device_);
+
+        const info_proxy<DescriptorSetAllocateInfo> allocate_info{
+            {*skin_descriptor_set_layout_},
+            DescriptorSetAllocateInfo{*skin_descriptor_pool_}
+        };
+        skin_descriptor_sets_ = skin_descriptor_pool_.create_element_objects(device_, allocate_info.info);
+    }
+
     void vulkan_sample::initialize_graphics_command_pool()
     {
         generate_graphics_command_pool_create_info();
         graphics_command_pool_.initialize(device_);
     }
 
+    void vulkan_sample::initialize_transfer_command_buffer()
+    {
+        transfer_command_buffers_ = graphics_command_pool_.create_element_objects(
+            device_,
+            CommandBufferAllocateInfo{*graphics_command_pool_, CommandBufferLevel::ePrimary, 1}
+        );
+    }
+
     void vulkan_sample::generate_pipeline_layout_create_info(
         const descriptor_set_layout_object& descriptor_set_layout_object
     )
     {
         using pipeline_layout_type = decltype(pipeline_layout_);
         using pipeline_layout_info_type = pipeline_layout_type::info_type;
-        pipeline_layout_ = pipeline_layout_type{pipeline_layout_info_type{{*descriptor_set_layout_object}}};
+        pipeline_layout_ = pipeline_layout_type{
+            pipeline_layout_info_type{
+                {*descriptor_set_layout_object},
+                {PushConstantRange{ShaderStageFlagBits::eFragment, 0, sizeof(texture_push_constant)}}
+            }
+        };
     }
 
     void vulkan_sample::generate_swapchain_create_info(const surface_object& surface_object)
@@ -675,7 +1885,7 @@ namespace vulkan
         };
     }
 
-    void vulkan_sample::generate_descriptor_pool_create_info(const vector<mesh>& meshes)
+    void vulkan_sample::generate_descriptor_pool_create_info(const size_t count)
     {
         using descriptor_pool_type = decltype(descriptor_pool_);
         using descriptor_pool_info_type = descriptor_pool_type::info_type;
@@ -683,11 +1893,12 @@ namespace vulkan
             descriptor_pool_info_type{
                 {
                     DescriptorPoolSize
-                    {DescriptorType::eUniformBuffer, static_cast<uint32_t>(meshes.size())},
+                    {DescriptorType::eUniformBuffer, static_cast<uint32_t>(count)},
                     DescriptorPoolSize{
                         DescriptorType::eCombinedImageSampler,
-                        static_cast<uint32_t>(meshes.size())
-                    }
+                        static_cast<uint32_t>(3 * count)
+                    },
+                    DescriptorPoolSize{DescriptorType::eStorageBuffer, static_cast<uint32_t>(3 * count)}
                 },
                 descriptor_pool_info_type::base_info_type{DescriptorPoolCreateFlagBits::eFreeDescriptorSet}
             }
@@ -721,9 +1932,27 @@ namespace vulkan
         render_pass_.initialize(device_);
     }
 
+    void vulkan_sample::generate_descriptor_set_images()
+    {
+        //a mesh whose normal texture is still pending falls back to the set of its base color alone,
+        //and one whose base color is pending to the set without images
+        descriptor_set_images_ = {{nullptr, nullptr}};
+        for(const auto& mesh : meshes_)
+        {
+            descriptor_set_images_.emplace_back(mesh.texture, nullptr);
+            descriptor_set_images_.emplace_back(mesh.texture, mesh.normal_texture);
+        }
+        std::sort(descriptor_set_images_.begin(), descriptor_set_images_.end());
+        descriptor_set_images_.erase(
+            std::unique(descriptor_set_images_.begin(), descriptor_set_images_.end()),
+            descriptor_set_images_.end()
+        );
+    }
+
     void vulkan_sample::initialize_descriptor_pool()
     {
-        generate_descriptor_pool_create_info(meshes_);
+        generate_descriptor_set_images();
+        generate_descriptor_pool_create_info(descriptor_set_images_.size());
         descriptor_pool_.initialize(device_);
     }
 
@@ -863,7 +2092,7 @@ namespace vulkan
     }
 
     void vulkan_sample::generate_descriptor_set_allocate_info(
-        const vector<mesh>& meshes,
+        const size_t count,
         const descriptor_set_layout_object& descriptor_set_layout_object,
         const descriptor_pool_object& descriptor_pool_object
     )
@@ -871,11 +2100,11 @@ namespace vulkan
         using descriptor_set_type = decltype(descriptor_sets_)::value_type;
         using descriptor_set_info_type = descriptor_set_type::info_type;
 
-        descriptor_sets_.resize(meshes.size());
+        descriptor_sets_.resize(count);
         for(auto& descriptor_set : descriptor_sets_)
             descriptor_set = descriptor_set_type{
                 descriptor_set_info_type{
-                    {meshes.size(), *descriptor_set_layout_object},
+                    {count, *descriptor_set_layout_object},
                     descriptor_set_info_type::base_info_type{*descriptor_pool_object}
                 }
             };
@@ -899,72 +2128,387 @@ namespace vulkan
         graphics_pipeline_.initialize(device_);
     }
 
-    void vulkan_sample::initialize_descriptor_sets()
+    void vulkan_sample::initialize_descriptor_sets()
+    {
+        generate_descriptor_set_allocate_info(
+            descriptor_set_images_.size(),
+            descriptor_set_layout_,
+            descriptor_pool_
+        );
+        descriptor_sets_ = descriptor_pool_.create_element_objects(device_, descriptor_sets_.front().info().info);
+
+        //one descriptor set per pair of array images meshes sample, they select their layers with a push constant
+        for(auto& mesh : meshes_) mesh.descriptor_set = &image_descriptor_set(mesh.texture, mesh.normal_texture);
+    }
+
+    void vulkan_sample::submit_precondition_command()
+    {
+        const auto& front_command_buffer = *graphics_command_buffers_.front();
+        auto& front_submit_info = submit_infos_.front();
+
+        front_submit_info = {};
+        front_submit_info.command_buffers_property = {front_command_buffer};
+
+        command_buffer_begin_info_ = CommandBufferBeginInfo{CommandBufferUsageFlagBits::eOneTimeSubmit};
+
+        front_command_buffer.begin(command_buffer_begin_info_, device_.dispatch());
+
+        transfer_memory_.write_transfer_command(front_command_buffer);
+        cull_memory_.write_transfer_command(front_command_buffer);
+        if(!skinned_primitives_.empty()) skin_memory_.write_transfer_command(front_command_buffer);
+
+        virtual_textures_.write_transfer_command(device_, front_command_buffer);
+
+        front_command_buffer.end(device_.dispatch());
+
+        graphics_queue_.submit({front_submit_info}, nullptr, device_.dispatch());
+    }
+
+    void vulkan_sample::submit_texture_tails(const time::steady_clock::time_point& deadline)
+    {
+        //the first frames do not wait for the tails, each frame uploads the ones decoded by then
+        const auto& command_buffer = *transfer_command_buffers_.front();
+        size_t submitted_count = 0;
+        for(auto it = texture_image_futures_.begin(); it != texture_image_futures_.end();)
+        {
+            if(submitted_count > 0 && time::steady_clock_timer() >= deadline) break;
+            if(!std::all_of(
+                it->second.cbegin(),
+                it->second.cend(),
+                [](const texture_load& load) { return is_ready(load.second); }
+            ))
+            {
+                ++it;
+                continue;
+            }
+            collect_texture_loads(it->second);
+
+            if(submitted_count++ == 0)
+                command_buffer.begin(
+                    CommandBufferBeginInfo{CommandBufferUsageFlagBits::eOneTimeSubmit},
+                    device_.dispatch()
+                );
+
+            const auto& texture_image = *it->first;
+            texture_image.write_transfer_command(device_, command_buffer);
+
+            write_transfer_image_layout_command(
+                command_buffer,
+                *texture_image.image(),
+                texture_image.image_view().info().subresourceRange,
+                ImageLayout::eTransferDstOptimal,
+                ImageLayout::eShaderReadOnlyOptimal,
+                device_.dispatch()
+            );
+
+            device_->flushMappedMemoryRanges(
+                MappedMemoryRange{*texture_image.buffer_memory(), 0, constant::whole_size<DeviceSize>},
+                device_.dispatch()
+            );
+            it = texture_image_futures_.erase(it);
+        }
+        if(submitted_count == 0) return;
+
+        command_buffer.end(device_.dispatch());
+
+        decltype(submit_infos_)::value_type submit_info;
+        submit_info.command_buffers_property = {command_buffer};
+        graphics_queue_.submit({submit_info}, nullptr, device_.dispatch());
+        graphics_queue_.waitIdle(device_.dispatch());
+
+        //the meshes of the uploaded images switch from their placeholder to their texture
+        record_graphics_command_buffers();
+    }
+
+    bool vulkan_sample::is_texture_pending(const texture_image<Format::eR8G8B8A8Unorm>* const texture) const noexcept
+    {
+        return texture && std::any_of(
+            texture_image_futures_.cbegin(),
+            texture_image_futures_.cend(),
+            [texture](decltype(texture_image_futures_)::const_reference pair) { return pair.first == texture; }
+        );
+    }
+
+    const descriptor_set_object& vulkan_sample::image_descriptor_set(
+        const texture_image<Format::eR8G8B8A8Unorm>* const texture,
+        const texture_image<Format::eR8G8B8A8Unorm>* const normal_texture
+    ) const
+    {
+        const auto& it = std::lower_bound(
+            descriptor_set_images_.cbegin(),
+            descriptor_set_images_.cend(),
+            pair{texture, normal_texture}
+        );
+        return descriptor_sets_[static_cast<size_t>(it - descriptor_set_images_.cbegin())];
+    }
+
+    void vulkan_sample::submit_streamed_textures(const time::steady_clock::time_point& deadline)
+    {
+        vector<decltype(texture_streaming_loads_)::iterator> loads;
+        for(auto it = texture_streaming_loads_.begin(); it != texture_streaming_loads_.end(); ++it)
+            if(std::all_of(
+                it->second.second.cbegin(),
+                it->second.second.cend(),
+                [](const texture_load& load) { return is_ready(load.second); }
+            ))
+                loads.push_back(it);
+        if(loads.empty()) return;
+
+        const auto& front_command_buffer = *graphics_command_buffers_.front();
+        auto& front_submit_info = submit_infos_.front();
+
+        front_submit_info = {};
+        front_submit_info.command_buffers_property = {front_command_buffer};
+
+        command_buffer_begin_info_ = CommandBufferBeginInfo{CommandBufferUsageFlagBits::eOneTimeSubmit};
+
+        front_command_buffer.begin(command_buffer_begin_info_, device_.dispatch());
+
+        //ready images past the frame budget wait for the next frame
+        size_t submitted_count = 0;
+        for(const auto& load : loads)
+        {
+            if(submitted_count > 0 && time::steady_clock_timer() >= deadline) break;
+            ++submitted_count;
+
+            auto& [texture_image, futures] = load->second;
+            collect_texture_loads(futures);
+
+            texture_image.write_transfer_command(device_, front_command_buffer);
+
+            write_transfer_image_layout_command(
+                front_command_buffer,
+                *texture_image.image(),
+                texture_image.image_view().info().subresourceRange,
+                ImageLayout::eTransferDstOptimal,
+                ImageLayout::eShaderReadOnlyOptimal,
+                device_.dispatch()
+            );
+
+            device_->flushMappedMemoryRanges(
+                MappedMemoryRange{*texture_image.buffer_memory(), 0, constant::whole_size<DeviceSize>},
+                device_.dispatch()
+            );
+        }
+
+        front_command_buffer.end(device_.dispatch());
+        loads.resize(submitted_count);
+
+        graphics_queue_.submit({front_submit_info}, nullptr, device_.dispatch());
+        graphics_queue_.waitIdle(device_.dispatch());
+
+        //the device is idle, so the previous images can be replaced and the descriptors rewritten
+        for(const auto& load : loads)
+        {
+            auto& texture_image = load->second.first;
+            texture_image.release_staging();
+            texture_image_map_[load->first] = std::move(texture_image);
+            texture_residency_.complete(load->first);
+            texture_streaming_loads_.erase(load);
+        }
+
+        write_descriptor_sets();
+
+        command_buffer_begin_info_ = CommandBufferBeginInfo{CommandBufferUsageFlagBits::eSimultaneousUse};
+        record_graphics_command_buffers();
+    }
+
+    void vulkan_sample::update_virtual_textures()
+    {
+        if(!virtual_textures_.load(
+            device_,
+            virtual_textures_.read_feedback(device_, frame_count_),
+            frame_count_,
+            thread_pool_
+        ))
+            return;
+
+        const auto& command_buffer = *transfer_command_buffers_.front();
+        decltype(submit_infos_)::value_type submit_info;
+        submit_info.command_buffers_property = {command_buffer};
+
+        command_buffer.begin(CommandBufferBeginInfo{CommandBufferUsageFlagBits::eOneTimeSubmit}, device_.dispatch());
+        virtual_textures_.write_transfer_command(device_, command_buffer);
+        command_buffer.end(device_.dispatch());
+
+        graphics_queue_.submit({submit_info}, nullptr, device_.dispatch());
+        graphics_queue_.waitIdle(device_.dispatch());
+    }
+
+    void vulkan_sample::animate_scene()
+    {
+        if(!scene_) return;
+        scene_->animate(time::duration<float>{time::steady_clock_timer() - scene_start_}.count());
+    }
+
+    void vulkan_sample::submit_node_transforms()
+    {
+        if(!scene_) return;
+
+        const auto& ranges = scene_->update_draws();
+        if(ranges.empty()) return;
+
+        //every dirty range is written and copied on its own, the draws between them keep their transforms
+        vector<BufferMemoryBarrier> barriers;
+        barriers.reserve(ranges.size());
+        for(const auto& [first_draw, draws] : ranges)
+        {
+            const auto& draw_transforms = ::utility::container_transform<vector<draw_transform>>(
+                draws,
+                [](const gltf_model::draw& draw)
+                {
+                    return make_draw_transform(draw.world_matrix * vertex_matrix(draw.mesh_primitive->bounding));
+                }
+            );
+            cull_memory_.write(draw_transforms.data(), draw_transforms.data() + draw_transforms.size(), first_draw);
+            barriers.emplace_back(
+                AccessFlagBits::eTransferWrite,
+                AccessFlagBits::eShaderRead | AccessFlagBits::eShaderWrite,
+                queue_family_ignore<>,
+                queue_family_ignore<>,
+                *cull_memory_.device_local_buffer(draw_transforms_buffer_index),
+                sizeof(draw_transform) * first_draw,
+                sizeof(draw_transform) * draws.size()
+            );
+        }
+        cull_memory_.flush<draw_transform>();
+
+        //texture streaming measures the moved meshes with a sphere around their primitive box,
+        //the ranges are sorted so the one holding a mesh is found by its first draw
+        for(auto& mesh : meshes_)
+        {
+            const auto range = std::upper_bound(
+                ranges.cbegin(),
+                ranges.cend(),
+                mesh.transform_index,
+                [](const size_t index, const pair<size_t, vector<gltf_model::draw>>& current)
+                {
+                    return index < current.first;
+                }
+            );
+            if(range == ranges.cbegin()) continue;
+
+            const auto& [first_draw, draws] = *std::prev(range);
+            if(mesh.transform_index >= first_draw + draws.size()) continue;
+
+            const auto& draw = draws[mesh.transform_index - first_draw];
+            const auto& [min_pos, max_pos] = draw.mesh_primitive->bounding;
+            const auto& world_matrix = draw.world_matrix;
+            const auto max_scale = std::sqrt(
+                std::max(
+                    {
+                        dot(world_matrix[0], world_matrix[0]),
+                        dot(world_matrix[1], world_matrix[1]),
+                        dot(world_matrix[2], world_matrix[2])
+                    }
+                )
+            );
+            mesh.bounds = {
+                vec3{world_matrix * vec4{(min_pos + max_pos) / 2.0f, 1}},
+                distance(min_pos, max_pos) / 2 * max_scale
+            };
+            mesh.world_matrix = draw.world_matrix * vertex_matrix(draw.mesh_primitive->bounding);
+        }
+
+        const auto& command_buffer = *transfer_command_buffers_.front();
+        decltype(submit_infos_)::value_type submit_info;
+        submit_info.command_buffers_property = {command_buffer};
+
+        //the frame submitted after this reads the transforms in its cull pass and its vertex shader
+        command_buffer.begin(CommandBufferBeginInfo{CommandBufferUsageFlagBits::eOneTimeSubmit}, device_.dispatch());
+        for(const auto& [first_draw, draws] : ranges)
+            cull_memory_.write_transfer_command<draw_transform>(command_buffer, first_draw, draws.size());
+        command_buffer.pipelineBarrier(
+            PipelineStageFlagBits::eTransfer,
+            PipelineStageFlagBits::eComputeShader | PipelineStageFlagBits::eVertexShader,
+            {},
+            {},
+            barriers,
+            {},
+            device_.dispatch()
+        );
+        command_buffer.end(device_.dispatch());
+
+        graphics_queue_.submit({submit_info}, nullptr, device_.dispatch());
+    }
+
+    void vulkan_sample::cull_draws()
     {
-        generate_descriptor_set_allocate_info(meshes_, descriptor_set_layout_, descriptor_pool_);
-        descriptor_sets_ = descriptor_pool_.create_element_objects(device_, descriptor_sets_.front().info().info);
-        ::utility::for_each(
-            [](decltype(meshes_)::reference mesh,decltype(descriptor_sets_)::const_reference descriptor_set)
-            {
-                mesh.descriptor_set = &descriptor_set;
-            },
-            meshes_.begin(),
-            meshes_.end(),
-            descriptor_sets_.cbegin()
-        );
+        if(!scene_) return;
+
+        //the hierarchy holds the boxes of the rest pose, skinned draws are left to the cull pass
+        vector<bool> visible(meshes_.size());
+        scene_->get_bvh().query_frustum(transform_mat_.mat, [&visible](const size_t draw) { visible[draw] = true; });
+        for(const auto& skinned : skinned_primitives_) visible[skinned.transform_index] = true;
+
+        auto commands = cull_memory_.read<DrawIndexedIndirectCommand>();
+        for(size_t i = 0; i < commands.size(); ++i)
+            commands[i].instanceCount = visible[meshes_[i].transform_index] ? 1 : 0;
+        cull_memory_.write(commands.data(), commands.data() + commands.size(), 0);
+        cull_memory_.flush<DrawIndexedIndirectCommand>();
     }
 
-    void vulkan_sample::submit_precondition_command()
+    void vulkan_sample::update_skins()
     {
-        const auto& front_command_buffer = *graphics_command_buffers_.front();
-        auto& front_submit_info = submit_infos_.front();
-
-        front_submit_info = {};
-        front_submit_info.command_buffers_property = {front_command_buffer};
-
-        command_buffer_begin_info_ = CommandBufferBeginInfo{CommandBufferUsageFlagBits::eOneTimeSubmit};
-
-        front_command_buffer.begin(command_buffer_begin_info_, device_.dispatch());
+        if(skinned_primitives_.empty()) return;
 
-        transfer_memory_.write_transfer_command(front_command_buffer);
+        auto [joint_matrices, skin_firsts] = scene_->get_joint_matrices();
 
-        for(auto& pair : texture_image_map_)
+        //a skinned position is a weighted mean of the positions the joints of its skin map it to,
+        //so it lies in the box around the rest box mapped by each of them
+        vector<pair<vec3, vec3>> boxes;
+        vector<skinned_draw> skinned_draws;
+        boxes.reserve(skinned_primitives_.size());
+        skinned_draws.reserve(skinned_primitives_.size());
+        for(const auto& skinned : skinned_primitives_)
         {
-            const auto& texture_image = pair.second;
-            texture_image.write_transfer_command(device_, front_command_buffer);
-
-            write_transfer_image_layout_command(
-                front_command_buffer,
-                *texture_image.image(),
-                texture_image.image_view().info().subresourceRange,
-                ImageLayout::eTransferDstOptimal,
-                ImageLayout::eShaderReadOnlyOptimal,
-                device_.dispatch()
+            auto& box = boxes.emplace_back(vec3{numberic_max<float>}, vec3{numberic_lowest<float>});
+            for(auto i = skin_firsts[skinned.skin]; i < skin_firsts[skinned.skin + 1]; ++i)
+            {
+                const auto& joint_box = transform_bounds(joint_matrices[i], skinned.primitive->bounding);
+                box = {min(box.first, joint_box.first), max(box.second, joint_box.second)};
+            }
+            skinned_draws.push_back(
+                {
+                    make_draw_transform(vertex_matrix(box)),
+                    skinned.transform_index,
+                    static_cast<uint32_t>(skin_firsts[skinned.skin])
+                }
             );
+        }
 
-            device_->flushMappedMemoryRanges(
-                MappedMemoryRange{*texture_image.buffer_memory(), 0, constant::whole_size<DeviceSize>},
-                device_.dispatch()
+        //texture streaming measures the skinned meshes with a sphere around their box
+        for(auto& mesh : meshes_)
+        {
+            const auto& it = std::lower_bound(
+                skinned_primitives_.cbegin(),
+                skinned_primitives_.cend(),
+                mesh.transform_index,
+                [](const skinned_primitive& skinned, const uint32_t index) { return skinned.transform_index < index; }
             );
-        }
+            if(it == skinned_primitives_.cend() || it->transform_index != mesh.transform_index) continue;
 
-        front_command_buffer.end(device_.dispatch());
+            const auto skinned_index = static_cast<size_t>(it - skinned_primitives_.cbegin());
+            const auto& [min_pos, max_pos] = boxes[skinned_index];
+            mesh.bounds = {(min_pos + max_pos) / 2.0f, distance(min_pos, max_pos) / 2};
+            mesh.world_matrix = skinned_draws[skinned_index].transform.world;
+        }
 
-        graphics_queue_.submit({front_submit_info}, nullptr, device_.dispatch());
+        //the frame command buffers copy both to the device before the skin pass
+        skin_memory_.write(std::move(joint_matrices));
+        skin_memory_.write(std::move(skinned_draws));
+        skin_memory_.flush<mat4, skinned_draw>();
     }
 
-    void vulkan_sample::generate_render_info()
+    void vulkan_sample::write_descriptor_sets()
     {
-        render_pass_begin_infos_.resize(frame_buffers_.size());
-        submit_infos_.resize(graphics_command_buffers_.size());
-        present_infos_.resize(submit_infos_.size());
-        submit_precondition_command();
-
-        command_buffer_begin_info_ = CommandBufferBeginInfo{CommandBufferUsageFlagBits::eSimultaneousUse};
-
-        graphics_queue_.waitIdle(device_.dispatch());
-
-        for(const auto& mesh : meshes_)
+        const auto& write = [this](
+            decltype(descriptor_sets_)::const_reference descriptor_set,
+            const image_view_object& image_view,
+            const sampler_object& sampler,
+            const image_view_object& normal_image_view,
+            const sampler_object& normal_sampler
+        )
         {
             device_->updateDescriptorSets(
                 {
@@ -972,21 +2516,358 @@ namespace vulkan
                         {},
                         {{*transform_buffer_, 0, whole_size<decltype(DescriptorBufferInfo::range)>}},
                         {},
-                        {**mesh.descriptor_set, 0, 0, 1, DescriptorType::eUniformBuffer}
+                        {*descriptor_set, 0, 0, 1, DescriptorType::eUniformBuffer}
+                    },
+                    info_proxy<WriteDescriptorSet>{
+                        {{*sampler, *image_view, ImageLayout::eShaderReadOnlyOptimal}},
+                        {},
+                        {},
+                        {*descriptor_set, 1, 0, 1, DescriptorType::eCombinedImageSampler}
+                    },
+                    info_proxy<WriteDescriptorSet>{
+                        {
+                            {
+                                *virtual_textures_.sampler(),
+                                *virtual_textures_.image_view(),
+                                ImageLayout::eShaderReadOnlyOptimal
+                            }
+                        },
+                        {},
+                        {},
+                        {*descriptor_set, 2, 0, 1, DescriptorType::eCombinedImageSampler}
+                    },
+                    info_proxy<WriteDescriptorSet>{
+                        {},
+                        {{*virtual_textures_.table_buffer(), 0, whole_size<decltype(DescriptorBufferInfo::range)>}},
+                        {},
+                        {*descriptor_set, 3, 0, 1, DescriptorType::eStorageBuffer}
+                    },
+                    info_proxy<WriteDescriptorSet>{
+                        {},
+                        {{*virtual_textures_.feedback_buffer(), 0, whole_size<decltype(DescriptorBufferInfo::range)>}},
+                        {},
+                        {*descriptor_set, 4, 0, 1, DescriptorType::eStorageBuffer}
+                    },
+                    info_proxy<WriteDescriptorSet>{
+                        {},
+                        {
+                            {
+                                *cull_memory_.device_local_buffer(draw_transforms_buffer_index),
+                                0,
+                                whole_size<decltype(DescriptorBufferInfo::range)>
+                            }
+                        },
+                        {},
+                        {*descriptor_set, 5, 0, 1, DescriptorType::eStorageBuffer}
                     },
                     info_proxy<WriteDescriptorSet>{
-                        {{*texture_sampler_, *mesh.texture->image_view(), ImageLayout::eShaderReadOnlyOptimal}},
+                        {{*normal_sampler, *normal_image_view, ImageLayout::eShaderReadOnlyOptimal}},
                         {},
                         {},
-                        {**mesh.descriptor_set, 1, 0, 1, DescriptorType::eCombinedImageSampler}
+                        {*descriptor_set, 6, 0, 1, DescriptorType::eCombinedImageSampler}
                     }
                 },
                 {},
                 device_.dispatch()
             );
+        };
+
+        //an array binding without an image is never sampled, the page cache only fills it
+        map<const decltype(texture_image_map_)::mapped_type*, const string*> image_names;
+        for(const auto& [name, image] : texture_image_map_) image_names.emplace(&image, &name);
+        const auto& bound_image = [this, &image_names](const decltype(texture_image_map_)::mapped_type* const image)
+        {
+            return image ?
+                pair<const image_view_object*, const sampler_object*>{
+                    &image->image_view(),
+                    array_samplers_.at(*image_names.at(image)).get()
+                } :
+                pair<const image_view_object*, const sampler_object*>{
+                    &virtual_textures_.image_view(),
+                    array_samplers_.at({}).get()
+                };
+        };
+
+        ::utility::for_each(
+            [&write, &bound_image](
+            decltype(descriptor_set_images_)::const_reference images,
+            decltype(descriptor_sets_)::const_reference descriptor_set
+        )
+            {
+                const auto& [image_view, sampler] = bound_image(images.first);
+                const auto& [normal_image_view, normal_sampler] = bound_image(images.second);
+                write(descriptor_set, *image_view, *sampler, *normal_image_view, *normal_sampler);
+            },
+            descriptor_set_images_.cbegin(),
+            descriptor_set_images_.cend(),
+            descriptor_sets_.cbegin()
+        );
+    }
+
+    void vulkan_sample::write_cull_descriptor_set()
+    {
+        const auto& descriptor_set = *cull_descriptor_sets_.front();
+        const auto& write_storage_buffer = [&descriptor_set](const uint32_t binding, const buffer_object& buffer)
+        {
+            return info_proxy<WriteDescriptorSet>{
+                {},
+                {{*buffer, 0, whole_size<decltype(DescriptorBufferInfo::range)>}},
+                {},
+                {descriptor_set, binding, 0, 1, DescriptorType::eStorageBuffer}
+            };
+        };
+
+        device_->updateDescriptorSets(
+            {
+                info_proxy<WriteDescriptorSet>{
+                    {},
+                    {{*transform_buffer_, 0, whole_size<decltype(DescriptorBufferInfo::range)>}},
+                    {},
+                    {descriptor_set, 0, 0, 1, DescriptorType::eUniformBuffer}
+                },
+                write_storage_buffer(1, cull_memory_.device_local_buffer(meshlets_buffer_index)),
+                write_storage_buffer(2, cull_memory_.device_local_buffer(draw_transforms_buffer_index)),
+                write_storage_buffer(3, cull_memory_.device_local_buffer(draw_commands_buffer_index)),
+                write_storage_buffer(4, transfer_memory_.device_local_buffer(indices_buffer_index)),
+                write_storage_buffer(5, cull_memory_.device_local_buffer(culled_indices_buffer_index))
+            },
+            {},
+            device_.dispatch()
+        );
+    }
+
+    void vulkan_sample::write_cull_command(const CommandBuffer& command_buffer) const
+    {
+        const auto& dispatch = device_.dispatch();
+        const auto& barrier = [this](
+            const size_t buffer_index,
+            const AccessFlags src_access,
+            const AccessFlags dst_access
+        )
+        {
+            return BufferMemoryBarrier{
+                src_access,
+                dst_access,
+                queue_family_ignore<>,
+                queue_family_ignore<>,
+                *cull_memory_.device_local_buffer(buffer_index),
+                0,
+                whole_size<DeviceSize>
+            };
+        };
+
+        //the previous frame has to be done reading the commands and the culled indices before they are rewritten
+        command_buffer.pipelineBarrier(
+            PipelineStageFlagBits::eDrawIndirect | PipelineStageFlagBits::eVertexInput,
+            PipelineStageFlagBits::eTransfer | PipelineStageFlagBits::eComputeShader,
+            {},
+            {},
+            {},
+            {},
+            dispatch
+        );
+
+        const auto& host_commands = cull_memory_.host_buffer(draw_commands_buffer_index);
+        command_buffer.copyBuffer(
+            *host_commands,
+            *cull_memory_.device_local_buffer(draw_commands_buffer_index),
+            {{0, 0, host_commands.info().info.size}},
+            dispatch
+        );
+        command_buffer.pipelineBarrier(
+            PipelineStageFlagBits::eTransfer,
+            PipelineStageFlagBits::eComputeShader,
+            {},
+            {},
+            {
+                barrier(
+                    draw_commands_buffer_index,
+                    AccessFlagBits::eTransferWrite,
+                    AccessFlagBits::eShaderRead | AccessFlagBits::eShaderWrite
+                )
+            },
+            {},
+            dispatch
+        );
+
+        //one work group per draw, group counts are limited per dimension, the draws past the limit go on the next row
+        const auto draw_count = static_cast<uint32_t>(meshes_.size());
+        const auto max_group_count =
+            physical_device_->getProperties(instance_.dispatch()).limits.maxComputeWorkGroupCount[0];
+        command_buffer.bindPipeline(PipelineBindPoint::eCompute, *cull_pipeline_, dispatch);
+        command_buffer.bindDescriptorSets(
+            PipelineBindPoint::eCompute,
+            *cull_pipeline_layout_,
+            0,
+            *cull_descriptor_sets_.front(),
+            {},
+            dispatch
+        );
+        if(draw_count > 0)
+            command_buffer.dispatch(
+                std::min(draw_count, max_group_count),
+                (draw_count + max_group_count - 1) / max_group_count,
+                1,
+                dispatch
+            );
+
+        command_buffer.pipelineBarrier(
+            PipelineStageFlagBits::eComputeShader,
+            PipelineStageFlagBits::eDrawIndirect | PipelineStageFlagBits::eVertexInput,
+            {},
+            {},
+            {
+                barrier(
+                    draw_commands_buffer_index,
+                    AccessFlagBits::eShaderWrite,
+                    AccessFlagBits::eIndirectCommandRead
+                ),
+                barrier(culled_indices_buffer_index, AccessFlagBits::eShaderWrite, AccessFlagBits::eIndexRead)
+            },
+            {},
+            dispatch
+        );
+    }
+
+    void vulkan_sample::write_skin_descriptor_set()
+    {
+        if(skinned_primitives_.empty()) return;
+
+        const auto& descriptor_set = *skin_descriptor_sets_.front();
+        const auto& write_storage_buffer = [&descriptor_set](const uint32_t binding, const buffer_object& buffer)
+        {
+            return info_proxy<WriteDescriptorSet>{
+                {},
+                {{*buffer, 0, whole_size<decltype(DescriptorBufferInfo::range)>}},
+                {},
+                {descriptor_set, binding, 0, 1, DescriptorType::eStorageBuffer}
+            };
+        };
+
+        device_->updateDescriptorSets(
+            {
+                write_storage_buffer(0, skin_memory_.device_local_buffer(skin_vertices_buffer_index)),
+                write_storage_buffer(1, skin_memory_.device_local_buffer(joint_matrices_buffer_index)),
+                write_storage_buffer(2, skin_memory_.device_local_buffer(skinned_draws_buffer_index)),
+                write_storage_buffer(3, transfer_memory_.device_local_buffer(vertices_buffer_index)),
+                write_storage_buffer(4, cull_memory_.device_local_buffer(draw_transforms_buffer_index))
+            },
+            {},
+            device_.dispatch()
+        );
+    }
+
+    void vulkan_sample::write_skin_command(const CommandBuffer& command_buffer) const
+    {
+        if(skinned_primitives_.empty()) return;
+
+        const auto& dispatch = device_.dispatch();
+        const auto& barrier = [](
+            const buffer_object& buffer,
+            const AccessFlags src_access,
+            const AccessFlags dst_access
+        )
+        {
+            return BufferMemoryBarrier{
+                src_access,
+                dst_access,
+                queue_family_ignore<>,
+                queue_family_ignore<>,
+                *buffer,
+                0,
+                whole_size<DeviceSize>
+            };
+        };
+
+        //the previous frame has to be done reading the vertices and the transforms before they are rewritten
+        command_buffer.pipelineBarrier(
+            PipelineStageFlagBits::eVertexInput | PipelineStageFlagBits::eVertexShader |
+            PipelineStageFlagBits::eComputeShader,
+            PipelineStageFlagBits::eTransfer | PipelineStageFlagBits::eComputeShader,
+            {},
+            {},
+            {},
+            {},
+            dispatch
+        );
+
+        for(const auto index : {joint_matrices_buffer_index, skinned_draws_buffer_index})
+        {
+            const auto& host_buffer = skin_memory_.host_buffer(index);
+            command_buffer.copyBuffer(
+                *host_buffer,
+                *skin_memory_.device_local_buffer(index),
+                {{0, 0, host_buffer.info().info.size}},
+                dispatch
+            );
         }
+        command_buffer.pipelineBarrier(
+            PipelineStageFlagBits::eTransfer,
+            PipelineStageFlagBits::eComputeShader,
+            {},
+            {},
+            {
+                barrier(
+                    skin_memory_.device_local_buffer(joint_matrices_buffer_index),
+                    AccessFlagBits::eTransferWrite,
+                    AccessFlagBits::eShaderRead
+                ),
+                barrier(
+                    skin_memory_.device_local_buffer(skinned_draws_buffer_index),
+                    AccessFlagBits::eTransferWrite,
+                    AccessFlagBits::eShaderRead
+                )
+            },
+            {},
+            dispatch
+        );
+
+        //64 vertices per work group, the groups past the limit continue on the next row
+        const auto group_count = static_cast<uint32_t>((skin_memory_.read<skin_vertex>().size() + 63) / 64);
+        const auto max_group_count =
+            physical_device_->getProperties(instance_.dispatch()).limits.maxComputeWorkGroupCount[0];
+        command_buffer.bindPipeline(PipelineBindPoint::eCompute, *skin_pipeline_, dispatch);
+        command_buffer.bindDescriptorSets(
+            PipelineBindPoint::eCompute,
+            *skin_pipeline_layout_,
+            0,
+            *skin_descriptor_sets_.front(),
+            {},
+            dispatch
+        );
+        command_buffer.dispatch(
+            std::min(group_count, max_group_count),
+            (group_count + max_group_count - 1) / max_group_count,
+            1,
+            dispatch
+        );
 
+        //the draws read the skinned vertices, the cull pass and the vertex shader the published transforms
+        command_buffer.pipelineBarrier(
+            PipelineStageFlagBits::eComputeShader,
+            PipelineStageFlagBits::eVertexInput | PipelineStageFlagBits::eVertexShader |
+            PipelineStageFlagBits::eComputeShader,
+            {},
+            {},
+            {
+                barrier(
+                    transfer_memory_.device_local_buffer(vertices_buffer_index),
+                    AccessFlagBits::eShaderWrite,
+                    AccessFlagBits::eVertexAttributeRead
+                ),
+                barrier(
+                    cull_memory_.device_local_buffer(draw_transforms_buffer_index),
+                    AccessFlagBits::eShaderWrite,
+                    AccessFlagBits::eShaderRead
+                )
+            },
+            {},
+            dispatch
+        );
+    }
 
+    void vulkan_sample::record_graphics_command_buffers()
+    {
         ::utility::for_each(
             [this, index = uint32_t{0}](
             decltype(graphics_command_buffers_)::const_reference& buffer,
@@ -1007,6 +2888,8 @@ namespace vulkan
                 };
 
                 buffer->begin(command_buffer_begin_info_, device_.dispatch());
+                write_skin_command(*buffer);
+                write_cull_command(*buffer);
                 buffer->beginRenderPass(render_pass_begin_info, SubpassContents::eInline, device_.dispatch());
 
                 buffer->bindPipeline(PipelineBindPoint::eGraphics, *graphics_pipeline_, device_.dispatch());
@@ -1019,25 +2902,62 @@ namespace vulkan
                 );
 
                 buffer->bindIndexBuffer(
-                    {*transfer_memory_.device_local_buffer(indices_buffer_index)},
+                    {*cull_memory_.device_local_buffer(culled_indices_buffer_index)},
                     {0},
                     index_type<std::decay_t<decltype(get_indices())>::value_type>,
                     device_.dispatch()
                 );
 
 
-                for(const auto& mesh : meshes_)
+                const descriptor_set_object* bound_descriptor_set = nullptr;
+                for(size_t i = 0; i < meshes_.size(); ++i)
                 {
-                    buffer->bindDescriptorSets(
-                        PipelineBindPoint::eGraphics,
+                    const auto& mesh = meshes_[i];
+
+                    //a mesh whose array image has no level uploaded yet only has its base color,
+                    //one whose normal texture has none yet is drawn with its vertex normals
+                    const auto is_pending = is_texture_pending(mesh.texture);
+                    const auto is_normal_pending = is_texture_pending(mesh.normal_texture);
+                    const auto* descriptor_set = mesh.descriptor_set;
+                    auto texture_constant = mesh.texture_constant;
+                    if(is_pending)
+                    {
+                        descriptor_set = &image_descriptor_set(nullptr, nullptr);
+                        texture_constant = {mesh.texture_constant.base_color_factor, no_texture_layer};
+                    }
+                    else if(is_normal_pending)
+                    {
+                        descriptor_set = &image_descriptor_set(mesh.texture, nullptr);
+                        texture_constant.normal_layer = no_texture_layer;
+                    }
+                    if(descriptor_set != bound_descriptor_set)
+                    {
+                        buffer->bindDescriptorSets(
+                            PipelineBindPoint::eGraphics,
+                            *pipeline_layout_,
+                            0,
+                            **descriptor_set,
+                            {},
+                            device_.dispatch()
+                        );
+                        bound_descriptor_set = descriptor_set;
+                    }
+
+                    buffer->pushConstants(
                         *pipeline_layout_,
+                        ShaderStageFlagBits::eFragment,
                         0,
-                        **mesh.descriptor_set,
-                        {},
+                        sizeof(texture_constant),
+                        &texture_constant,
+                        device_.dispatch()
+                    );
+                    buffer->drawIndexedIndirect(
+                        *cull_memory_.device_local_buffer(draw_commands_buffer_index),
+                        i * sizeof(DrawIndexedIndirectCommand),
+                        1,
+                        sizeof(DrawIndexedIndirectCommand),
                         device_.dispatch()
                     );
-
-                    buffer->drawIndexed(mesh.index_count, 1, mesh.first_index, 0, 0, device_.dispatch());
                 }
 
 
@@ -1068,6 +2988,21 @@ namespace vulkan
         );
     }
 
+    void vulkan_sample::generate_render_info()
+    {
+        render_pass_begin_infos_.resize(frame_buffers_.size());
+        submit_infos_.resize(graphics_command_buffers_.size());
+        present_infos_.resize(submit_infos_.size());
+        submit_precondition_command();
+
+        command_buffer_begin_info_ = CommandBufferBeginInfo{CommandBufferUsageFlagBits::eSimultaneousUse};
+
+        graphics_queue_.waitIdle(device_.dispatch());
+
+        write_descriptor_sets();
+        record_graphics_command_buffers();
+    }
+
     void vulkan_sample::initialize_vulkan()
     {
         static bool is_initialized = false;
@@ -1086,7 +3021,12 @@ namespace vulkan
             initialize_buffer();
             initialize_texture_sampler();
             initialize_transform_buffer();
+            initialize_cull_pipeline();
+            write_cull_descriptor_set();
+            initialize_skin_pipeline();
+            write_skin_descriptor_set();
             initialize_graphics_command_pool();
+            initialize_transfer_command_buffer();
             is_initialized = true;
         }
         else
@@ -1162,10 +3102,45 @@ namespace vulkan
 
     void vulkan_sample::initialize()
     {
+        if constexpr(is_debug && use_animation_benchmark)
+        {
+            const auto& [tracks_time, reference_time] = animation_tracks::benchmark(animation_benchmark_nodes, 600);
+            std::cout << "animation benchmark: " << animation_benchmark_nodes << " nodes sampled in " << tracks_time <<
+                "ms, per track search with slerp in " << reference_time << "ms\n";
+        }
+        if constexpr(is_debug) benchmark_test_model_animation();
+
         initialize_window();
         initialize_vulkan();
     }
 
+    void vulkan_sample::benchmark_test_model_animation()
+    {
+        using namespace ::utility::time;
+
+        static constexpr size_t frame_count = 600;
+
+        gltf_model model{skinned_test_model_path};
+        const auto rest_joint_matrices = model.get_joint_matrices().first;
+
+        //the same host work a frame of an animated scene does before the skin pass
+        size_t updated_draw_count = 0;
+        auto is_moved = false;
+        const auto& start = steady_clock_timer();
+        for(size_t i = 0; i < frame_count; ++i)
+        {
+            model.animate(static_cast<float>(i) / 60);
+            for(const auto& range : model.update_draws()) updated_draw_count += range.second.size();
+            is_moved = model.get_joint_matrices().first != rest_joint_matrices || is_moved;
+        }
+        const auto frame_time =
+            duration<float, std::milli>{steady_clock_timer() - start}.count() / static_cast<float>(frame_count);
+
+        std::cout << "animated " << skinned_test_model_path.generic_u8string() << " for " << frame_count <<
+            " frames in " << frame_time << "ms each, " << updated_draw_count << " draws updated, joints " <<
+            (is_moved ? "moved" : "did not move") << '\n';
+    }
+
     bool vulkan_sample::render()
     {
         static constexpr empty_type empty_type;
@@ -1184,15 +3159,107 @@ namespace vulkan
     void vulkan_sample::flush_to_memory()
     {
         transfer_memory_.flush<vertex, uint32_t>();
+        cull_memory_.flush<meshlet, draw_transform, DrawIndexedIndirectCommand>();
+        if(!skinned_primitives_.empty()) skin_memory_.flush<skin_vertex, mat4, skinned_draw>();
         flush_transform_to_memory();
     }
 
+    void vulkan_sample::stream_textures(const glm_camera& camera)
+    {
+        const auto viewport_height = static_cast<float>(swapchain_.info().info.imageExtent.height);
+
+        //an array image is demanded at the finest level any mesh sampling one of its layers needs on screen
+        map<string, uint32_t> demanded_levels;
+        for(const auto& mesh : meshes_)
+        {
+            const auto& demand = [&](const texture_image<Format::eR8G8B8A8Unorm>* const texture, const string& name)
+            {
+                //the image of a pending tail is still being written, so it is not replaced before it arrives
+                if(!texture || is_texture_pending(texture)) return;
+
+                const auto& source = texture_sources_.at(name);
+                const auto& extent = source.extent;
+                const auto level = demanded_mip_level(
+                    std::max(
+                        mesh.texture_coordinate_span.x * extent.width,
+                        mesh.texture_coordinate_span.y * extent.height
+                    ),
+                    camera.projected_diameter(mesh.bounds.center, mesh.bounds.radius, viewport_height),
+                    mip_levels(extent)
+                );
+                const auto& it = demanded_levels.try_emplace(source.array_name, level).first;
+                it->second = std::min(it->second, level);
+            };
+            demand(mesh.texture, mesh.texture_name);
+            demand(mesh.normal_texture, mesh.normal_texture_name);
+        }
+
+        for(const auto& [name, level] : demanded_levels) texture_residency_.demand(name, level, frame_count_);
+
+        for(const auto& [array_name, level] : texture_residency_.plan())
+        {
+            const auto& layers = texture_arrays_.at(array_name);
+            auto& [texture_image, futures] = texture_streaming_loads_[array_name];
+            texture_image = generate_texture_image(
+                texture_sources_.at(layers.front()).extent,
+                static_cast<uint32_t>(layers.size()),
+                level
+            );
+            texture_image.initialize(device_, *physical_device_);
+            for(const auto& name : layers)
+            {
+                auto& source = texture_sources_.at(name);
+                futures.emplace_back(
+                    &source,
+                    thread_pool_.submit(
+                        [this, &texture_image = texture_image, &source, level = level]
+                        {
+                            return write_texture_levels(texture_image, source, level);
+                        }
+                    )
+                );
+            }
+        }
+    }
+
     void vulkan_sample::set_transform(decltype(transform_mat_) mat)
     {
         transform_mat_ = std::move(mat);
+
+        //the camera is the point the matrix maps onto the plane at infinity
+        transform_mat_.camera = inverse(transform_mat_.mat) * vec4{0, 0, 1, 0};
+        if(transform_mat_.camera.w != 0) transform_mat_.camera /= transform_mat_.camera.w;
         write(transform_buffer_memory_, device_, transform_mat_);
     }
 
+    void vulkan_sample::set_node_transform(
+        const size_t node,
+        const vec3& translation,
+        const quat& rotation,
+        const vec3& scale
+    )
+    {
+        if(!scene_) throw std::runtime_error{"only gltf scenes have nodes to move"};
+        scene_->set_node_transform(node, translation, rotation, scale);
+    }
+
+    optional<size_t> vulkan_sample::pick_node(const vec2& position) const
+    {
+        if(!scene_ || transform_mat_.camera.w == 0) return nullopt;
+
+        //the ray leaves the camera through the point on the far plane under the position
+        auto target = inverse(transform_mat_.mat) * vec4{position, 1, 1};
+        target /= target.w;
+        const vec3 origin{transform_mat_.camera};
+        return scene_->pick_node(origin, vec3{target} - origin);
+    }
+
+    vector<size_t> vulkan_sample::nodes_near_camera(const float radius) const
+    {
+        if(!scene_ || transform_mat_.camera.w == 0) return {};
+        return scene_->nodes_near(vec3{transform_mat_.camera}, radius);
+    }
+
     void vulkan_sample::set_vertices(decltype(transfer_memory_)::value_type<vertex> vertices)
     {
         transfer_memory_.write<vertex>(std::move(vertices));
@@ -1,9 +1,10 @@
 ﻿#pragma once
 
 #include "vulkan/utility/utility.h"
+#include "vulkan/utility/gltf/gltf.h"
 #include "utility/constant/numberic.h"
-#include <unordered_map>
-#include <glm/gtx/hash.hpp>
+
+class glm_camera;
 
 namespace vulkan
 {
@@ -17,20 +18,134 @@ namespace vulkan
 
     using ::time;
     using stb::channel;
-    using std::unordered_map;
 
     class vulkan_sample
     {
+        //the compact layout quantizes positions per mesh and drops the constant vertex color
+        static constexpr auto use_compact_vertex = true;
+        //picks a cpu device such as lavapipe instead of a discrete gpu, so the virtual texture path can be
+        //checked on machines without one
+        static constexpr auto use_software_rasterizer = false;
+        //debug builds time the animation tracks against a plain per track sampler on synthetic nodes at startup
+        static constexpr auto use_animation_benchmark = false;
+        static constexpr size_t animation_benchmark_nodes = 10000;
+        //renders the small animated and skinned test model instead of the scene, so the skin pass has work,
+        //debug builds animate it on the host at startup either way
+        static constexpr auto use_skinned_test_model = false;
+
+        using vertex = std::conditional_t<use_compact_vertex, compact_vertex, utility::vertex>;
+        using model_cache = mesh_cache<vertex>;
+
+        static constexpr uint32_t no_texture_layer = numberic_max<uint32_t>;
+
+        //pushed to the fragment shader per mesh, virtual textures have a non-zero level count
+        //and meshes without a texture only have the base color factor, the normal texture is a layer
+        //of the array image bound next to that of the base color or a virtual texture of its own
+        struct texture_push_constant
+        {
+            vec4 base_color_factor{1};
+            uint32_t layer = 0;
+            virtual_texture_cache::texture_info virtual_texture{};
+            uint32_t normal_layer = no_texture_layer;
+            virtual_texture_cache::texture_info normal_virtual_texture{};
+        };
+
         struct mesh
         {
             uint32_t first_index;
             uint32_t index_count;
             const texture_image<Format::eR8G8B8A8Unorm>* texture = nullptr;
+            const texture_image<Format::eR8G8B8A8Unorm>* normal_texture = nullptr;
             const  descriptor_set_object* descriptor_set = nullptr;
+            string texture_name;
+            string normal_texture_name;
+            texture_push_constant texture_constant;
+            bounding_sphere bounds;
+            vec2 texture_coordinate_span{};
+            mat4 world_matrix{1};
+            //position of the world matrix among the draw transforms, the order the meshes had before sorting
+            uint32_t transform_index = 0;
+        };
+
+        //read by the cull pass and the vertex shader, the world matrix maps the vertex buffer positions of a draw
+        struct draw_transform
+        {
+            mat4 world;
+            mat4 inverse_world;
         };
 
+        //the rest pose of a vertex of a skinned primitive, read by the skin pass, joints index the joint matrices
+        //of its skin and weights are unorm, the target vertex is its position in the vertex buffer
+        struct skin_vertex
+        {
+            vec3 position;
+            uint32_t skinned_draw;
+            vec3 normal;
+            uint32_t target_vertex;
+            u16vec4 joints;
+            u16vec4 weights;
+            vec4 tangent;
+        };
+
+        //the transform the skin pass publishes for a skinned draw, its world matrix maps the box the skinned
+        //positions are quantized in for the frame
+        struct skinned_draw
+        {
+            draw_transform transform;
+            uint32_t transform_index;
+            //of the joint matrices of the skin among those of every skin
+            uint32_t first_joint;
+            array<uint32_t, 2> padding{};
+        };
+
+        //skinned primitives of the scene, their transform index is their position among the draws
+        struct skinned_primitive
+        {
+            const gltf_model::primitive* primitive;
+            int skin;
+            uint32_t transform_index;
+        };
+
+        //what the meshes of a material id sample, shared by obj models and gltf scenes
+        struct material_binding
+        {
+            string texture_name;
+            vec4 base_color_factor{1};
+            //only gltf scenes have the tangents a normal texture needs
+            string normal_texture_name;
+        };
+
+        struct texture_source
+        {
+            path source_path;
+            uint64_t key;
+            Extent3D extent;
+            optional<texture_cache<Format::eR8G8B8A8Unorm>::entry> cached;
+            string array_name;
+            uint32_t array_layer = 0;
+            texture_slot slot = texture_slot::base_color;
+            //only layers sampled the same way share an array image, whose descriptor uses this state
+            sampler_object::info_type sampler_info;
+            //paged through the virtual texture cache under array_name instead of living in an array image
+            bool is_virtual = false;
+        };
+
+        //a load of the levels of a source running on the thread pool, it yields the cache entry a cold start
+        //stored them in, which the source only takes over once the main thread collects the load
+        using texture_load = pair<texture_source*, future<decltype(texture_source::cached)>>;
+
+        static constexpr uint32_t resident_tail_size = 64;
+        //textures up to this size share array images with the textures of the same extent
+        static constexpr uint32_t texture_array_max_size = 512;
+        //time a frame may spend recording texture uploads, at least one ready image is always uploaded
+        static constexpr time::milliseconds frame_upload_budget{4};
+
         void initialize_window() noexcept;
 
+        //samples the animations of the skinned test model, updates its nodes and reads its joint matrices
+        //for a number of frames, then reports the time per frame and whether the joints moved
+        static void benchmark_test_model_animation();
+
         void generate_debug_messenger_create_info();
         void generate_instance_create_info();
 
@@ -50,22 +165,78 @@ namespace vulkan
         void initialize_queue();
 
         void generate_model();
+        void load_obj_model();
+        void load_scene();
 
         void generate_shader_module_create_infos();
         void generate_descriptor_set_layout_create_info();
-        [[nodiscard]] map<string, stb::image<channel::rgb_alpha>> generate_texture_image_create_info();
+        void generate_texture_image_create_info();
+        [[nodiscard]] static texture_image<Format::eR8G8B8A8Unorm> generate_texture_image(
+            const Extent3D,
+            const uint32_t,
+            const uint32_t
+        );
+        //compact vertices are quantized in the given box, full ones carry a white color instead of the normal
+        //and the tangent
+        template<typename Vertex = vertex>
+        [[nodiscard]] static Vertex make_vertex(
+            const vec3,
+            const vec3,
+            const vec2,
+            const vec4,
+            const pair<vec3, vec3>&
+        ) noexcept;
+        //maps the positions of vertices made in the given box back into it
+        template<typename Vertex = vertex>
+        [[nodiscard]] static mat4 vertex_matrix(const pair<vec3, vec3>&) noexcept;
+        //the position a vertex shader reads before the world matrix is applied
+        template<typename Vertex = vertex>
+        [[nodiscard]] static vec3 vertex_position(const Vertex&) noexcept;
+        //box around the bounding sphere, the cached mesh table keeps no other bounds to quantize in
+        [[nodiscard]] static pair<vec3, vec3> quantization_bounds(const bounding_sphere&) noexcept;
+        //degenerate world matrices get a zero inverse
+        [[nodiscard]] static draw_transform make_draw_transform(const mat4&) noexcept;
+        //skinned draws ignore the transform of their node, the skin pass writes their vertices and their transform
+        [[nodiscard]] static bool is_skinned(const gltf_model::draw&) noexcept;
+        //welds the parsed model into a mesh table with its vertex and index buffers
+        [[nodiscard]] tuple<vector<model_cache::mesh>, vector<vertex>, vector<uint32_t>> weld_model();
+        //lays out every primitive of the scene in one vertex and index buffer, with the world matrix of its node,
+        //along with the vertex and index counts of the buffers, a warm start only computes the world matrices
+        [[nodiscard]] tuple<vector<model_cache::mesh>, vector<mat4>, pair<size_t, size_t>>
+            generate_scene_layout() const;
+        //fills the mapped host memory straight from the primitives, in the order of the layout,
+        //a cold start reads them back from the host cached memory into its cache entry
+        void write_scene_buffers();
         [[nodiscard]] pair<vector<vertex>, vector<uint32_t>> generate_buffer_allocate_info();
-        void generate_texture_sampler_create_info();
+        //splits the meshes into meshlets, in the order they are drawn in
+        [[nodiscard]] vector<meshlet> generate_cull_buffer_allocate_info(
+            const vector<vertex>&,
+            const vector<uint32_t>&
+        );
+        void generate_cull_pipeline_create_info();
+        void generate_skin_pipeline_create_info();
+        [[nodiscard]] sampler_object::info_type generate_texture_sampler_create_info() const;
         void generate_transform_buffer_create_info();
         void generate_graphics_command_pool_create_info();
 
         void initialize_shader_module();
         void initialize_descriptor_set_layout();
         void initialize_texture_image();
+        [[nodiscard]] decltype(texture_source::cached) write_texture_levels(
+            const texture_image<Format::eR8G8B8A8Unorm>&,
+            const texture_source&,
+            const uint32_t
+        );
+        static void collect_texture_loads(vector<texture_load>&);
         void initialize_buffer();
+        void initialize_cull_buffer(const vector<vertex>&, const vector<uint32_t>&);
+        void initialize_skin_buffer();
         void initialize_texture_sampler();
         void initialize_transform_buffer();
+        void initialize_cull_pipeline();
+        void initialize_skin_pipeline();
         void initialize_graphics_command_pool();
+        void initialize_transfer_command_buffer();
 
         void generate_pipeline_layout_create_info(const descriptor_set_layout_object&);
         void generate_swapchain_create_info(const surface_object&);
@@ -84,7 +255,9 @@ namespace vulkan
             const command_pool_object&
         );
         void generate_render_pass_create_info(const swapchain_object&, const depth_image&);
-        void generate_descriptor_pool_create_info(const vector<mesh>& meshes);
+        void generate_descriptor_pool_create_info(const size_t);
+        //the array images of the base color and the normal texture every descriptor set binds
+        void generate_descriptor_set_images();
         void generate_sync_objects_create_info(const vector<image_view_object>&);
 
         void initialize_graphics_command_buffer();
@@ -106,7 +279,7 @@ namespace vulkan
             const pipeline_layout_object&
         );
         void generate_descriptor_set_allocate_info(
-            const vector<mesh>&,
+            const size_t,
             const descriptor_set_layout_object&,
             const descriptor_pool_object&
         );
@@ -118,6 +291,31 @@ namespace vulkan
         void initialize_vulkan();
 
         void submit_precondition_command();
+        //uploads the resident tails of the array images decoded since the last frame
+        void submit_texture_tails(const time::steady_clock::time_point&);
+        void submit_streamed_textures(const time::steady_clock::time_point&);
+        //whether the resident tail of the array image is still decoding, its meshes are drawn with their base color
+        [[nodiscard]] bool is_texture_pending(const texture_image<Format::eR8G8B8A8Unorm>*) const noexcept;
+        //the descriptor set binding the array images of a base color and a normal texture, null for none
+        [[nodiscard]] const descriptor_set_object& image_descriptor_set(
+            const texture_image<Format::eR8G8B8A8Unorm>*,
+            const texture_image<Format::eR8G8B8A8Unorm>*
+        ) const;
+        void update_virtual_textures();
+        void animate_scene();
+        //uploads the world matrices of the scene nodes moved since the last frame, the device has to be idle
+        void submit_node_transforms();
+        //writes the joint matrices and the quantization boxes of the skinned draws the frame skins with
+        void update_skins();
+        //takes the instance away from the scene draws whose box is outside the frustum, the cull pass skips
+        //their meshlets, the device has to be idle
+        void cull_draws();
+        void write_descriptor_sets();
+        void write_cull_descriptor_set();
+        void write_cull_command(const CommandBuffer&) const;
+        void write_skin_descriptor_set();
+        void write_skin_command(const CommandBuffer&) const;
+        void record_graphics_command_buffers();
         void generate_render_info();
         void re_initialize_vulkan();
         void glfw_cleanup() noexcept;
@@ -151,6 +349,27 @@ namespace vulkan
             std::vector<tinyobj::material_t> materials;
         }model_;
 
+        model_cache mesh_cache_{path{"cache"} / "meshes"};
+
+        uint64_t model_key_ = 0;
+
+        //set on a warm start, released once its buffers are copied to host memory
+        optional<model_cache::entry> model_cache_entry_;
+
+        //set on a cold start of a scene, committed once its buffers are written
+        optional<model_cache::writer> model_cache_writer_;
+
+        optional<gltf_model> scene_;
+        //animations of the scene play from the time it was loaded
+        time::steady_clock::time_point scene_start_;
+
+        vector<material_binding> materials_;
+
+        vector<path> texture_paths_;
+
+        //sampler state the scene asks for per texture name, the others use the default sampler
+        map<string, sampler_object::info_type> texture_sampler_infos_;
+
         vector<mesh> meshes_;
 
         Queue graphics_queue_;
@@ -166,10 +385,18 @@ namespace vulkan
 
         shader_module_object vertex_shader_module_;
         shader_module_object fragment_shader_module_;
+        shader_module_object cull_shader_module_;
+        shader_module_object skin_shader_module_;
 
         descriptor_set_layout_object descriptor_set_layout_;
         descriptor_pool_object descriptor_pool_;
         vector<descriptor_set_object> descriptor_sets_;
+        //sorted array images of the base color and the normal texture of each descriptor set, a null image is
+        //bound to the page cache, which virtual textured and pending meshes never sample as an array image
+        vector<pair<
+            const texture_image<Format::eR8G8B8A8Unorm>*,
+            const texture_image<Format::eR8G8B8A8Unorm>*
+        >> descriptor_set_images_;
 
         buffer_object transform_buffer_;
         device_memory_object transform_buffer_memory_;
@@ -178,6 +405,35 @@ namespace vulkan
         static constexpr size_t indices_buffer_index = 1;
         static_memory<true,vertex, uint32_t>::vector_values transfer_memory_{};
 
+        //meshlets are culled into a copy of the index buffer, which each draw reads through its indirect command
+        static constexpr size_t meshlets_buffer_index = 0;
+        static constexpr size_t draw_transforms_buffer_index = 1;
+        static constexpr size_t draw_commands_buffer_index = 2;
+        static constexpr size_t culled_indices_buffer_index = 3;
+        static_memory<false, meshlet, draw_transform, DrawIndexedIndirectCommand, uint32_t>::vector_values
+            cull_memory_{};
+
+        descriptor_set_layout_object cull_descriptor_set_layout_;
+        descriptor_pool_object cull_descriptor_pool_;
+        vector<descriptor_set_object> cull_descriptor_sets_;
+        pipeline_layout_object cull_pipeline_layout_;
+        compute_pipeline_object cull_pipeline_;
+
+        //skinned vertices are written over their rest pose in the vertex buffer every frame, so every draw reads
+        //them like any other vertex, left empty for scenes without skins
+        static constexpr size_t skin_vertices_buffer_index = 0;
+        static constexpr size_t joint_matrices_buffer_index = 1;
+        static constexpr size_t skinned_draws_buffer_index = 2;
+        static_memory<false, skin_vertex, mat4, skinned_draw>::vector_values skin_memory_{};
+
+        vector<skinned_primitive> skinned_primitives_;
+
+        descriptor_set_layout_object skin_descriptor_set_layout_;
+        descriptor_pool_object skin_descriptor_pool_;
+        vector<descriptor_set_object> skin_descriptor_sets_;
+        pipeline_layout_object skin_pipeline_layout_;
+        compute_pipeline_object skin_pipeline_;
+
         pipeline_layout_object pipeline_layout_;
 
         graphics_pipeline_object graphics_pipeline_;
@@ -186,9 +442,35 @@ namespace vulkan
 
         vector<command_buffer_object> graphics_command_buffers_;
 
+        vector<command_buffer_object> transfer_command_buffers_;
+
         map<string,texture_image<Format::eR8G8B8A8Unorm>> texture_image_map_;
 
-        sampler_object texture_sampler_;
+        texture_cache<Format::eR8G8B8A8Unorm> texture_cache_{path{"cache"} / "textures"};
+
+        map<string, texture_source> texture_sources_;
+
+        //texture names of each array image, in layer order
+        map<string, vector<string>> texture_arrays_;
+
+        texture_budget_policy texture_budget_policy_;
+
+        //the budget is derived from the device heaps once the physical device is known
+        mip_residency<string> texture_residency_{0};
+
+        //images with a different resident level, swapped in once uploaded
+        map<string, pair<decltype(texture_image_map_)::mapped_type, vector<texture_load>>> texture_streaming_loads_;
+
+        vector<pair<const decltype(texture_image_map_)::mapped_type*, vector<texture_load>>> texture_image_futures_;
+
+        virtual_texture_cache virtual_textures_{path{"cache"} / "pages"};
+
+        map<string, virtual_texture_cache::texture_info> virtual_texture_infos_;
+
+        //one sampler per distinct create info, shared by every array image sampled with it
+        interner<const sampler_object> sampler_interner_;
+
+        map<string, shared_ptr<const sampler_object>> array_samplers_;
 
         depth_image depth_image_;
 
@@ -201,12 +483,19 @@ namespace vulkan
         vector<semaphore_object> render_syn_;
         vector<fence_object> gpu_syn_;
 
-        struct transform { mat4 mat; } transform_mat_{};
+        //the camera is derived from the matrix when it is set, the cull pass tests meshlet cones against it
+        struct transform
+        {
+            mat4 mat;
+            vec4 camera{};
+        } transform_mat_{};
 
         unsigned long long frame_count_ = 0;
 
         unsigned fps_ = 0;
 
+        thread_pool thread_pool_;
+
     public:
         ~vulkan_sample();
 
@@ -226,6 +515,18 @@ namespace vulkan
         void flush_transform_to_memory();
         void flush_to_memory();
 
+        void stream_textures(const glm_camera&);
+
+        //moves a node of a gltf scene, its subtree is updated and uploaded before the next frame
+        void set_node_transform(const size_t, const vec3&, const quat&, const vec3&);
+
+        //the gltf node whose draw box the view ray through the position in normalized device coordinates
+        //enters first
+        [[nodiscard]] optional<size_t> pick_node(const vec2&) const;
+
+        //the gltf nodes whose draw box the sphere around the camera overlaps
+        [[nodiscard]] vector<size_t> nodes_near_camera(const float) const;
+
         void set_transform(decltype(transform_mat_));
         [[nodiscard]] constexpr const decltype(transform_mat_)& get_transform() const;
 
@@ -240,6 +541,9 @@ namespace vulkan
         static constexpr uint32_t width = 1280;
         static constexpr uint32_t height = 960;
         static const string window_title;
+        static const path skinned_test_model_path;
+        //gltf and glb scenes are rendered with their node transforms, anything else is loaded as an obj model
+        static const path model_path;
 
         const property<vulkan_sample, decltype(transform_mat_)> transform_property{
             *this,
@@ -2,6 +2,34 @@
 
 namespace vulkan
 {
+	template<typename Vertex>
+	Vertex vulkan_sample::make_vertex(
+		const vec3 position,
+		[[maybe_unused]] const vec3 normal,
+		const vec2 texture_coordinate,
+		[[maybe_unused]] const vec4 tangent,
+		[[maybe_unused]] const pair<vec3, vec3>& bounds
+	) noexcept
+	{
+		if constexpr(std::is_same_v<Vertex, compact_vertex>)
+			return {position, normal, texture_coordinate, tangent, bounds};
+		else return {position, vec3{1}, texture_coordinate};
+	}
+
+	template<typename Vertex>
+	mat4 vulkan_sample::vertex_matrix([[maybe_unused]] const pair<vec3, vec3>& bounds) noexcept
+	{
+		if constexpr(std::is_same_v<Vertex, compact_vertex>) return Vertex::dequantize_matrix(bounds);
+		else return mat4{1};
+	}
+
+	template<typename Vertex>
+	vec3 vulkan_sample::vertex_position(const Vertex& vertex) noexcept
+	{
+		if constexpr(std::is_same_v<Vertex, compact_vertex>) return vec3{unpackUnorm<float>(vertex.pos)};
+		else return vertex.pos;
+	}
+
 	template<typename T>
 	bool vulkan_sample::render([[maybe_unused]] const T& t)
 	{
@@ -20,6 +48,15 @@ namespace vulkan
 
 		device_->waitIdle(device_.dispatch());
 
+		const auto& upload_deadline = time::steady_clock_timer() + frame_upload_budget;
+		submit_texture_tails(upload_deadline);
+		submit_streamed_textures(upload_deadline);
+		update_virtual_textures();
+		animate_scene();
+		submit_node_transforms();
+		update_skins();
+		cull_draws();
+
 		if(glfwWindowShouldClose(window_))
 			return false;
 		glfwPollEvents();